@@ -10,7 +10,11 @@
 #ifndef FIMS_COMMON_DATA_OBJECT_HPP
 #define FIMS_COMMON_DATA_OBJECT_HPP
 
+#include <algorithm>
 #include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "model_object.hpp"
@@ -20,25 +24,39 @@ namespace fims_data_object {
 
 /**
  * Container to hold user supplied data.
+ *
+ * Observed data are constants, so the values are always stored as double and
+ * the storage is held through a shared pointer. The data objects created for
+ * the double and the AD versions of the model reference the same storage, see
+ * the converting constructor, and values are promoted to Type only when they
+ * are read.
  */
 template <typename Type>
 struct DataObject : public fims_model_object::FIMSObject<Type> {
-  static uint32_t id_g;                    /**< id of the Data Object >*/
-  fims::Vector<Type> data;                 /**< vector of the data >*/
-  fims::Vector<Type> uncertainty;          /**< vector of the data >*/
+  static uint32_t id_g; /**< id of the Data Object >*/
+  std::shared_ptr<fims::Vector<double>> data; /**< vector of the data >*/
+  std::shared_ptr<fims::Vector<double>>
+      uncertainty;                         /**< vector of the uncertainty >*/
   size_t dimensions;                       /**< dimension of the Data object >*/
   size_t imax;                             /**< 1st dimension of data object >*/
   size_t jmax;                             /**< 2nd dimension of data object>*/
   size_t kmax;                             /**< 3rd dimension of data object>*/
   size_t lmax;                             /**< 4th dimension of data object>*/
   Type na_value = static_cast<Type>(-999); /**< specifying the NA value >*/
+  Type* tape_values = nullptr; /**< observations supplied as a tape input,
+                                  read in place, see set_tape_values() >*/
+  const Type* weights = nullptr; /**< per-observation likelihood weights,
+                                    read in place, where null means a
+                                    weight of one, see set_weights() >*/
+  bool retrospective_peel = true; /**< if false, the observations are kept
+                                     in every retrospective peel, e.g.,
+                                     landings >*/
 
   /**
    * Constructs a one-dimensional data object.
    */
   DataObject(size_t imax) : dimensions(1), imax(imax) {
-    data.resize(imax);
-    uncertainty.resize(imax);
+    this->allocate(imax);
     this->id = DataObject<Type>::id_g++;
     this->register_self(this->id);
   }
@@ -47,8 +65,7 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * Constructs a two-dimensional data object.
    */
   DataObject(size_t imax, size_t jmax) : dimensions(2), imax(imax), jmax(jmax) {
-    data.resize(imax * jmax);
-    uncertainty.resize(imax * jmax);
+    this->allocate(imax * jmax);
     this->id = DataObject<Type>::id_g++;
     this->register_self(this->id);
   }
@@ -58,8 +75,7 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    */
   DataObject(size_t imax, size_t jmax, size_t kmax)
       : dimensions(3), imax(imax), jmax(jmax), kmax(kmax) {
-    data.resize(imax * jmax * kmax);
-    uncertainty.resize(imax * jmax * kmax);
+    this->allocate(imax * jmax * kmax);
     this->id = DataObject<Type>::id_g++;
     this->register_self(this->id);
   }
@@ -69,8 +85,38 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    */
   DataObject(size_t imax, size_t jmax, size_t kmax, size_t lmax)
       : dimensions(4), imax(imax), jmax(jmax), kmax(kmax), lmax(lmax) {
-    data.resize(imax * jmax * kmax * lmax);
-    uncertainty.resize(imax * jmax * kmax * lmax);
+    this->allocate(imax * jmax * kmax * lmax);
+    this->id = DataObject<Type>::id_g++;
+    this->register_self(this->id);
+  }
+
+  /**
+   * @brief Heap bytes owned by the data object. The data and uncertainty
+   * storage is shared with the data object of the other type, so it is
+   * divided between them.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::SharedHeapBytes(data) + fims::SharedHeapBytes(uncertainty);
+  }
+
+  /**
+   * Constructs a data object that shares the data and uncertainty storage of
+   * a data object of another type, e.g., the AD data object shares the
+   * storage of the double data object, so observations are held in memory
+   * only once.
+   * @param other The data object that owns the storage.
+   */
+  template <typename T>
+  explicit DataObject(const DataObject<T>& other)
+      : data(other.data),
+        uncertainty(other.uncertainty),
+        dimensions(other.dimensions),
+        imax(other.imax),
+        jmax(other.jmax),
+        kmax(other.kmax),
+        lmax(other.lmax),
+        retrospective_peel(other.retrospective_peel) {
     this->id = DataObject<Type>::id_g++;
     this->register_self(this->id);
   }
@@ -80,19 +126,18 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param i dimension of 1d data set
    * @return the value of the vector at position i
    */
-  inline Type operator()(size_t i) { return data[i]; }
+  inline Type operator()(size_t i) const {
+    return this->value(i);
+  }
 
   /**
    * Retrieve element from 1d data set.
    * Throws an exception if index is out of bounds.
    * @param i dimension of 1d data set
-   * @return the reference to the value of the vector at position i
+   * @return the value of the vector at position i
    */
-  inline Type& at(size_t i) {
-    if (i >= this->data.size()) {
-      throw std::overflow_error("DataObject error:i index out of bounds");
-    }
-    return data[i];
+  inline Type at(size_t i) const {
+    return this->value(this->checked_index(i));
   }
 
   /**
@@ -101,8 +146,8 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param j 2nd dimension of 2d data set
    * @return the value of the matrix at position i, j
    */
-  inline const Type operator()(size_t i, size_t j) {
-    return data[i * jmax + j];
+  inline const Type operator()(size_t i, size_t j) const {
+    return this->value(i * jmax + j);
   }
 
   /**
@@ -110,13 +155,10 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * Throws an exception if index is out of bounds.
    * @param i 1st dimension of 2d data set
    * @param j 2nd dimension of 2d data set
-   * @return the reference to the value of the matrix at position i, j
+   * @return the value of the matrix at position i, j
    */
-  inline Type& at(size_t i, size_t j) {
-    if ((i * jmax + j) >= this->data.size()) {
-      throw std::overflow_error("DataObject error: index out of bounds");
-    }
-    return data[i * jmax + j];
+  inline Type at(size_t i, size_t j) const {
+    return this->value(this->checked_index(i * jmax + j));
   }
 
   /**
@@ -126,8 +168,8 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param k 3rd dimension of 3d data set
    * @return the value of the array at position i, j, k
    */
-  inline const Type operator()(size_t i, size_t j, size_t k) {
-    return data[i * jmax * kmax + j * kmax + k];
+  inline const Type operator()(size_t i, size_t j, size_t k) const {
+    return this->value(i * jmax * kmax + j * kmax + k);
   }
 
   /**
@@ -136,13 +178,10 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param i 1st dimension of 3d data set
    * @param j 2nd dimension of 3d data set
    * @param k 3rd dimension of 3d data set
-   * @return the reference to the value of the array at position i, j, k
+   * @return the value of the array at position i, j, k
    */
-  inline Type& at(size_t i, size_t j, size_t k) {
-    if ((i * jmax * kmax + j * kmax + k) >= this->data.size()) {
-      throw std::overflow_error("DataObject error: index out of bounds");
-    }
-    return data[i * jmax * kmax + j * kmax + k];
+  inline Type at(size_t i, size_t j, size_t k) const {
+    return this->value(this->checked_index(i * jmax * kmax + j * kmax + k));
   }
 
   /**
@@ -153,8 +192,9 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param l 4th dimension of 4d data set
    * @return the value of the array at position i, j, k, l
    */
-  inline const Type operator()(size_t i, size_t j, size_t k, size_t l) {
-    return data[i * jmax * kmax * lmax + j * kmax * lmax + k * lmax + l];
+  inline const Type operator()(size_t i, size_t j, size_t k, size_t l) const {
+    return this->value(i * jmax * kmax * lmax + j * kmax * lmax + k * lmax +
+                       l);
   }
 
   /**
@@ -164,16 +204,129 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @param j 2nd dimension of 4d data set
    * @param k 3rd dimension of 4d data set
    * @param l 4th dimension of 4d data set
-   * @return the reference to the value of the array at position i, j, k, l
+   * @return the value of the array at position i, j, k, l
    */
-  inline Type& at(size_t i, size_t j, size_t k, size_t l) {
-    if ((i * jmax * kmax * lmax + j * kmax * lmax + k * lmax + l) >=
-        this->data.size()) {
-      throw std::overflow_error("DataObject error: index out of bounds");
+  inline Type at(size_t i, size_t j, size_t k, size_t l) const {
+    return this->value(this->checked_index(i * jmax * kmax * lmax +
+                                           j * kmax * lmax + k * lmax + l));
+  }
+
+  /**
+   * Set an element of the data set using its flattened index.
+   * Throws an exception if index is out of bounds.
+   * @param i flattened index of the element
+   * @param value the observed value
+   */
+  inline void set(size_t i, double value) {
+    (*data)[this->checked_index(i)] = value;
+  }
+
+  /**
+   * Replace all observations of the data set, e.g., with a bootstrap
+   * replicate. The likelihoods test for missing values while the AD model
+   * is taped, so a tape only sees new values where it saw observations.
+   * Replacements must therefore keep the missing values where they are.
+   * Throws an exception if a value is missing in only one of the data sets.
+   * @param values pointer to size() observations in flattened order
+   */
+  void replace_observations(const double* values) {
+    const double na = -999.0;
+    for (size_t i = 0; i < this->size(); i++) {
+      if ((values[i] == na) != ((*data)[i] == na)) {
+        throw std::invalid_argument(
+            "DataObject " + std::to_string(this->id) + ": element " +
+            std::to_string(i) +
+            " changes whether it is missing (-999), which a taped model "
+            "cannot see. The missing values of the replacement must match "
+            "those of the observations.");
+      }
     }
-    return data[i * jmax * kmax * lmax + j * kmax * lmax + k * lmax + l];
+    std::copy(values, values + this->size(), data->begin());
+  }
+
+  /**
+   * Set an element of the data set to a simulated value. Simulation only
+   * runs for the double version of the model, but the AD version has to
+   * compile, so the value is reduced to a double before it is stored.
+   * @param i flattened index of the element
+   * @param value the simulated value
+   */
+  inline void set_simulated(size_t i, const Type& value) {
+#ifdef TMB_MODEL
+    this->set(i, asDouble(value));
+#else
+    this->set(i, value);
+#endif
+    if (this->tape_values != nullptr) {
+      this->tape_values[i] = value;
+    }
+  }
+
+  /**
+   * Supply the observations as values of Type, e.g., a tape-level data
+   * input of the AD model that can be updated between evaluations without
+   * re-taping. The values are read in place, not copied, so they must
+   * outlive the evaluation, see clear_tape_values(). Once set, reads return
+   * these values instead of the stored double observations.
+   * @param values pointer to size() values in flattened order
+   */
+  void set_tape_values(Type* values) { this->tape_values = values; }
+
+  /**
+   * Stop reading the values supplied by set_tape_values() and the weights
+   * supplied by set_weights(), e.g., once the
+   * vector that holds them goes out of scope, so reads return the stored
+   * double observations again.
+   */
+  void clear_tape_values() {
+    this->tape_values = nullptr;
+    this->weights = nullptr;
+  }
+
+  /**
+   * Supply a weight for each observation, which multiplies its log-likelihood
+   * contribution. A weight of zero removes the observation from the
+   * objective function, e.g., to mask the terminal years of a retrospective
+   * peel without changing the dimensions of the model. The weights are read
+   * in place like the values of set_tape_values().
+   * @param values pointer to size() weights in flattened order, or null to
+   * give every observation a weight of one
+   */
+  void set_weights(const Type* values) { this->weights = values; }
+
+  /**
+   * Check if likelihood weights were supplied. The likelihoods only multiply
+   * by the weights if so, so an unweighted model has no extra operations.
+   * @return true if set_weights() was given weights
+   */
+  inline bool has_weights() const { return this->weights != nullptr; }
+
+  /**
+   * Retrieve the likelihood weight of one observation.
+   * @param i flattened index of the element
+   * @return the weight, which is one if no weights were supplied
+   */
+  inline Type weight(size_t i) const {
+    return this->weights == nullptr ? static_cast<Type>(1.0)
+                                    : this->weights[i];
+  }
+
+  /**
+   * Get the index of the first dimension, i.e., the year, of an element.
+   * @param i flattened index of the element
+   * @return the year index of the element
+   */
+  inline size_t get_year_index(size_t i) const {
+    return i / (this->size() / this->imax);
   }
 
+  /**
+   * @brief Get the number of elements in the data set
+   *
+   * @return size_t
+   */
+  size_t size() const { return data->size(); }
+
   /**
    * @brief Get the dimensions object
    *
@@ -208,6 +361,39 @@ struct DataObject : public fims_model_object::FIMSObject<Type> {
    * @return size_t
    */
   size_t get_lmax() const { return lmax; }
+
+ private:
+  /**
+   * Read one element, promoting the stored double to Type unless the
+   * observations were supplied as tape values.
+   * @param i flattened index
+   * @return the value at position i
+   */
+  inline Type value(size_t i) const {
+    return this->tape_values != nullptr ? this->tape_values[i]
+                                        : static_cast<Type>((*data)[i]);
+  }
+
+  /**
+   * Allocate new data and uncertainty storage owned by this data object.
+   * @param n number of elements
+   */
+  void allocate(size_t n) {
+    data = std::make_shared<fims::Vector<double>>(n);
+    uncertainty = std::make_shared<fims::Vector<double>>(n);
+  }
+
+  /**
+   * Check a flattened index against the size of the data set.
+   * @param i flattened index
+   * @return the index if it is within bounds
+   */
+  inline size_t checked_index(size_t i) const {
+    if (i >= this->data->size()) {
+      throw std::overflow_error("DataObject error: index out of bounds");
+    }
+    return i;
+  }
 };
 
 template <typename Type>
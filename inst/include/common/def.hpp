@@ -590,6 +590,29 @@ class FIMSLog {
    */
   size_t get_error_count() const { return error_count; }
 
+  /**
+   * @brief Get the heap bytes held by the in-memory log.
+   *
+   * @details Counts the storage of the entry vectors and the text of each
+   * entry. Short strings stored inside the string object are counted with
+   * their capacity, so the result is an upper bound.
+   *
+   * @return Approximate number of bytes.
+   */
+  size_t get_memory_bytes() const {
+    size_t bytes = this->entries.capacity() * sizeof(std::string) +
+                   this->log_entries.capacity() * sizeof(LogEntry);
+    for (const std::string& entry : this->entries) {
+      bytes += entry.capacity();
+    }
+    for (const LogEntry& l : this->log_entries) {
+      bytes += l.timestamp.capacity() + l.message.capacity() +
+               l.level.capacity() + l.user.capacity() + l.wd.capacity() +
+               l.file.capacity() + l.routine.capacity();
+    }
+    return bytes;
+  }
+
   /**
    * @brief Return the number of warning-log entries currently stored.
    *
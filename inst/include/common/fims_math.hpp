@@ -62,6 +62,17 @@ template <class Type>
 inline const Type lgamma(const Type &x) {
   return std::lgamma(x);
 }
+
+/**
+ * @brief The value of x as a double.
+ *
+ * @param x the value to convert
+ * @return x as a double
+ */
+template <class Type>
+inline double to_double(const Type &x) {
+  return static_cast<double>(x);
+}
 #endif
 
 #ifdef TMB_MODEL
@@ -185,6 +196,18 @@ inline const Type lgamma(const Type &x) {
   return lgamma(x);
 }
 
+/**
+ * @brief The value of x as a double, i.e., the value of an AD variable
+ * without its derivative information.
+ *
+ * @param x the value to convert
+ * @return x as a double
+ */
+template <class Type>
+inline double to_double(const Type &x) {
+  return asDouble(x);
+}
+
 #endif
 
 /**
@@ -14,6 +14,29 @@
 
 namespace fims {
 
+/**
+ * @brief Strided view of a parameter that is either a scalar shared by all
+ * instances or a vector with one value per instance.
+ *
+ * @details The view is resolved once with
+ * \ref fims::Vector::strided_view(size_t) "strided_view()", which checks the
+ * size of the parameter, so kernels index it without the branches of
+ * \ref fims::Vector::get_force_scalar(size_t) "get_force_scalar()". A
+ * scalar has a stride of zero and a vector has a stride of one. The view
+ * does not own the values and is invalidated if the vector is resized, so
+ * it is resolved again at the start of each evaluation.
+ */
+template <typename Type>
+struct StridedView {
+  Type *values = nullptr; /**< pointer to the first value */
+  size_t stride = 0;      /**< zero for a scalar and one for a vector */
+
+  /**
+   * @brief Returns a reference to the value of instance i.
+   */
+  inline Type &operator[](size_t i) const { return values[i * stride]; }
+};
+
 /**
  * Wrapper class for std::vector types. If this file is compiled with
  * -DTMB_MODEL, conversion operators are defined for TMB vector types.
@@ -190,6 +213,31 @@ class Vector {
     }
   }
 
+  /**
+   * @brief Resolves the scalar or vector semantics of
+   * \ref get_force_scalar(size_t) "get_force_scalar()" for n instances into
+   * a strided view. A vector of size 1 is broadcast to all instances with a
+   * stride of zero and a vector with at least n values is read with a stride
+   * of one. Otherwise, an invalid_argument exception is thrown.
+   *
+   * @param n The number of instances that index the view.
+   * @return The view of the values of this vector.
+   */
+  inline StridedView<Type> strided_view(size_t n) {
+    StridedView<Type> view;
+    if (this->size() == 1) {
+      view.values = this->data();
+      view.stride = 0;
+    } else if (this->size() >= n) {
+      view.values = this->data();
+      view.stride = 1;
+    } else {
+      throw std::invalid_argument(
+          "fims::Vector index out of bounds, check parameter sizes of input.");
+    }
+    return view;
+  }
+
   /**
    * @brief  Returns a reference to the first element in the container.
    */
@@ -286,7 +334,7 @@ class Vector {
    * @brief Returns the number of elements that can be held in currently
    * allocated storage.
    */
-  inline size_type capacity() { return this->vec_m.capacity(); }
+  inline size_type capacity() const { return this->vec_m.capacity(); }
 
   /**
    *  @brief Reduces memory usage by freeing unused memory.
@@ -14,6 +14,9 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "../distributions/distributions.hpp"
@@ -45,6 +48,21 @@ class Information {
       random_effects_parameters; /**< list of all random effects parameters >*/
   std::vector<Type*>
       fixed_effects_parameters; /**< list of all fixed effects parameters >*/
+  /**
+   * @brief A run of estimated parameters that are adjacent in memory, i.e.,
+   * consecutive elements of the same fims::Vector in a module.
+   */
+  struct ParameterBlock {
+    Type* data;    /**< first element of the run in module storage */
+    size_t offset; /**< index of the first element in the parameter vector */
+    size_t size;   /**< number of elements in the run */
+  };
+  std::vector<ParameterBlock>
+      fixed_effects_blocks; /**< fixed effects parameters grouped into runs that
+                               are contiguous in memory >*/
+  std::vector<ParameterBlock>
+      random_effects_blocks; /**< random effects parameters grouped into runs
+                                that are contiguous in memory >*/
   std::vector<std::string> parameter_names; /**< list of all parameter names
                                                estimated in the model */
   std::vector<std::string>
@@ -148,6 +166,22 @@ class Information {
 
   virtual ~Information() {}
 
+ private:
+  /**
+   * @brief Adds the objects in a map of modules to a memory usage.
+   */
+  template <typename Map>
+  static void AddMemoryUsage(fims_model_object::MemoryUsage &usage,
+                             const Map &modules) {
+    for (const auto &kv : modules) {
+      if (kv.second != nullptr) {
+        usage.objects++;
+        usage.bytes += kv.second->OwnedBytes();
+      }
+    }
+  }
+
+ public:
   /**
    * @brief Clears all containers.
    *
@@ -156,6 +190,7 @@ class Information {
     this->data_objects.clear();
     this->populations.clear();
     this->fixed_effects_parameters.clear();
+    this->fixed_effects_blocks.clear();
     this->fleets.clear();
     this->growth_models.clear();
     this->maturity_models.clear();
@@ -163,6 +198,7 @@ class Information {
     this->parameters.clear();
     this->random_effects_names.clear();
     this->random_effects_parameters.clear();
+    this->random_effects_blocks.clear();
     this->selectivity_models.clear();
     this->models_map.clear();
     this->n_years = 0;
@@ -274,6 +310,8 @@ class Information {
    * @param p parameter
    */
   void RegisterParameter(Type& p) {
+    AppendToBlocks(this->fixed_effects_blocks, &p,
+                   this->fixed_effects_parameters.size());
     this->fixed_effects_parameters.push_back(&p);
   }
 
@@ -283,9 +321,142 @@ class Information {
    * @param re random effect
    */
   void RegisterRandomEffect(Type& re) {
+    AppendToBlocks(this->random_effects_blocks, &re,
+                   this->random_effects_parameters.size());
     this->random_effects_parameters.push_back(&re);
   }
 
+  /**
+   * @brief Copy the values of all fixed effects parameters into the modules.
+   *
+   * @details The values are copied one contiguous run at a time, which
+   * replaces dereferencing a separate pointer for every parameter.
+   *
+   * @param values Pointer to fixed_effects_parameters.size() values ordered
+   * as the parameters were registered.
+   */
+  void SetFixedEffects(const Type* values) {
+    CopyToBlocks(this->fixed_effects_blocks, values);
+  }
+
+  /**
+   * @brief Copy the values of all random effects parameters into the
+   * modules.
+   *
+   * @param values Pointer to random_effects_parameters.size() values ordered
+   * as the random effects were registered.
+   */
+  void SetRandomEffects(const Type* values) {
+    CopyToBlocks(this->random_effects_blocks, values);
+  }
+
+  /**
+   * @brief Copy the current values of all fixed effects parameters out of
+   * the modules.
+   *
+   * @param values Pointer to storage for fixed_effects_parameters.size()
+   * values.
+   */
+  void GetFixedEffects(Type* values) const {
+    CopyFromBlocks(this->fixed_effects_blocks, values);
+  }
+
+  /**
+   * @brief Copy the current values of all random effects parameters out of
+   * the modules.
+   *
+   * @param values Pointer to storage for random_effects_parameters.size()
+   * values.
+   */
+  void GetRandomEffects(Type* values) const {
+    CopyFromBlocks(this->random_effects_blocks, values);
+  }
+
+  /**
+   * @brief Copy values into a range of the fixed effects parameters, e.g.,
+   * the range of one block returned by GetParameterBlockRange().
+   *
+   * @details Only the contiguous runs that overlap the range are visited and
+   * each overlap is copied at once.
+   *
+   * @param first Index of the first parameter of the range.
+   * @param count Number of parameters in the range.
+   * @param values Pointer to count values.
+   */
+  void SetFixedEffectsRange(size_t first, size_t count, const Type* values) {
+    CheckRange(this->fixed_effects_parameters.size(), first, count);
+    CopyToBlocks(this->fixed_effects_blocks, first, count, values);
+  }
+
+  /**
+   * @brief Copy values into a range of the random effects parameters.
+   *
+   * @param first Index of the first random effect of the range.
+   * @param count Number of random effects in the range.
+   * @param values Pointer to count values.
+   */
+  void SetRandomEffectsRange(size_t first, size_t count, const Type* values) {
+    CheckRange(this->random_effects_parameters.size(), first, count);
+    CopyToBlocks(this->random_effects_blocks, first, count, values);
+  }
+
+  /**
+   * @brief Copy the current values of a range of the fixed effects
+   * parameters out of the modules.
+   *
+   * @param first Index of the first parameter of the range.
+   * @param count Number of parameters in the range.
+   * @param values Pointer to storage for count values.
+   */
+  void GetFixedEffectsRange(size_t first, size_t count, Type* values) const {
+    CheckRange(this->fixed_effects_parameters.size(), first, count);
+    CopyFromBlocks(this->fixed_effects_blocks, first, count, values);
+  }
+
+  /**
+   * @brief Copy the current values of a range of the random effects
+   * parameters out of the modules.
+   *
+   * @param first Index of the first random effect of the range.
+   * @param count Number of random effects in the range.
+   * @param values Pointer to storage for count values.
+   */
+  void GetRandomEffectsRange(size_t first, size_t count, Type* values) const {
+    CheckRange(this->random_effects_parameters.size(), first, count);
+    CopyFromBlocks(this->random_effects_blocks, first, count, values);
+  }
+
+  /**
+   * @brief Take a snapshot of the current parameter state.
+   *
+   * @return The fixed effects followed by the random effects.
+   */
+  std::vector<Type> GetParameterSnapshot() const {
+    const size_t n_fixed = this->fixed_effects_parameters.size();
+    std::vector<Type> snapshot(n_fixed +
+                               this->random_effects_parameters.size());
+    CopyFromBlocks(this->fixed_effects_blocks, snapshot.data());
+    CopyFromBlocks(this->random_effects_blocks, snapshot.data() + n_fixed);
+    return snapshot;
+  }
+
+  /**
+   * @brief Restore a parameter state taken with GetParameterSnapshot().
+   *
+   * @param snapshot The fixed effects followed by the random effects.
+   */
+  void RestoreParameterSnapshot(const std::vector<Type>& snapshot) {
+    const size_t n_fixed = this->fixed_effects_parameters.size();
+    if (snapshot.size() !=
+        n_fixed + this->random_effects_parameters.size()) {
+      throw std::invalid_argument(
+          "Parameter snapshot of size " + fims::to_string(snapshot.size()) +
+          " does not match the number of registered parameters.");
+    }
+    CopyToBlocks(this->fixed_effects_blocks, snapshot.data());
+    CopyToBlocks(this->random_effects_blocks, snapshot.data() + n_fixed);
+  }
+
   /**
    * @brief Register a parameter name.
    *
@@ -304,6 +475,144 @@ class Information {
     this->random_effects_names.push_back(re_name);
   }
 
+  /**
+   * @brief Get the total number of observations over all data objects.
+   *
+   * @return The length of the vector used by SetObservedData().
+   */
+  size_t GetNumberOfObservations() {
+    size_t n = 0;
+    for (data_iterator it = this->data_objects.begin();
+         it != this->data_objects.end(); ++it) {
+      n += (*it).second->size();
+    }
+    return n;
+  }
+
+  /**
+   * @brief Supply the observations of all data objects as values of Type.
+   *
+   * @details The values are ordered by data object id and, within a data
+   * object, in flattened order. With TMB this allows the observations to be
+   * a tape-level data input, so they can be replaced between evaluations,
+   * e.g., for a parametric bootstrap, without re-taping the model. Each data
+   * object reads its values in place at its offset into the vector, so the
+   * vector must outlive the evaluation, see ClearObservedData().
+   *
+   * @param values Pointer to GetNumberOfObservations() values.
+   */
+  void SetObservedData(Type* values) {
+    size_t offset = 0;
+    for (data_iterator it = this->data_objects.begin();
+         it != this->data_objects.end(); ++it) {
+      (*it).second->set_tape_values(values + offset);
+      offset += (*it).second->size();
+    }
+  }
+
+  /**
+   * @brief Stop reading the values supplied by SetObservedData() and the
+   * weights supplied by SetObservationWeights(), so the data objects read
+   * their stored observations again and are unweighted.
+   */
+  void ClearObservedData() {
+    for (data_iterator it = this->data_objects.begin();
+         it != this->data_objects.end(); ++it) {
+      (*it).second->clear_tape_values();
+    }
+  }
+
+  /**
+   * @brief Supply the likelihood weights of all observations, ordered as in
+   * SetObservedData().
+   *
+   * @details Data objects that are kept in every retrospective peel, e.g.,
+   * landings, always have a weight of one, so they are not given weights
+   * and their likelihoods are not multiplied by them.
+   *
+   * @param values Pointer to GetNumberOfObservations() weights.
+   */
+  void SetObservationWeights(const Type* values) {
+    size_t offset = 0;
+    for (data_iterator it = this->data_objects.begin();
+         it != this->data_objects.end(); ++it) {
+      fims_data_object::DataObject<Type>& data = *(*it).second;
+      data.set_weights(data.retrospective_peel ? values + offset : nullptr);
+      offset += data.size();
+    }
+  }
+
+  /**
+   * @brief Build the observation weights of a retrospective peel.
+   *
+   * @details Observations in the terminal n_years years of each data object
+   * get a weight of zero and all other observations a weight of one. Data
+   * objects that are not peeled, e.g., landings, keep all years. Masking the
+   * observations instead of removing them keeps the dimensions of the model,
+   * so one model can be refit for each peel.
+   *
+   * @param n_years The number of terminal years to remove.
+   * @return A vector of GetNumberOfObservations() weights ordered as in
+   * SetObservedData().
+   */
+  std::vector<double> GetRetrospectiveWeights(size_t n_years) {
+    std::vector<double> weights;
+    weights.reserve(this->GetNumberOfObservations());
+    for (data_iterator it = this->data_objects.begin();
+         it != this->data_objects.end(); ++it) {
+      fims_data_object::DataObject<Type>& data = *(*it).second;
+      for (size_t i = 0; i < data.size(); i++) {
+        bool removed = data.retrospective_peel &&
+                       data.get_year_index(i) + n_years >= data.get_imax();
+        weights.push_back(removed ? 0.0 : 1.0);
+      }
+    }
+    return weights;
+  }
+
+  /**
+   * @brief Find the range of registered parameters that belong to a named
+   * block.
+   *
+   * @details Parameter names are registered as
+   * "<module>.<module id>.<parameter>.<variable id>", one name per element,
+   * and the elements of a parameter vector are registered consecutively. A
+   * block is addressed by the name without the variable id, e.g.,
+   * "Fleet.2.log_Fmort", which allows the whole vector to be read or written
+   * with a single copy instead of matching each element by name.
+   *
+   * @param names The registered names to search, i.e., parameter_names or
+   * random_effects_names.
+   * @param block_name The name of the block, i.e., "<module>.<module
+   * id>.<parameter>".
+   * @return A pair holding the index of the first element of the block and
+   * the number of elements in the block.
+   */
+  std::pair<size_t, size_t> GetParameterBlockRange(
+      const std::vector<std::string>& names,
+      const std::string& block_name) const {
+    const std::string prefix = block_name + ".";
+    size_t first = names.size();
+    size_t count = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+      if (names[i].compare(0, prefix.size(), prefix) == 0) {
+        if (count == 0) {
+          first = i;
+        } else if (first + count != i) {
+          throw std::invalid_argument(
+              "Parameter block " + block_name +
+              " is not registered as a contiguous block.");
+        }
+        count++;
+      }
+    }
+    if (count == 0) {
+      throw std::invalid_argument("Parameter block " + block_name +
+                                  " was not found.");
+    }
+    return std::make_pair(first, count);
+  }
+
   /**
    * @brief Loop over distributions and set links to distribution x value if
    * distribution is a prior type.
@@ -837,6 +1146,51 @@ class Information {
     }
   }
 
+  /**
+   * @brief Gets the number of objects and the heap bytes that they own by
+   * module type.
+   *
+   * @details Each object is counted once, from the map in Information that
+   * holds it, even if other modules point to it. The entry "information"
+   * is the storage of Information itself, i.e., the parameter lists, blocks,
+   * names, and the variable map.
+   *
+   * @return std::map<std::string, fims_model_object::MemoryUsage>
+   */
+  std::map<std::string, fims_model_object::MemoryUsage> GetMemoryUsage()
+      const {
+    std::map<std::string, fims_model_object::MemoryUsage> usage;
+    Information<Type>::AddMemoryUsage(usage["data"], this->data_objects);
+    Information<Type>::AddMemoryUsage(usage["density_components"],
+                                      this->density_components);
+    Information<Type>::AddMemoryUsage(usage["fishery_models"],
+                                      this->models_map);
+    Information<Type>::AddMemoryUsage(usage["fleets"], this->fleets);
+    Information<Type>::AddMemoryUsage(usage["growth"], this->growth_models);
+    Information<Type>::AddMemoryUsage(usage["maturity"],
+                                      this->maturity_models);
+    Information<Type>::AddMemoryUsage(usage["populations"], this->populations);
+    Information<Type>::AddMemoryUsage(usage["recruitment"],
+                                      this->recruitment_models);
+    Information<Type>::AddMemoryUsage(usage["recruitment_process"],
+                                      this->recruitment_process_models);
+    Information<Type>::AddMemoryUsage(usage["selectivity"],
+                                      this->selectivity_models);
+
+    fims_model_object::MemoryUsage &information = usage["information"];
+    information.objects = 1;
+    information.bytes =
+        fims::HeapBytes(this->parameters) +
+        fims::HeapBytes(this->random_effects_parameters) +
+        fims::HeapBytes(this->fixed_effects_parameters) +
+        fims::HeapBytes(this->fixed_effects_blocks) +
+        fims::HeapBytes(this->random_effects_blocks) +
+        fims::HeapBytes(this->parameter_names) +
+        fims::HeapBytes(this->random_effects_names) +
+        fims::HeapBytes(this->variable_map);
+    return usage;
+  }
+
   /**
    * @brief Create the generalized stock assessment model that will evaluate the
    * objective function. Does error checking to make sure the program has
@@ -947,7 +1301,7 @@ class Information {
         if (pt != this->populations.end()) {
           std::shared_ptr<fims_popdy::Population<Type>> p = (*pt).second;
 
-          if (model->model_type_m == "caa") {
+          if (model->model_type == fims_popdy::CatchAtAgeModelType) {
             typename std::set<uint32_t>::iterator fleet_ids_it;
             for (fleet_ids_it = p->fleet_ids.begin();
                  fleet_ids_it != p->fleet_ids.end(); ++fleet_ids_it) {
@@ -1014,6 +1368,97 @@ class Information {
     }
     return valid_model;
   }
+
+ private:
+  /**
+   * @brief Add a registered parameter to the list of contiguous runs,
+   * extending the last run when the parameter directly follows it in memory.
+   *
+   * @param blocks The runs to add to.
+   * @param p Pointer to the registered parameter.
+   * @param offset Index of the parameter in the parameter vector.
+   */
+  static void AppendToBlocks(std::vector<ParameterBlock>& blocks, Type* p,
+                             size_t offset) {
+    if (!blocks.empty()) {
+      ParameterBlock& last = blocks.back();
+      if (last.data + last.size == p && last.offset + last.size == offset) {
+        last.size++;
+        return;
+      }
+    }
+    blocks.push_back({p, offset, 1});
+  }
+
+  /**
+   * @brief Copy values into the module storage of each run.
+   */
+  static void CopyToBlocks(const std::vector<ParameterBlock>& blocks,
+                           const Type* values) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      const ParameterBlock& b = blocks[i];
+      std::copy(values + b.offset, values + b.offset + b.size, b.data);
+    }
+  }
+
+  /**
+   * @brief Copy values out of the module storage of each run.
+   */
+  static void CopyFromBlocks(const std::vector<ParameterBlock>& blocks,
+                             Type* values) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      const ParameterBlock& b = blocks[i];
+      std::copy(b.data, b.data + b.size, values + b.offset);
+    }
+  }
+
+  /**
+   * @brief Throw if a range does not lie within a parameter vector.
+   */
+  static void CheckRange(size_t n, size_t first, size_t count) {
+    if (first > n || count > n - first) {
+      throw std::invalid_argument(
+          "Parameter range starting at " + fims::to_string(first) +
+          " with " + fims::to_string(count) +
+          " values exceeds the number of registered parameters.");
+    }
+  }
+
+  /**
+   * @brief Copy values into the part of each run that lies within the range
+   * [first, first + count) of the parameter vector.
+   */
+  static void CopyToBlocks(const std::vector<ParameterBlock>& blocks,
+                           size_t first, size_t count, const Type* values) {
+    const size_t last = first + count;
+    for (size_t i = 0; i < blocks.size() && blocks[i].offset < last; i++) {
+      const ParameterBlock& b = blocks[i];
+      const size_t begin = std::max(b.offset, first);
+      const size_t end = std::min(b.offset + b.size, last);
+      if (begin < end) {
+        std::copy(values + (begin - first), values + (end - first),
+                  b.data + (begin - b.offset));
+      }
+    }
+  }
+
+  /**
+   * @brief Copy values out of the part of each run that lies within the
+   * range [first, first + count) of the parameter vector.
+   */
+  static void CopyFromBlocks(const std::vector<ParameterBlock>& blocks,
+                             size_t first, size_t count, Type* values) {
+    const size_t last = first + count;
+    for (size_t i = 0; i < blocks.size() && blocks[i].offset < last; i++) {
+      const ParameterBlock& b = blocks[i];
+      const size_t begin = std::max(b.offset, first);
+      const size_t end = std::min(b.offset + b.size, last);
+      if (begin < end) {
+        std::copy(b.data + (begin - b.offset), b.data + (end - b.offset),
+                  values + (begin - first));
+      }
+    }
+  }
 };
 
 template <typename Type>
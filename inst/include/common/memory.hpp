@@ -0,0 +1,132 @@
+/**
+ * @file memory.hpp
+ * @brief Functions to estimate the heap memory owned by containers.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_COMMON_MEMORY_HPP
+#define FIMS_COMMON_MEMORY_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "fims_vector.hpp"
+
+namespace fims {
+
+template <typename T>
+size_t HeapBytes(const T &x);
+inline size_t HeapBytes(const std::string &x);
+template <typename T>
+size_t HeapBytes(const fims::Vector<T> &x);
+template <typename T>
+size_t HeapBytes(const std::vector<T> &x);
+template <typename K>
+size_t HeapBytes(const std::set<K> &x);
+template <typename K, typename V>
+size_t HeapBytes(const std::map<K, V> &x);
+template <typename K, typename V>
+size_t HeapBytes(const std::unordered_map<K, V> &x);
+
+/**
+ * @brief Bytes of bookkeeping per node of a std::map or std::set, i.e., the
+ * parent, left, and right pointers and the color of a red--black tree node,
+ * and per node of a std::unordered_map, i.e., the next pointer, the cached
+ * hash, and a bucket.
+ */
+inline size_t NodeOverheadBytes() { return 4 * sizeof(void *); }
+
+/**
+ * @brief Heap bytes owned by a value without heap storage.
+ */
+template <typename T>
+size_t HeapBytes(const T &) {
+  return 0;
+}
+
+/**
+ * @brief Heap bytes owned by a string beyond the small string buffer.
+ */
+inline size_t HeapBytes(const std::string &x) {
+  return x.capacity() > std::string().capacity() ? x.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Heap bytes owned by a fims::Vector and its elements.
+ */
+template <typename T>
+size_t HeapBytes(const fims::Vector<T> &x) {
+  size_t bytes = x.capacity() * sizeof(T);
+  for (size_t i = 0; i < x.size(); i++) {
+    bytes += HeapBytes(x[i]);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Heap bytes owned by a std::vector and its elements.
+ */
+template <typename T>
+size_t HeapBytes(const std::vector<T> &x) {
+  size_t bytes = x.capacity() * sizeof(T);
+  for (const T &value : x) {
+    bytes += HeapBytes(value);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Heap bytes owned by a std::set.
+ */
+template <typename K>
+size_t HeapBytes(const std::set<K> &x) {
+  return x.size() * (sizeof(K) + NodeOverheadBytes());
+}
+
+/**
+ * @brief Heap bytes owned by a std::map and its keys and values.
+ */
+template <typename K, typename V>
+size_t HeapBytes(const std::map<K, V> &x) {
+  size_t bytes = x.size() * (sizeof(std::pair<const K, V>) +
+                             NodeOverheadBytes());
+  for (const auto &kv : x) {
+    bytes += HeapBytes(kv.first) + HeapBytes(kv.second);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Heap bytes owned by a std::unordered_map and its keys and values.
+ */
+template <typename K, typename V>
+size_t HeapBytes(const std::unordered_map<K, V> &x) {
+  size_t bytes = x.size() * (sizeof(std::pair<const K, V>) +
+                             NodeOverheadBytes()) +
+                 x.bucket_count() * sizeof(void *);
+  for (const auto &kv : x) {
+    bytes += HeapBytes(kv.first) + HeapBytes(kv.second);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Heap bytes of an object held by a std::shared_ptr, divided evenly
+ * among the owners so that shared storage is counted once in total.
+ */
+template <typename T>
+size_t SharedHeapBytes(const std::shared_ptr<T> &x) {
+  if (x == nullptr) {
+    return 0;
+  }
+  return (sizeof(T) + HeapBytes(*x)) / x.use_count();
+}
+
+}  // namespace fims
+
+#endif /* FIMS_COMMON_MEMORY_HPP */
@@ -9,10 +9,16 @@
 #ifndef FIMS_COMMON_MODEL_HPP
 #define FIMS_COMMON_MODEL_HPP
 
+#include <algorithm>
 #include <future>
+#include <map>
 #include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "information.hpp"
+#include "timer.hpp"
 
 namespace fims_model {
 
@@ -43,7 +49,7 @@ class Model {  // may need singleton
    * @brief Evaluate. Calculates the joint negative log-likelihood function.
    */
 #ifdef TMB_MODEL
-  ::objective_function<Type> *of;
+  ::objective_function<Type> *of = nullptr;
 #endif
 
   /**
@@ -60,8 +66,49 @@ class Model {  // may need singleton
     return Model<Type>::fims_model;
   }
 
+  /**
+   * @brief Check if TMB collects the REPORTed values of the current
+   * evaluation, i.e., if it is the evaluation with doubles behind
+   * `obj$report()` and `obj$simulate()`.
+   */
+  bool IsCollectingReport() const {
+#ifdef TMB_MODEL
+    return isDouble<Type>::value && this->of != nullptr &&
+           this->of->current_parallel_region < 0;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Check if TMB collects the ADREPORTed values of the current
+   * evaluation, i.e., if it is a taped evaluation.
+   *
+   * @details This is true for every tape. The values are only used by the
+   * tape behind `TMB::sdreport()`, but TMB does not tell the tapes apart, so
+   * the quantities selected for ADREPORT are copied whenever a tape is
+   * recorded.
+   */
+  bool IsCollectingAdreport() const {
+#ifdef TMB_MODEL
+    return !isDouble<Type>::value && this->of != nullptr;
+#else
+    return false;
+#endif
+  }
+
   /**
    * @brief Evaluate. Calculates the joint negative log-likelihood function.
+   *
+   * @details The derived quantities are only copied into TMB containers if
+   * TMB collects them from this evaluation, see IsCollectingReport() and
+   * IsCollectingAdreport(). When a tape is recorded, only the quantities
+   * selected for ADREPORT are copied rather than all of them. The double
+   * model evaluated before TMB has linked its objective function, i.e., with
+   * `of` equal to nullptr as in the C++ tests and benchmarks, skips Report()
+   * altogether. Once `TMB::MakeADFun()` has linked `of`, evaluations of the
+   * double model from R report as before. The optimizer replays the tape and
+   * does not run this function, so its evaluations are not affected.
    */
   const Type Evaluate() {
     // jnll = negative-log-likelihood (the objective function)
@@ -80,10 +127,14 @@ class Model {  // may need singleton
     fims::Vector<Type> nll_vec(
         this->fims_information->density_components.size(), 0.0);
 
+    const char *type_name = fims::FIMSTimer::TypeName<Type>();
+    fims::ScopedTimer evaluate_timer("Model", 0, type_name, "Evaluate");
+
     for (m_it = this->fims_information->models_map.begin();
          m_it != this->fims_information->models_map.end(); ++m_it) {
       //(*m_it).second points to the Model module
       std::shared_ptr<fims_popdy::FisheryModelBase<Type>> m = (*m_it).second;
+      fims::ScopedTimer timer("Model", 0, type_name, "fishery_models");
       m->Prepare();
       m->Evaluate();
     }
@@ -100,6 +151,8 @@ class Model {  // may need singleton
       d->of = this->of;
 #endif
       if (d->input_type == "prior") {
+        fims::ScopedTimer timer("DensityComponent", d->GetId(), type_name,
+                                "prior");
         nll_vec[nll_vec_idx] = -d->evaluate();
         jnll += nll_vec[nll_vec_idx];
         n_priors += 1;
@@ -123,6 +176,8 @@ class Model {  // may need singleton
       d->of = this->of;
 #endif
       if (d->input_type == "random_effects") {
+        fims::ScopedTimer timer("DensityComponent", d->GetId(), type_name,
+                                "random_effects");
         nll_vec[nll_vec_idx] = -d->evaluate();
         jnll += nll_vec[nll_vec_idx];
         n_random_effects += 1;
@@ -147,6 +202,8 @@ class Model {  // may need singleton
       // d->keep = this->keep;
 #endif
       if (d->input_type == "data") {
+        fims::ScopedTimer timer("DensityComponent", d->GetId(), type_name,
+                                "data");
         nll_vec[nll_vec_idx] = -d->evaluate();
         jnll += nll_vec[nll_vec_idx];
         n_data += 1;
@@ -160,13 +217,21 @@ class Model {  // may need singleton
         fims::to_string(n_data) +
         " data likelihoods is: " + fims::to_string(jnll));
 
+    bool collect_report = this->IsCollectingReport();
+    bool collect_adreport = this->IsCollectingAdreport();
+    if (!collect_report && !collect_adreport) {
+      return jnll;
+    }
+
     // report out nll components
 
 #ifdef TMB_MODEL
 
-    vector<Type> nll_components = nll_vec.to_tmb();
-    FIMS_REPORT_F(nll_components, this->of);
-    FIMS_REPORT_F(jnll, this->of);
+    if (collect_report) {
+      vector<Type> nll_components = nll_vec.to_tmb();
+      FIMS_REPORT_F(nll_components, this->of);
+      FIMS_REPORT_F(jnll, this->of);
+    }
 
 #endif
 
@@ -175,12 +240,99 @@ class Model {  // may need singleton
          m_it != this->fims_information->models_map.end(); ++m_it) {
       //(*m_it).second points to the Model module
       std::shared_ptr<fims_popdy::FisheryModelBase<Type>> m = (*m_it).second;
+#ifdef TMB_MODEL
       m->of = this->of;  // link to TMB objective function
+      m->collect_report = collect_report;
+      m->collect_adreport = collect_adreport;
+#endif
+      fims::ScopedTimer timer("Model", 0, type_name, "Report");
       m->Report();
     }
 
     return jnll;
   }
+
+  /**
+   * @brief Simulate replicate data sets from the data likelihoods.
+   *
+   * @details The expected values of the most recent evaluation are used, so
+   * the model has to be evaluated at the parameter values of interest first,
+   * e.g., with `obj$report()` in R. Each replicate draws from its own random
+   * number generator, seeded with the seed and the index of the replicate,
+   * so the results are reproducible and do not depend on the number of
+   * threads. The replicates are divided into one contiguous chunk per
+   * thread.
+   *
+   * @param n_replicates The number of data sets to simulate.
+   * @param seed The seed of the random number generators.
+   * @param n_threads The number of threads, where zero uses the number of
+   * hardware threads.
+   * @return A map from the id of each data object with a likelihood to its
+   * replicates, stored one replicate after another in the flattened order of
+   * the data object.
+   */
+  std::map<uint32_t, std::vector<double>> SimulateData(size_t n_replicates,
+                                                       uint64_t seed,
+                                                       size_t n_threads = 0) {
+    std::vector<std::shared_ptr<fims_distributions::DensityComponentBase<Type>>>
+        components;
+    std::map<uint32_t, std::vector<double>> simulated;
+    typename fims_info::Information<Type>::density_components_iterator d_it;
+    for (d_it = this->fims_information->density_components.begin();
+         d_it != this->fims_information->density_components.end(); ++d_it) {
+      std::shared_ptr<fims_distributions::DensityComponentBase<Type>> d =
+          (*d_it).second;
+      if (d->input_type == "data") {
+        components.push_back(d);
+        simulated[static_cast<uint32_t>(d->observed_data_id_m)].resize(
+            n_replicates * d->get_n_x());
+      }
+    }
+
+    std::vector<double*> outputs(components.size());
+    std::vector<size_t> sizes(components.size());
+    for (size_t c = 0; c < components.size(); c++) {
+      outputs[c] =
+          simulated[static_cast<uint32_t>(components[c]->observed_data_id_m)]
+              .data();
+      sizes[c] = components[c]->get_n_x();
+    }
+
+    auto simulate_chunk = [&](size_t first, size_t last) {
+      for (size_t r = first; r < last; r++) {
+        uint64_t replicate = r;
+        std::seed_seq seq{static_cast<uint32_t>(seed),
+                          static_cast<uint32_t>(seed >> 32),
+                          static_cast<uint32_t>(replicate),
+                          static_cast<uint32_t>(replicate >> 32)};
+        std::mt19937_64 rng(seq);
+        for (size_t c = 0; c < components.size(); c++) {
+          components[c]->simulate_replicate(rng, outputs[c] + r * sizes[c]);
+        }
+      }
+    };
+
+    if (n_threads == 0) {
+      n_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    n_threads = std::min(n_threads, std::max<size_t>(1, n_replicates));
+    if (n_threads == 1) {
+      simulate_chunk(0, n_replicates);
+      return simulated;
+    }
+
+    std::vector<std::future<void>> chunks;
+    size_t chunk_size = (n_replicates + n_threads - 1) / n_threads;
+    for (size_t first = 0; first < n_replicates; first += chunk_size) {
+      chunks.push_back(std::async(std::launch::async, simulate_chunk, first,
+                                  std::min(first + chunk_size, n_replicates)));
+    }
+    // get() rethrows any exception thrown on a thread
+    for (size_t i = 0; i < chunks.size(); i++) {
+      chunks[i].get();
+    }
+    return simulated;
+  }
 };
 
 // Create singleton instance of Model class
@@ -13,15 +13,46 @@
 #include <vector>
 
 #include "fims_vector.hpp"
+#include "memory.hpp"
 
 namespace fims_model_object {
 
+/**
+ * @brief Number of objects and the heap bytes that they own.
+ */
+struct MemoryUsage {
+  size_t objects = 0; /**< Number of objects. */
+  size_t bytes = 0;   /**< Heap bytes owned by the objects. */
+};
+
 /**
  * @brief FIMS struct that tracks object memory for leak detection
  */
 struct FIMSMemoryTracker {
   /** @brief Total number of active FIMSObject instances currently in memory. */
   static inline int total_active_objects = 0;
+  /**
+   * @brief Largest total of heap bytes passed to UpdatePeakBytes(), which
+   * persists across `CreateTMBModel()` and `clear()`.
+   */
+  static inline size_t peak_bytes = 0;
+
+  /**
+   * @brief Records a total of heap bytes if it is a new peak.
+   * @param bytes The total heap bytes owned by FIMS objects.
+   */
+  static void UpdatePeakBytes(size_t bytes) {
+    if (bytes > peak_bytes) {
+      peak_bytes = bytes;
+    }
+  }
+
+  /**
+   * @brief Heap bytes owned by the object, i.e., the storage of its vectors,
+   * maps, and strings, but not the object itself or the modules it points
+   * to. Classes with containers override this to add them.
+   */
+  virtual size_t OwnedBytes() const { return fims::HeapBytes(tracker_key_); }
 
   /**
    * @brief Registers a FIMSObject instance with the memory tracker.
@@ -48,6 +79,68 @@ struct FIMSMemoryTracker {
   std::string tracker_key_;
 };
 
+/**
+ * @brief How the values of a module depend on the year.
+ */
+enum TimeDependence {
+  TimeInvariant = 0, /**< The same values in every year. */
+  PerYear,           /**< The values can differ between all years. */
+  BlockVarying       /**< The values are constant within blocks of years. */
+};
+
+/**
+ * @brief Declares the time dependence of a life-history module, so that a
+ * model can evaluate the module once per block of years and share the
+ * values with the other years of the block.
+ */
+struct TimeDependentObject {
+  /**
+   * @brief How the values depend on the year. Per year by default, which is
+   * correct for every module.
+   */
+  TimeDependence time_dependence = PerYear;
+  /**
+   * @brief The first year of each block of years in increasing order, which
+   * is used if the time dependence is BlockVarying. The years before the
+   * first block form a block that starts in year zero.
+   */
+  std::vector<size_t> block_start_years;
+
+  virtual ~TimeDependentObject() {}
+
+  /**
+   * @brief How the values depend on the year.
+   */
+  virtual TimeDependence GetTimeDependence() const {
+    return this->time_dependence;
+  }
+
+  /**
+   * @brief The first year of the block of years that a year belongs to, whose
+   * values are shared with the year. A model evaluates the module in the
+   * years where this is the year itself and copies the values otherwise.
+   *
+   * @param year The year.
+   */
+  size_t GetTimeBlockYear(size_t year) const {
+    switch (this->GetTimeDependence()) {
+      case TimeInvariant:
+        return 0;
+      case BlockVarying: {
+        size_t block_year = 0;
+        for (size_t i = 0; i < this->block_start_years.size() &&
+                           this->block_start_years[i] <= year;
+             i++) {
+          block_year = this->block_start_years[i];
+        }
+        return block_year;
+      }
+      default:
+        return year;
+    }
+  }
+};
+
 /**
  * @brief FIMSObject struct that defines member types and returns the unique id
  */
@@ -64,6 +157,15 @@ struct FIMSObject : public FIMSMemoryTracker {
 
   virtual ~FIMSObject() {}
 
+  /**
+   * @brief Heap bytes owned by the object, including its parameter lists.
+   */
+  virtual size_t OwnedBytes() const {
+    return FIMSMemoryTracker::OwnedBytes() + fims::HeapBytes(parameters) +
+           fims::HeapBytes(random_effects_parameters) +
+           fims::HeapBytes(fixed_effects_parameters);
+  }
+
   /**
    * @brief Getter that returns the unique id for parameters in the model
    */
@@ -0,0 +1,369 @@
+/**
+ * @file timer.hpp
+ * @brief Scoped timers and call counters for the phases of a model evaluation.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_COMMON_TIMER_HPP
+#define FIMS_COMMON_TIMER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "../interface/interface.hpp"
+
+namespace fims {
+
+/**
+ * @brief Number of calls and total time of one timed phase.
+ */
+struct TimerStatistics {
+  size_t calls = 0;     /**< Number of times the phase was entered. */
+  double seconds = 0.0; /**< Total wall time spent in the phase. */
+};
+
+/**
+ * @brief Number of calls of one phase and the operations and variables it
+ * added to the AD tape.
+ */
+struct TapeStatistics {
+  size_t tape = 0;       /**< Generation of the tape that the counts refer
+                            to, see FIMSTimer::StartTape(). */
+  size_t calls = 0;      /**< Number of times the phase was taped. */
+  size_t operations = 0; /**< Operations added to the tape. */
+  size_t variables = 0;  /**< Variables added to the tape. */
+};
+
+/**
+ * @brief Registry of the timed phases of model evaluations.
+ *
+ * @details Timers are off by default. When they are off, a ScopedTimer only
+ * checks one flag, so the instrumented code runs at full speed. When they
+ * are on, the time and number of calls of each phase are summed by module,
+ * object id, value type, and phase, so the double and the AD instances of
+ * the same module are kept apart.
+ *
+ * Phases can be nested, e.g., the "population_dynamics" phase of CatchAtAge
+ * contains the phases of the Calculate families, and the time of a phase
+ * includes the time of the phases nested in it. The phases of one module
+ * therefore do not add up to the time of the module.
+ *
+ * The same phases can count the operations and variables that they add to
+ * the AD tape, which is turned on separately with count_tape because it
+ * only applies while a tape is recorded, e.g., in `TMB::MakeADFun()`. The
+ * counts refer to the most recent tape, so retaping does not inflate them.
+ * Tapes are told apart by a generation number that the objective function
+ * advances with StartTape() before each recording, because TMB may allocate
+ * a new tape at the address of the one that it replaced.
+ */
+class FIMSTimer {
+ public:
+  /**
+   * @brief The module, id, value type, and phase of a timed phase.
+   */
+  typedef std::tuple<std::string, uint32_t, std::string, std::string> Key;
+  /**
+   * @brief If true, phases are timed.
+   */
+  static inline bool enabled = false;
+  /**
+   * @brief The statistics of each timed phase.
+   */
+  static inline std::map<Key, TimerStatistics> statistics;
+  /**
+   * @brief If true, the growth of the AD tape is counted for each phase.
+   */
+  static inline bool count_tape = false;
+  /**
+   * @brief The tape statistics of each phase.
+   */
+  static inline std::map<Key, TapeStatistics> tape_statistics;
+  /**
+   * @brief The generation of the tape that is being recorded.
+   */
+  static inline std::atomic<size_t> tape_generation{0};
+  /**
+   * @brief Guards statistics when phases finish on several threads.
+   */
+  static inline std::mutex mutex;
+
+  /**
+   * @brief Adds calls of a phase.
+   *
+   * @param module The name of the module, e.g., "CatchAtAge".
+   * @param id The id of the object.
+   * @param type The name of the value type, see TypeName().
+   * @param phase The name of the phase.
+   * @param seconds The total wall time of the calls.
+   * @param calls The number of calls.
+   */
+  static void Add(const char *module, uint32_t id, const char *type,
+                  const char *phase, double seconds, size_t calls = 1) {
+    std::lock_guard<std::mutex> lock(FIMSTimer::mutex);
+    TimerStatistics &s = FIMSTimer::statistics[Key(module, id, type, phase)];
+    s.calls += calls;
+    s.seconds += seconds;
+  }
+
+  /**
+   * @brief Starts a new tape generation.
+   *
+   * @details Called before the model is evaluated with an AD type, i.e., at
+   * the start of each tape recording.
+   *
+   * @return The generation of the new tape.
+   */
+  static size_t StartTape() { return ++FIMSTimer::tape_generation; }
+
+  /**
+   * @brief Adds the growth of the tape in calls of a phase.
+   *
+   * @details If the tape generation differs from the one of the previous
+   * call, the counts of the phase start over.
+   *
+   * @param module The name of the module.
+   * @param id The id of the object.
+   * @param type The name of the value type, see TypeName().
+   * @param phase The name of the phase.
+   * @param tape The generation of the tape.
+   * @param operations The number of operations added to the tape.
+   * @param variables The number of variables added to the tape.
+   * @param calls The number of calls.
+   */
+  static void AddTape(const char *module, uint32_t id, const char *type,
+                      const char *phase, size_t tape, size_t operations,
+                      size_t variables, size_t calls = 1) {
+    std::lock_guard<std::mutex> lock(FIMSTimer::mutex);
+    TapeStatistics &s =
+        FIMSTimer::tape_statistics[Key(module, id, type, phase)];
+    if (s.tape != tape) {
+      s = TapeStatistics();
+      s.tape = tape;
+    }
+    s.calls += calls;
+    s.operations += operations;
+    s.variables += variables;
+  }
+
+  /**
+   * @brief Removes all statistics.
+   */
+  static void Clear() {
+    std::lock_guard<std::mutex> lock(FIMSTimer::mutex);
+    FIMSTimer::statistics.clear();
+    FIMSTimer::tape_statistics.clear();
+  }
+
+  /**
+   * @brief The name of a value type, i.e., "double" for the model that is
+   * used for reporting and "ad" for the models that are taped.
+   */
+  template <typename Type>
+  static const char *TypeName() {
+    return std::is_same<Type, double>::value ? "double" : "ad";
+  }
+};
+
+/**
+ * @brief Times the enclosing scope when FIMSTimer::enabled is true and
+ * counts its growth of the AD tape when FIMSTimer::count_tape is true.
+ *
+ * @details The arguments must outlive the timer. String literals are
+ * typical.
+ */
+class ScopedTimer {
+  bool active_m;
+  bool tape_m;
+  const char *module_m;
+  uint32_t id_m;
+  const char *type_m;
+  const char *phase_m;
+  std::chrono::steady_clock::time_point start_m;
+  size_t tape_start_m = 0;
+  size_t operations_start_m = 0;
+  size_t variables_start_m = 0;
+
+ public:
+  /**
+   * @brief Starts the timer.
+   *
+   * @param module The name of the module.
+   * @param id The id of the object.
+   * @param type The name of the value type, see FIMSTimer::TypeName().
+   * @param phase The name of the phase.
+   */
+  ScopedTimer(const char *module, uint32_t id, const char *type,
+              const char *phase)
+      : active_m(FIMSTimer::enabled),
+        tape_m(FIMSTimer::count_tape),
+        module_m(module),
+        id_m(id),
+        type_m(type),
+        phase_m(phase) {
+    if (this->tape_m) {
+      this->tape_start_m = FIMSTimer::tape_generation;
+      this->tape_m =
+          GetTapeSize(this->operations_start_m, this->variables_start_m);
+    }
+    if (this->active_m) {
+      this->start_m = std::chrono::steady_clock::now();
+    }
+  }
+
+  /**
+   * @brief Stops the timer and adds the call to FIMSTimer.
+   */
+  ~ScopedTimer() {
+    if (this->active_m) {
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - this->start_m;
+      FIMSTimer::Add(this->module_m, this->id_m, this->type_m, this->phase_m,
+                     elapsed.count());
+    }
+    size_t operations = 0;
+    size_t variables = 0;
+    if (this->tape_m && GetTapeSize(operations, variables) &&
+        FIMSTimer::tape_generation == this->tape_start_m) {
+      FIMSTimer::AddTape(this->module_m, this->id_m, this->type_m,
+                         this->phase_m, this->tape_start_m,
+                         operations - this->operations_start_m,
+                         variables - this->variables_start_m);
+    }
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+};
+
+/**
+ * @brief Sums the calls of one phase locally and adds them to FIMSTimer
+ * once, when it goes out of scope.
+ *
+ * @details Phases that run for every year and age, e.g., the Calculate
+ * families of CatchAtAge, are too short for a ScopedTimer, which locks the
+ * mutex of FIMSTimer and looks up its key on every call. Instead, one
+ * accumulator is made for each phase outside of the loops and each call is
+ * wrapped in a PhaseAccumulator::Scope, which only reads the clock and, if
+ * counted, the size of the tape. The arguments must outlive the accumulator.
+ */
+class PhaseAccumulator {
+  bool active_m;
+  bool tape_m;
+  const char *module_m;
+  uint32_t id_m;
+  const char *type_m;
+  const char *phase_m;
+  size_t calls_m = 0;
+  double seconds_m = 0.0;
+  size_t last_tape_m = 0;
+  size_t tape_calls_m = 0;
+  size_t operations_m = 0;
+  size_t variables_m = 0;
+
+ public:
+  /**
+   * @brief Starts an empty accumulator.
+   *
+   * @param module The name of the module.
+   * @param id The id of the object.
+   * @param type The name of the value type, see FIMSTimer::TypeName().
+   * @param phase The name of the phase.
+   */
+  PhaseAccumulator(const char *module, uint32_t id, const char *type,
+                   const char *phase)
+      : active_m(FIMSTimer::enabled),
+        tape_m(FIMSTimer::count_tape),
+        module_m(module),
+        id_m(id),
+        type_m(type),
+        phase_m(phase) {}
+
+  /**
+   * @brief Adds the summed calls to FIMSTimer.
+   */
+  ~PhaseAccumulator() {
+    if (this->active_m && this->calls_m > 0) {
+      FIMSTimer::Add(this->module_m, this->id_m, this->type_m, this->phase_m,
+                     this->seconds_m, this->calls_m);
+    }
+    if (this->tape_calls_m > 0) {
+      FIMSTimer::AddTape(this->module_m, this->id_m, this->type_m,
+                         this->phase_m, this->last_tape_m, this->operations_m,
+                         this->variables_m, this->tape_calls_m);
+    }
+  }
+
+  PhaseAccumulator(const PhaseAccumulator &) = delete;
+  PhaseAccumulator &operator=(const PhaseAccumulator &) = delete;
+
+  /**
+   * @brief Times the enclosing scope as one call of the phase of an
+   * accumulator.
+   */
+  class Scope {
+    PhaseAccumulator &accumulator_m;
+    std::chrono::steady_clock::time_point start_m;
+    size_t tape_start_m = 0;
+    size_t operations_start_m = 0;
+    size_t variables_start_m = 0;
+    bool tape_m;
+
+   public:
+    /**
+     * @brief Starts one call.
+     *
+     * @param accumulator The accumulator of the phase.
+     */
+    explicit Scope(PhaseAccumulator &accumulator)
+        : accumulator_m(accumulator), tape_m(accumulator.tape_m) {
+      if (this->tape_m) {
+        this->tape_start_m = FIMSTimer::tape_generation;
+        this->tape_m =
+            GetTapeSize(this->operations_start_m, this->variables_start_m);
+      }
+      if (this->accumulator_m.active_m) {
+        this->start_m = std::chrono::steady_clock::now();
+      }
+    }
+
+    /**
+     * @brief Stops the call and adds it to the accumulator.
+     */
+    ~Scope() {
+      PhaseAccumulator &acc = this->accumulator_m;
+      if (acc.active_m) {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - this->start_m;
+        acc.calls_m++;
+        acc.seconds_m += elapsed.count();
+      }
+      size_t operations = 0;
+      size_t variables = 0;
+      if (this->tape_m && GetTapeSize(operations, variables) &&
+          FIMSTimer::tape_generation == this->tape_start_m) {
+        if (this->tape_start_m != acc.last_tape_m) {
+          acc.last_tape_m = this->tape_start_m;
+          acc.tape_calls_m = 0;
+          acc.operations_m = 0;
+          acc.variables_m = 0;
+        }
+        acc.tape_calls_m++;
+        acc.operations_m += operations - this->operations_start_m;
+        acc.variables_m += variables - this->variables_start_m;
+      }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+};
+
+}  // namespace fims
+
+#endif /* FIMS_COMMON_TIMER_HPP */
@@ -77,10 +77,11 @@ struct DensityComponentBase : public fims_model_object::FIMSObject<Type> {
   /**
    * @brief Retrieve one observed value based on `input_type`.
    * @param i Index into the active observed source, e.g., vector or pointer.
-   * @return Reference to the selected observed value.
+   * @return The selected observed value. Observed data are stored as double
+   * and are promoted to Type here.
    * @throws std::runtime_error If input_type is "prior" and priors is empty.
    */
-  inline Type& get_observed(size_t i) {
+  inline Type get_observed(size_t i) {
     if (this->input_type == "data") {
       return data_observed_values->at(i);
     }
@@ -103,15 +104,38 @@ struct DensityComponentBase : public fims_model_object::FIMSObject<Type> {
    * @brief Retrieve one observed matrix-like value based on `input_type`.
    * @param i Row index.
    * @param j Column index.
-   * @return Reference to the selected observed value.
+   * @return The selected observed value.
    */
-  inline Type& get_observed(size_t i, size_t j) {
+  inline Type get_observed(size_t i, size_t j) {
     if (this->input_type == "data") {
       return data_observed_values->at(i, j);
     }
     return observed_values[i * (j - 1) + j];
   }
 
+  /**
+   * @brief Retrieve the likelihood weight of one observation.
+   * @param i Index into the observed data.
+   * @return The weight of the observation for `data` input and one
+   * otherwise.
+   */
+  inline Type get_weight(size_t i) {
+    if (this->input_type == "data") {
+      return data_observed_values->weight(i);
+    }
+    return static_cast<Type>(1.0);
+  }
+
+  /**
+   * @brief Check if the observations have likelihood weights.
+   * @return True for `data` input with weights, e.g., in a retrospective
+   * peel, in which case the contributions are multiplied by get_weight().
+   */
+  inline bool has_weights() {
+    return this->input_type == "data" &&
+           data_observed_values->has_weights();
+  }
+
   /**
    * @brief Retrieve one expected value based on `input_type` and `use_mean`.
    * @param i Index into the active expected source, e.g., vector or pointer.
@@ -137,7 +161,7 @@ struct DensityComponentBase : public fims_model_object::FIMSObject<Type> {
    */
   inline size_t get_n_x() {
     if (this->input_type == "data") {
-      return this->data_observed_values->data.size();
+      return this->data_observed_values->size();
     }
     if (this->input_type == "random_effects") {
       return (*re).size();
@@ -224,11 +248,39 @@ struct DensityComponentBase : public fims_model_object::FIMSObject<Type> {
   }
 
   virtual ~DensityComponentBase() {}
+
+  /**
+   * @brief Heap bytes owned by the density component.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::HeapBytes(input_type) + fims::HeapBytes(expected_values) +
+           fims::HeapBytes(priors) + fims::HeapBytes(observed_values) +
+           fims::HeapBytes(expected_mean) + fims::HeapBytes(use_mean) +
+           fims::HeapBytes(lpdf_vec) + fims::HeapBytes(key);
+  }
   /**
    * @brief Evaluate the distribution-specific log-likelihood contribution.
    * @return Total log-likelihood contribution for the active inputs.
    */
   virtual const Type evaluate() = 0;
+
+  /**
+   * @brief Draw one replicate of the observed data from the distribution.
+   * @details The expected values of the most recent evaluation are used and
+   * are only read, so replicates can be drawn concurrently with separate
+   * random number generators. Missing observations stay missing.
+   * @param rng Random number generator of the replicate.
+   * @param out Pointer to get_n_x() values in flattened order.
+   * @throws std::invalid_argument If the distribution does not support
+   * simulation of data.
+   */
+  virtual void simulate_replicate(std::mt19937_64& rng, double* out) {
+    throw std::invalid_argument(
+        "DensityComponentBase: replicate data sets cannot be simulated from "
+        "distribution " +
+        std::to_string(this->id) + ".");
+  }
 };
 
 /** @brief Default id of the singleton distribution class
@@ -27,7 +27,8 @@ namespace fims_distributions {
  * density on the original scale.
  *
  * For `data` input, values equal to `na_value` are skipped and contribute zero
- * to the objective. Per-observation contributions are stored in `lpdf_vec`;
+ * to the objective, and each contribution is multiplied by the weight of the
+ * observation. Per-observation contributions are stored in `lpdf_vec`;
  * the summed total is returned by `evaluate()` and stored in `lpdf`.
  */
 template <typename Type>
@@ -36,7 +37,7 @@ struct LogNormalLPDF : public DensityComponentBase<Type> {
    * @brief Natural log of the standard deviation of the distribution on the
    * log scale. The argument can be a vector or scalar, where the latter is
    * referenced for each instance through the use of
-   * \ref fims::Vector::get_force_scalar(size_t) "get_force_scalar()".
+   * \ref fims::Vector::strided_view(size_t) "strided_view()".
    */
   fims::Vector<Type> log_sd;
 
@@ -89,8 +90,11 @@ struct LogNormalLPDF : public DensityComponentBase<Type> {
           std::to_string(this->log_sd.size()));
     }
 
-    for (size_t i = 0; i < n_x; i++) {
 #ifdef TMB_MODEL
+    // log_sd is a scalar or has one value per observation
+    fims::StridedView<Type> log_sd_view = this->log_sd.strided_view(n_x);
+
+    for (size_t i = 0; i < n_x; i++) {
       if (this->input_type == "data") {
         // if data, check if there are any NA values and skip lpdf calculation
         // https://doi.org/10.1016/j.fishres.2015.12.002 for the use of
@@ -98,8 +102,11 @@ struct LogNormalLPDF : public DensityComponentBase<Type> {
         if (this->get_observed(i) != this->data_observed_values->na_value) {
           this->lpdf_vec[i] =
               dnorm(log(this->get_observed(i)), this->get_expected(i),
-                    fims_math::exp(log_sd.get_force_scalar(i)), true) -
+                    fims_math::exp(log_sd_view[i]), true) -
               log(this->get_observed(i));
+          if (this->has_weights()) {
+            this->lpdf_vec[i] *= this->get_weight(i);
+          }
         } else {
           this->lpdf_vec[i] = 0;
         }
@@ -108,11 +115,11 @@ struct LogNormalLPDF : public DensityComponentBase<Type> {
           // if random effects, no lognormal constant needs to be applied
           this->lpdf_vec[i] =
               dnorm(log(this->get_observed(i)), this->get_expected(i),
-                    fims_math::exp(log_sd.get_force_scalar(i)), true);
+                    fims_math::exp(log_sd_view[i]), true);
         } else {
           this->lpdf_vec[i] =
               dnorm(log(this->get_observed(i)), this->get_expected(i),
-                    fims_math::exp(log_sd.get_force_scalar(i)), true) -
+                    fims_math::exp(log_sd_view[i]), true) -
               log(this->get_observed(i));
         }
       }
@@ -122,30 +129,52 @@ struct LogNormalLPDF : public DensityComponentBase<Type> {
         FIMS_SIMULATE_F(this->of) {  // preprocessor definition in interface.hpp
                                      // this simulates data that is mean biased
           if (this->input_type == "data") {
-            this->data_observed_values->at(i) = fims_math::exp(
-                rnorm(this->get_expected(i),
-                      fims_math::exp(log_sd.get_force_scalar(i))));
+            this->data_observed_values->set_simulated(
+                i, fims_math::exp(
+                       rnorm(this->get_expected(i),
+                             fims_math::exp(log_sd_view[i]))));
           }
           if (this->input_type == "random_effects") {
             (*this->re)[i] = fims_math::exp(
                 rnorm(this->get_expected(i),
-                      fims_math::exp(log_sd.get_force_scalar(i))));
+                      fims_math::exp(log_sd_view[i])));
           }
           if (this->input_type == "prior") {
             (*(this->priors[i]))[0] = fims_math::exp(
                 rnorm(this->get_expected(i),
-                      fims_math::exp(log_sd.get_force_scalar(i))));
+                      fims_math::exp(log_sd_view[i])));
           }
         }
       }
-#endif
     }
-#ifdef TMB_MODEL
     vector<Type> lognormal_observed_values = this->observed_values.to_tmb();
     //  FIMS_REPORT_F(lognormal_observed_values, this->of);
 #endif
     return (this->lpdf);
   }
+
+  /**
+   * @brief Draw one replicate of the observed data from the lognormal
+   * distribution, where the expected values are on the log scale.
+   * @param rng Random number generator of the replicate.
+   * @param out Pointer to get_n_x() values in flattened order.
+   */
+  virtual void simulate_replicate(std::mt19937_64& rng, double* out) {
+    size_t n_x = this->get_n_x();
+    fims::StridedView<Type> log_sd_view = this->log_sd.strided_view(n_x);
+    for (size_t i = 0; i < n_x; i++) {
+      double observed = fims_math::to_double(this->get_observed(i));
+      if (observed ==
+          fims_math::to_double(this->data_observed_values->na_value)) {
+        out[i] = observed;
+        continue;
+      }
+      std::lognormal_distribution<double> lognormal(
+          fims_math::to_double(this->get_expected(i)),
+          std::exp(fims_math::to_double(log_sd_view[i])));
+      out[i] = lognormal(rng);
+    }
+  }
 };
 }  // namespace fims_distributions
 #endif
@@ -25,8 +25,9 @@ namespace fims_distributions {
  * passed to `dmultinom(..., give_log = true)`.
  *
  * For `data` input, if any element in a row is equal to `na_value`, the entire
- * row is skipped and contributes zero to the objective. Contributions are
- * stored in `lpdf_vec`. The summed total is returned by `evaluate()` and
+ * row is skipped and contributes zero to the objective. If the data have
+ * likelihood weights, each row is weighted by the weight of its first
+ * element. Contributions are stored in `lpdf_vec`. The summed total is returned by `evaluate()` and
  * stored in `lpdf`.
  *
  * Row observations could be counts of each age for a given time step, where
@@ -141,10 +142,13 @@ struct MultinomialLPMF : public DensityComponentBase<Type> {
       }
 
       if (!containsNA) {
+        Type row_lpmf = dmultinom(observed_values_vector.to_tmb(),
+                                  prob_vector.to_tmb(), true);
+        if (this->has_weights()) {
+          row_lpmf *= this->get_weight(i * dims[1]);
+        }
         std::fill(this->lpdf_vec.begin() + lpdf_vec_idx,
-                  this->lpdf_vec.begin() + lpdf_vec_idx + dims[1],
-                  dmultinom(observed_values_vector.to_tmb(),
-                            prob_vector.to_tmb(), true));
+                  this->lpdf_vec.begin() + lpdf_vec_idx + dims[1], row_lpmf);
 
         this->lpdf += this->lpdf_vec[lpdf_vec_idx];
       } else {
@@ -175,6 +179,57 @@ if (this->simulate_flag)
 #endif
     return (this->lpdf);
   }
+
+  /**
+   * @brief Draw one replicate of the observed data from the multinomial
+   * distribution.
+   * @details The sample size of each row is the rounded sum of the observed
+   * row and the probabilities are the expected values of the row normalized
+   * to sum to one. Rows with a missing value stay missing.
+   * @param rng Random number generator of the replicate.
+   * @param out Pointer to get_n_x() values in flattened order.
+   */
+  virtual void simulate_replicate(std::mt19937_64& rng, double* out) {
+    size_t n_rows = this->data_observed_values->get_imax();
+    size_t n_cols = this->data_observed_values->get_jmax();
+    double na_value =
+        fims_math::to_double(this->data_observed_values->na_value);
+    for (size_t i = 0; i < n_rows; i++) {
+      double* row = out + i * n_cols;
+      double sample_size = 0.0;
+      double total_expected = 0.0;
+      bool containsNA = false;
+      for (size_t j = 0; j < n_cols; j++) {
+        row[j] = fims_math::to_double(this->get_observed(i, j));
+        if (row[j] == na_value) {
+          containsNA = true;
+        }
+        sample_size += row[j];
+        total_expected +=
+            fims_math::to_double(this->get_expected(i * n_cols + j));
+      }
+      if (containsNA) {
+        continue;
+      }
+      // draw the counts as a sequence of conditional binomials
+      long long remaining = std::llround(sample_size);
+      double remaining_probability = 1.0;
+      for (size_t j = 0; j < n_cols; j++) {
+        double p = fims_math::to_double(this->get_expected(i * n_cols + j)) /
+                   total_expected;
+        long long count = remaining;
+        if (j + 1 < n_cols && remaining > 0 && remaining_probability > p) {
+          std::binomial_distribution<long long> binomial(
+              remaining,
+              std::max(0.0, std::min(1.0, p / remaining_probability)));
+          count = binomial(rng);
+        }
+        row[j] = static_cast<double>(count);
+        remaining -= count;
+        remaining_probability -= p;
+      }
+    }
+  }
 };
 }  // namespace fims_distributions
 #endif
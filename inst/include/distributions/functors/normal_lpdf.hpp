@@ -25,7 +25,8 @@ namespace fims_distributions {
  * obtain log-density values.
  *
  * For `data` input, values equal to `na_value` are skipped and contribute zero
- * to the objective. Per-observation contributions are stored in `lpdf_vec`;
+ * to the objective, and each contribution is multiplied by the weight of the
+ * observation. Per-observation contributions are stored in `lpdf_vec`;
  * the summed total is returned by `evaluate()` and stored in `lpdf`.
  */
 template <typename Type>
@@ -34,7 +35,7 @@ struct NormalLPDF : public DensityComponentBase<Type> {
    * @brief The natural log of the standard deviation of the distribution. The
    * argument can be a vector or scalar, where the latter is referenced for
    * each instance through the use of
-   * \ref fims::Vector::get_force_scalar(size_t) "get_force_scalar()".
+   * \ref fims::Vector::strided_view(size_t) "strided_view()".
    */
   fims::Vector<Type> log_sd;
 
@@ -85,15 +86,21 @@ struct NormalLPDF : public DensityComponentBase<Type> {
           fims::to_string(this->log_sd.size()));
     }
 
-    for (size_t i = 0; i < n_x; i++) {
 #ifdef TMB_MODEL
+    // log_sd is a scalar or has one value per observation
+    fims::StridedView<Type> log_sd_view = this->log_sd.strided_view(n_x);
+
+    for (size_t i = 0; i < n_x; i++) {
       if (this->input_type == "data") {
         // if data, check if there are any NA values and skip lpdf calculation
         // if there are
         if (this->get_observed(i) != this->data_observed_values->na_value) {
           this->lpdf_vec[i] =
               dnorm(this->get_observed(i), this->get_expected(i),
-                    fims_math::exp(log_sd.get_force_scalar(i)), true);
+                    fims_math::exp(log_sd_view[i]), true);
+          if (this->has_weights()) {
+            this->lpdf_vec[i] *= this->get_weight(i);
+          }
         } else {
           this->lpdf_vec[i] = 0;
         }
@@ -102,28 +109,27 @@ struct NormalLPDF : public DensityComponentBase<Type> {
       } else {
         this->lpdf_vec[i] =
             dnorm(this->get_observed(i), this->get_expected(i),
-                  fims_math::exp(log_sd.get_force_scalar(i)), true);
+                  fims_math::exp(log_sd_view[i]), true);
       }
       this->lpdf += this->lpdf_vec[i];
       if (this->simulate_flag) {
         FIMS_SIMULATE_F(this->of) {
           if (this->input_type == "data") {
-            this->data_observed_values->at(i) =
-                rnorm(this->get_expected(i),
-                      fims_math::exp(log_sd.get_force_scalar(i)));
+            this->data_observed_values->set_simulated(
+                i, rnorm(this->get_expected(i),
+                         fims_math::exp(log_sd_view[i])));
           }
           if (this->input_type == "random_effects") {
             (*this->re)[i] = rnorm(this->get_expected(i),
-                                   fims_math::exp(log_sd.get_force_scalar(i)));
+                                   fims_math::exp(log_sd_view[i]));
           }
           if (this->input_type == "prior") {
             (*(this->priors[i]))[0] =
                 rnorm(this->get_expected(i),
-                      fims_math::exp(log_sd.get_force_scalar(i)));
+                      fims_math::exp(log_sd_view[i]));
           }
         }
       }
-#endif
       /* osa not working yet
         if(osa_flag){//data observation type implements osa residuals
             //code for osa cdf method
@@ -133,11 +139,33 @@ struct NormalLPDF : public DensityComponentBase<Type> {
         pnorm(this->observed_values[i], this->get_expected(i), sd[i]) );
         } */
     }
-#ifdef TMB_MODEL
     vector<Type> normal_observed_values = this->observed_values.to_tmb();
 #endif
     return (this->lpdf);
   }
+
+  /**
+   * @brief Draw one replicate of the observed data from the normal
+   * distribution.
+   * @param rng Random number generator of the replicate.
+   * @param out Pointer to get_n_x() values in flattened order.
+   */
+  virtual void simulate_replicate(std::mt19937_64& rng, double* out) {
+    size_t n_x = this->get_n_x();
+    fims::StridedView<Type> log_sd_view = this->log_sd.strided_view(n_x);
+    for (size_t i = 0; i < n_x; i++) {
+      double observed = fims_math::to_double(this->get_observed(i));
+      if (observed ==
+          fims_math::to_double(this->data_observed_values->na_value)) {
+        out[i] = observed;
+        continue;
+      }
+      std::normal_distribution<double> normal(
+          fims_math::to_double(this->get_expected(i)),
+          std::exp(fims_math::to_double(log_sd_view[i])));
+      out[i] = normal(rng);
+    }
+  }
 };
 
 }  // namespace fims_distributions
@@ -14,6 +14,8 @@
  * to interface with multiple modeling platforms.
  */
 
+#include <cstddef>
+
 // traits for interfacing with TMB
 
 #ifdef TMB_MODEL
@@ -41,6 +43,8 @@
 
 #define ADREPORT_F(name, F) F->reportvector.push(name, #name);
 
+#define ADREPORT_F_(name, obj, F) F->reportvector.push(obj, name);
+
 template <typename Type>
 vector<Type> ADREPORTvector(vector<vector<Type> > x) {
   int outer_dim = x.size();
@@ -64,6 +68,30 @@ vector<Type> ADREPORTvector(vector<vector<Type> > x) {
 
 #endif /* TMB_MODEL */
 
+namespace fims {
+
+/**
+ * @brief Gets the size of the AD tape that is being recorded.
+ *
+ * @param operations The number of operations on the tape.
+ * @param variables The number of variables on the tape.
+ * @return true if a tape is being recorded and false otherwise, e.g., when
+ * the double model is evaluated.
+ */
+inline bool GetTapeSize(size_t &operations, size_t &variables) {
+#ifdef TMB_MODEL
+  TMBad::global *glob = TMBad::get_glob();
+  if (glob != NULL) {
+    operations = glob->opstack.size();
+    variables = glob->values.size();
+    return true;
+  }
+#endif
+  return false;
+}
+
+}  // namespace fims
+
 #ifndef TMB_MODEL
 /**
  * @brief TMB macro that simulates data.
@@ -77,6 +105,10 @@ vector<Type> ADREPORTvector(vector<vector<Type> > x) {
  * @brief TMB macro that reports variables and uncertainties.
  */
 #define ADREPORT_F(name, F)
+/**
+ * @brief TMB macro that reports variables and uncertainties by name.
+ */
+#define ADREPORT_F_(name, obj, F)
 #endif
 
 #endif /* FIMS_INTERFACE_HPP */
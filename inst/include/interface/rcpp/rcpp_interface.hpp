@@ -34,6 +34,34 @@ void init_logging() {
   std::signal(SIGTERM, &fims::WriteAtExit);
 }
 
+/**
+ * @brief Gets the total heap bytes owned by the objects of an Information
+ * instance.
+ *
+ * @tparam Type
+ */
+template <typename Type>
+size_t memory_bytes_internal() {
+  std::shared_ptr<fims_info::Information<Type>> info =
+      fims_info::Information<Type>::GetInstance();
+  size_t bytes = 0;
+  for (const auto &kv : info->GetMemoryUsage()) {
+    bytes += kv.second.bytes;
+  }
+  return bytes;
+}
+
+/**
+ * @brief Records the current heap bytes of FIMS objects as the peak if they
+ * exceed it.
+ */
+void update_memory_peak() {
+  fims_model_object::FIMSMemoryTracker::UpdatePeakBytes(
+      memory_bytes_internal<TMB_FIMS_REAL_TYPE>() +
+      memory_bytes_internal<TMBAD_FIMS_TYPE>() +
+      fims::FIMSLog::fims_log->get_memory_bytes());
+}
+
 /**
  * @brief Initialize and construct the FIMS model using TMB.
  *
@@ -100,6 +128,8 @@ bool CreateTMBModel() {
   std::shared_ptr<fims_model::Model<TMB_FIMS_REAL_TYPE>> m0 =
       fims_model::Model<TMB_FIMS_REAL_TYPE>::GetInstance();
 
+  update_memory_peak();
+
   return true;
 }
 
@@ -109,7 +139,9 @@ bool CreateTMBModel() {
   TMB_FIMS_REAL_TYPE. It is typically called before finalize() or
   @ref CatchAtAgeInterface::to_json "`get_output()`" to ensure the correct
   values are used because TMB doesn't always keep the updated parameters in
-  the "double" version of the tape. So we need to update those first.
+  the "double" version of the tape. So we need to update those first. An
+  error is thrown if the length of `par` differs from the number of
+  registered parameters.
   \n\n
   Usage example in R:
   \code{.R}
@@ -136,9 +168,12 @@ void set_fixed_parameters(Rcpp::NumericVector par) {
   std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
       fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
 
-  for (size_t i = 0; i < info0->fixed_effects_parameters.size(); i++) {
-    *info0->fixed_effects_parameters[i] = par[i];
+  size_t n = info0->fixed_effects_parameters.size();
+  if (static_cast<size_t>(par.size()) != n) {
+    Rcpp::stop("set_fixed: expected " + fims::to_string(n) +
+               " values but received " + fims::to_string(par.size()) + ".");
   }
+  info0->SetFixedEffects(par.begin());
 }
 
 /**
@@ -151,11 +186,8 @@ Rcpp::NumericVector get_fixed_parameters_vector() {
   std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
       fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
 
-  Rcpp::NumericVector p;
-
-  for (size_t i = 0; i < info0->fixed_effects_parameters.size(); i++) {
-    p.push_back(*info0->fixed_effects_parameters[i]);
-  }
+  Rcpp::NumericVector p(info0->fixed_effects_parameters.size());
+  info0->GetFixedEffects(p.begin());
 
   return p;
 }
@@ -171,9 +203,12 @@ void set_random_parameters(Rcpp::NumericVector par) {
   std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
       fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
 
-  for (size_t i = 0; i < info0->random_effects_parameters.size(); i++) {
-    *info0->random_effects_parameters[i] = par[i];
+  size_t n = info0->random_effects_parameters.size();
+  if (static_cast<size_t>(par.size()) != n) {
+    Rcpp::stop("set_random: expected " + fims::to_string(n) +
+               " values but received " + fims::to_string(par.size()) + ".");
   }
+  info0->SetRandomEffects(par.begin());
 }
 
 /**
@@ -186,15 +221,264 @@ Rcpp::NumericVector get_random_parameters_vector() {
   std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> d0 =
       fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
 
-  Rcpp::NumericVector p;
+  Rcpp::NumericVector p(d0->random_effects_parameters.size());
+  d0->GetRandomEffects(p.begin());
+
+  return p;
+}
+
+/* Dictionary block for shared documentation.
+  [details_x_parameter_block]
+  A block is one parameter vector of one module and it is addressed by the
+  registered parameter name without the trailing variable id, i.e.,
+  "<module>.<module id>.<parameter>" such as "Fleet.2.log_Fmort" or
+  "Population.1.log_M". The elements of a block are registered consecutively,
+  so the block is copied through the contiguous runs of parameter storage
+  that it overlaps, see fims_info::Information::SetFixedEffectsRange(),
+  rather than by matching each element by name in R.
+  [details_x_parameter_block]
+*/
+/* Dictionary block for shared documentation.
+  [param_block_name]
+  @param block_name The name of the parameter block, e.g.,
+  "Fleet.2.log_Fmort".
+  [param_block_name]
+ */
+
+/**
+ * @brief Gets the values of one block of fixed effect parameters.
+ * @details @snippet{doc} this details_x_parameter_block
+ * @snippet{doc} this param_block_name
+ * @return Rcpp::NumericVector
+ */
+Rcpp::NumericVector get_fixed_parameters_block(std::string block_name) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::pair<size_t, size_t> range =
+      info0->GetParameterBlockRange(info0->parameter_names, block_name);
+  Rcpp::NumericVector p(range.second);
+  info0->GetFixedEffectsRange(range.first, range.second, p.begin());
+  return p;
+}
 
-  for (size_t i = 0; i < d0->random_effects_parameters.size(); i++) {
-    p.push_back(*d0->random_effects_parameters[i]);
+/**
+ * @brief Updates the values of one block of fixed effect parameters.
+ * @details @snippet{doc} this details_x_parameter_block
+ * @snippet{doc} this param_block_name
+ * @snippet{doc} this param_par
+ */
+void set_fixed_parameters_block(std::string block_name,
+                                Rcpp::NumericVector par) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::pair<size_t, size_t> range =
+      info0->GetParameterBlockRange(info0->parameter_names, block_name);
+  if (static_cast<size_t>(par.size()) != range.second) {
+    Rcpp::stop("set_fixed_block: block " + block_name + " has " +
+               fims::to_string(range.second) + " values but received " +
+               fims::to_string(par.size()) + ".");
   }
+  info0->SetFixedEffectsRange(range.first, range.second, par.begin());
+}
 
+/**
+ * @brief Gets the values of one block of random effect parameters.
+ * @details @snippet{doc} this details_x_parameter_block
+ * @snippet{doc} this param_block_name
+ * @return Rcpp::NumericVector
+ */
+Rcpp::NumericVector get_random_parameters_block(std::string block_name) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::pair<size_t, size_t> range =
+      info0->GetParameterBlockRange(info0->random_effects_names, block_name);
+  Rcpp::NumericVector p(range.second);
+  info0->GetRandomEffectsRange(range.first, range.second, p.begin());
   return p;
 }
 
+/**
+ * @brief Updates the values of one block of random effect parameters.
+ * @details @snippet{doc} this details_x_parameter_block
+ * @snippet{doc} this param_block_name
+ * @snippet{doc} this param_par
+ */
+void set_random_parameters_block(std::string block_name,
+                                 Rcpp::NumericVector par) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::pair<size_t, size_t> range =
+      info0->GetParameterBlockRange(info0->random_effects_names, block_name);
+  if (static_cast<size_t>(par.size()) != range.second) {
+    Rcpp::stop("set_random_block: block " + block_name + " has " +
+               fims::to_string(range.second) + " values but received " +
+               fims::to_string(par.size()) + ".");
+  }
+  info0->SetRandomEffectsRange(range.first, range.second, par.begin());
+}
+
+/**
+ * @brief Gets the observations of all data objects.
+ *
+ * @details The observations are ordered by data object id and, within a data
+ * object, in flattened order. Passing this vector as `obs` in the data list of
+ * `TMB::MakeADFun()` makes the observations an updatable data input of the
+ * tape, see set_observed_data_block().
+ *
+ * @return Rcpp::NumericVector
+ */
+Rcpp::NumericVector get_observed_data() {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  Rcpp::NumericVector obs(info0->GetNumberOfObservations());
+  double* values = obs.begin();
+  for (typename fims_info::Information<TMB_FIMS_REAL_TYPE>::data_iterator it =
+           info0->data_objects.begin();
+       it != info0->data_objects.end(); ++it) {
+    fims::Vector<double>& data = *(*it).second->data;
+    values = std::copy(data.begin(), data.end(), values);
+  }
+  return obs;
+}
+
+/**
+ * @brief Replaces the observations of one data object.
+ *
+ * @details The double and the AD models share the storage of the
+ * observations, so both models see the new values. A tape that was built
+ * with `obs` in its data list still has to be given the new values through
+ * `obj$env$data$obs`, which is what `update_fims_data()` does in R. Missing
+ * values (-999) are skipped when the model is taped, so the new values must
+ * be missing exactly where the current observations are.
+ *
+ * @param id The id of the data object, e.g., `landings$get_id()`.
+ * @param values The new observations in flattened order.
+ */
+void set_observed_data_block(uint32_t id, Rcpp::NumericVector values) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  typename fims_info::Information<TMB_FIMS_REAL_TYPE>::data_iterator it =
+      info0->data_objects.find(id);
+  if (it == info0->data_objects.end()) {
+    Rcpp::stop("set_observed_data_block: data object " + fims::to_string(id) +
+               " was not found.");
+  }
+  std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>> data =
+      (*it).second;
+  if (static_cast<size_t>(values.size()) != data->size()) {
+    Rcpp::stop("set_observed_data_block: data object " + fims::to_string(id) +
+               " has " + fims::to_string(data->size()) +
+               " values but received " + fims::to_string(values.size()) +
+               ".");
+  }
+  try {
+    data->replace_observations(values.begin());
+  } catch (const std::exception& e) {
+    Rcpp::stop("set_observed_data_block: " + std::string(e.what()));
+  }
+}
+
+/**
+ * @brief Gets the observation weights of a retrospective peel.
+ *
+ * @details The weights are ordered as in get_observed_data() and are zero for
+ * observations in the terminal `n_years` years of every data object except
+ * landings. Passing them to the tape as `obs_weights` refits the same model
+ * without those observations, see `run_fims_retrospective()`.
+ *
+ * @param n_years The number of terminal years to remove.
+ * @return Rcpp::NumericVector
+ */
+Rcpp::NumericVector get_retrospective_weights(size_t n_years) {
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::vector<double> weights = info0->GetRetrospectiveWeights(n_years);
+  return Rcpp::NumericVector(weights.begin(), weights.end());
+}
+
+/**
+ * @brief Simulates replicate data sets from the data likelihoods.
+ *
+ * @details The expected values of the most recent evaluation of the model
+ * are used, so the model has to be evaluated first, e.g., with
+ * `obj$report(par)`. The replicates are simulated on `n_threads` threads and
+ * each replicate has its own random number generator seeded with `seed` and
+ * its index, so the results do not depend on the number of threads.
+ *
+ * @param n_replicates The number of data sets to simulate.
+ * @param seed The seed of the random number generators.
+ * @param n_threads The number of threads, where zero uses the number of
+ * hardware threads.
+ * @return Rcpp::List A list named by the id of each data object with a
+ * likelihood. Each element is an array with the dimensions of the data
+ * object, e.g., years by ages for age compositions, and the replicates in
+ * the last dimension.
+ */
+Rcpp::List simulate_data(size_t n_replicates, double seed, size_t n_threads) {
+  std::shared_ptr<fims_model::Model<TMB_FIMS_REAL_TYPE>> m0 =
+      fims_model::Model<TMB_FIMS_REAL_TYPE>::GetInstance();
+  std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+
+  std::map<uint32_t, std::vector<double>> simulated;
+  try {
+    simulated = m0->SimulateData(n_replicates, static_cast<uint64_t>(seed),
+                                 n_threads);
+  } catch (const std::exception& e) {
+    Rcpp::stop(e.what());
+  }
+
+  Rcpp::List out;
+  std::map<uint32_t, std::vector<double>>::iterator it;
+  for (it = simulated.begin(); it != simulated.end(); ++it) {
+    typename fims_info::Information<TMB_FIMS_REAL_TYPE>::data_iterator d_it =
+        info0->data_objects.find((*it).first);
+    if (d_it == info0->data_objects.end()) {
+      continue;
+    }
+    fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>& data = *(*d_it).second;
+    size_t dims[4] = {data.get_imax(), data.get_jmax(), data.get_kmax(),
+                      data.get_lmax()};
+    size_t n_dims = data.get_dimensions();
+    size_t size = data.size();
+
+    // data objects are stored in row-major order and R arrays are
+    // column-major
+    Rcpp::NumericVector values(size * n_replicates);
+    for (size_t r = 0; r < n_replicates; r++) {
+      const double* replicate = (*it).second.data() + r * size;
+      for (size_t i = 0; i < size; i++) {
+        size_t remainder = i;
+        size_t index = 0;
+        size_t stride = 1;
+        size_t divisor = size;
+        for (size_t d = 0; d < n_dims; d++) {
+          divisor /= dims[d];
+          index += (remainder / divisor) * stride;
+          remainder %= divisor;
+          stride *= dims[d];
+        }
+        values[r * size + index] = replicate[i];
+      }
+    }
+    Rcpp::IntegerVector dim(n_dims + 1);
+    for (size_t d = 0; d < n_dims; d++) {
+      dim[d] = static_cast<int>(dims[d]);
+    }
+    dim[n_dims] = static_cast<int>(n_replicates);
+    values.attr("dim") = dim;
+    out[fims::to_string((*it).first)] = values;
+  }
+  return out;
+}
+
 /**
  * @brief Gets the parameter names object.
  *
@@ -246,6 +530,8 @@ void clear_internal() {
  * test_clear_with_leak_check().
  */
 void clear_impl(bool get_error_msg) {
+  update_memory_peak();
+
   // rcpp_interface_base.hpp
   FIMSRcppInterfaceBase::fims_interface_objects.clear();
 
@@ -333,6 +619,7 @@ void clear_impl(bool get_error_msg) {
   clear_internal<TMBAD_FIMS_TYPE>();
 
   fims::FIMSLog::fims_log->clear();
+  fims::FIMSTimer::Clear();
 
   std::unique_ptr<fims_popdy::LogisticSelectivity<double>> test_obj;
   if (get_error_msg) {
@@ -408,6 +695,166 @@ void set_log_throw_on_error(bool throw_on_error) {
   fims::FIMSLog::fims_log->throw_on_error = throw_on_error;
 }
 
+/**
+ * @brief Turns the timers of the phases of model evaluations on or off.
+ *
+ * @details When on, the wall time and number of calls are recorded for the
+ * phases of `Model::Evaluate()`, e.g., each density component, and of
+ * `CatchAtAge::Evaluate()`, e.g., `Prepare()`, the population dynamics, the
+ * expected composition data, and `Report()`. The phases that run for every
+ * year and age, e.g., `CalculateNumbers`, are summed within an evaluation and
+ * recorded once per evaluation. The time of a phase includes the phases
+ * nested in it, e.g., `population_dynamics` includes the phases of the years
+ * and ages. When off, which is the default, the overhead is one check of a
+ * flag per phase.
+ */
+void set_timers(bool enabled) { fims::FIMSTimer::enabled = enabled; }
+
+/**
+ * @brief Removes all timer and tape statistics.
+ */
+void clear_timers() { fims::FIMSTimer::Clear(); }
+
+/**
+ * @brief Gets the timer statistics.
+ *
+ * @return Rcpp::DataFrame One row per module, id, value type, and phase with
+ * the number of calls and the total and mean time in seconds. The value type
+ * is "double" for the model used for reporting and "ad" for the taped models.
+ */
+Rcpp::DataFrame get_timers() {
+  std::lock_guard<std::mutex> lock(fims::FIMSTimer::mutex);
+  size_t n = fims::FIMSTimer::statistics.size();
+  Rcpp::CharacterVector module(n);
+  Rcpp::IntegerVector id(n);
+  Rcpp::CharacterVector type(n);
+  Rcpp::CharacterVector phase(n);
+  Rcpp::NumericVector calls(n);
+  Rcpp::NumericVector seconds(n);
+  Rcpp::NumericVector mean_seconds(n);
+  size_t i = 0;
+  for (const auto &kv : fims::FIMSTimer::statistics) {
+    module[i] = std::get<0>(kv.first);
+    id[i] = static_cast<int>(std::get<1>(kv.first));
+    type[i] = std::get<2>(kv.first);
+    phase[i] = std::get<3>(kv.first);
+    calls[i] = static_cast<double>(kv.second.calls);
+    seconds[i] = kv.second.seconds;
+    mean_seconds[i] = kv.second.seconds / kv.second.calls;
+    i++;
+  }
+  return Rcpp::DataFrame::create(
+      Rcpp::Named("module") = module, Rcpp::Named("id") = id,
+      Rcpp::Named("type") = type, Rcpp::Named("phase") = phase,
+      Rcpp::Named("calls") = calls, Rcpp::Named("seconds") = seconds,
+      Rcpp::Named("mean_seconds") = mean_seconds,
+      Rcpp::Named("stringsAsFactors") = false);
+}
+
+/**
+ * @brief Turns the counting of AD tape operations and variables on or off.
+ *
+ * @details When on, each timed phase, see set_timers(), also counts the
+ * operations and variables that it adds to the AD tape. Tapes are recorded
+ * by `TMB::MakeADFun()`, so the counting has to be turned on before the TMB
+ * object is made. Phases of the Calculate families of `CatchAtAge` are
+ * summed over years and ages.
+ */
+void set_tape_counters(bool enabled) {
+  fims::FIMSTimer::count_tape = enabled;
+}
+
+/**
+ * @brief Gets the number of AD tape operations and variables by phase.
+ *
+ * @return Rcpp::DataFrame One row per module, id, and phase with the number
+ * of calls and the operations and variables added to the most recent tape.
+ */
+Rcpp::DataFrame get_tape_counters() {
+  std::lock_guard<std::mutex> lock(fims::FIMSTimer::mutex);
+  size_t n = fims::FIMSTimer::tape_statistics.size();
+  Rcpp::CharacterVector module(n);
+  Rcpp::IntegerVector id(n);
+  Rcpp::CharacterVector phase(n);
+  Rcpp::NumericVector calls(n);
+  Rcpp::NumericVector operations(n);
+  Rcpp::NumericVector variables(n);
+  size_t i = 0;
+  for (const auto &kv : fims::FIMSTimer::tape_statistics) {
+    module[i] = std::get<0>(kv.first);
+    id[i] = static_cast<int>(std::get<1>(kv.first));
+    phase[i] = std::get<3>(kv.first);
+    calls[i] = static_cast<double>(kv.second.calls);
+    operations[i] = static_cast<double>(kv.second.operations);
+    variables[i] = static_cast<double>(kv.second.variables);
+    i++;
+  }
+  return Rcpp::DataFrame::create(
+      Rcpp::Named("module") = module, Rcpp::Named("id") = id,
+      Rcpp::Named("phase") = phase, Rcpp::Named("calls") = calls,
+      Rcpp::Named("operations") = operations,
+      Rcpp::Named("variables") = variables,
+      Rcpp::Named("stringsAsFactors") = false);
+}
+
+/**
+ * @brief Gets the heap memory owned by FIMS objects.
+ *
+ * @details Bytes are counted from the sizes and capacities of the vectors,
+ * maps, and strings that each object owns, so they are an estimate of the
+ * memory held by the model and not of allocator overhead. Data that are
+ * shared between the double and AD models are split between them. The AD
+ * tape is owned by the TMB object in R and is not included. The peak is the
+ * largest total seen by `CreateTMBModel()`, `clear()`, or this function and
+ * is kept across calls to `clear()`.
+ *
+ * @return Rcpp::List A list with `usage`, a data frame with one row per
+ * Information instance ("double" or "ad") and module type with the number
+ * of objects and bytes plus a row for the log, `total_bytes`, and
+ * `peak_bytes`.
+ */
+Rcpp::List get_memory_report() {
+  std::vector<std::string> information_names;
+  std::vector<std::string> module_names;
+  std::vector<double> objects_values;
+  std::vector<double> bytes_values;
+  std::map<std::string, fims_model_object::MemoryUsage> usage[2] = {
+      fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance()
+          ->GetMemoryUsage(),
+      fims_info::Information<TMBAD_FIMS_TYPE>::GetInstance()
+          ->GetMemoryUsage()};
+  const char *names[2] = {"double", "ad"};
+  size_t total = 0;
+  for (size_t i = 0; i < 2; i++) {
+    for (const auto &kv : usage[i]) {
+      information_names.push_back(names[i]);
+      module_names.push_back(kv.first);
+      objects_values.push_back(static_cast<double>(kv.second.objects));
+      bytes_values.push_back(static_cast<double>(kv.second.bytes));
+      total += kv.second.bytes;
+    }
+  }
+  size_t log_bytes = fims::FIMSLog::fims_log->get_memory_bytes();
+  information_names.push_back("none");
+  module_names.push_back("log");
+  objects_values.push_back(1.0);
+  bytes_values.push_back(static_cast<double>(log_bytes));
+  total += log_bytes;
+  fims_model_object::FIMSMemoryTracker::UpdatePeakBytes(total);
+
+  Rcpp::DataFrame df = Rcpp::DataFrame::create(
+      Rcpp::Named("information") = Rcpp::wrap(information_names),
+      Rcpp::Named("module") = Rcpp::wrap(module_names),
+      Rcpp::Named("objects") = Rcpp::wrap(objects_values),
+      Rcpp::Named("bytes") = Rcpp::wrap(bytes_values),
+      Rcpp::Named("stringsAsFactors") = false);
+  return Rcpp::List::create(
+      Rcpp::Named("usage") = df,
+      Rcpp::Named("total_bytes") = static_cast<double>(total),
+      Rcpp::Named("peak_bytes") = static_cast<double>(
+          fims_model_object::FIMSMemoryTracker::peak_bytes));
+}
+
 /**
  * @brief Adds an info entry to the log from the R environment.
  */
@@ -76,6 +76,34 @@ class DataInterfaceBase : public FIMSRcppInterfaceBase {
    * @brief Adds the parameters to the TMB model.
    */
   virtual bool add_to_fims_tmb() { return true; };
+
+#ifdef TMB_MODEL
+  /**
+   * @brief Adds a filled data object to both fims_info::Information
+   * instances. The double data object owns the observations and the AD data
+   * object shares its storage, so the data are held in memory only once.
+   *
+   * @param observed The double data object holding the observations.
+   * @return A boolean of true.
+   */
+  bool add_data_object_to_fims_tmb(
+      std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>
+          observed) {
+    observed->id = this->id;
+    std::shared_ptr<fims_info::Information<TMB_FIMS_REAL_TYPE>> info0 =
+        fims_info::Information<TMB_FIMS_REAL_TYPE>::GetInstance();
+    info0->data_objects[this->id] = observed;
+
+    std::shared_ptr<fims_data_object::DataObject<TMBAD_FIMS_TYPE>> shared =
+        std::make_shared<fims_data_object::DataObject<TMBAD_FIMS_TYPE>>(
+            *observed);
+    shared->id = this->id;
+    std::shared_ptr<fims_info::Information<TMBAD_FIMS_TYPE>> info =
+        fims_info::Information<TMBAD_FIMS_TYPE>::GetInstance();
+    info->data_objects[this->id] = shared;
+    return true;
+  }
+#endif
 };
 
 /**
@@ -174,38 +202,25 @@ class AgeCompDataInterface : public DataInterfaceBase {
 
 #ifdef TMB_MODEL
 
-  template <typename Type>
-  bool add_to_fims_tmb_internal() {
-    std::shared_ptr<fims_data_object::DataObject<Type>> age_comp_data =
-        std::make_shared<fims_data_object::DataObject<Type>>(this->ymax,
-                                                             this->amax);
-
-    age_comp_data->id = this->id;
-    for (int y = 0; y < ymax; y++) {
-      for (int a = 0; a < amax; a++) {
-        int i_age_year = y * amax + a;
-        age_comp_data->at(y, a) = this->age_comp_data[i_age_year];
-        age_comp_data->uncertainty[i_age_year] = this->uncertainty[i_age_year];
-      }
-    }
-
-    std::shared_ptr<fims_info::Information<Type>> info =
-        fims_info::Information<Type>::GetInstance();
-
-    info->data_objects[this->id] = age_comp_data;
-
-    return true;
-  }
-
   /**
    * @brief Adds the parameters to the TMB model.
    * @return A boolean of true.
    */
   virtual bool add_to_fims_tmb() {
-    this->add_to_fims_tmb_internal<TMB_FIMS_REAL_TYPE>();
-    this->add_to_fims_tmb_internal<TMBAD_FIMS_TYPE>();
+    std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>
+        age_comp_data = std::make_shared<
+            fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>(this->ymax,
+                                                              this->amax);
+    for (int y = 0; y < ymax; y++) {
+      for (int a = 0; a < amax; a++) {
+        int i_age_year = y * amax + a;
+        age_comp_data->set(i_age_year, this->age_comp_data[i_age_year]);
+        (*age_comp_data->uncertainty)[i_age_year] =
+            this->uncertainty[i_age_year];
+      }
+    }
 
-    return true;
+    return this->add_data_object_to_fims_tmb(age_comp_data);
   }
 
 #endif
@@ -306,36 +321,28 @@ class LengthCompDataInterface : public DataInterfaceBase {
   }
 
 #ifdef TMB_MODEL
-  template <typename Type>
-  bool add_to_fims_tmb_internal() {
-    std::shared_ptr<fims_data_object::DataObject<Type>> length_comp_data =
-        std::make_shared<fims_data_object::DataObject<Type>>(this->ymax,
-                                                             this->lmax);
-    length_comp_data->id = this->id;
+  /**
+   * @brief Adds the parameters to the TMB model.
+   * @return A boolean of true.
+   */
+  virtual bool add_to_fims_tmb() {
+    std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>
+        length_comp_data = std::make_shared<
+            fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>(this->ymax,
+                                                              this->lmax);
     for (int y = 0; y < ymax; y++) {
       for (int l = 0; l < lmax; l++) {
         int i_length_year = y * lmax + l;
-        length_comp_data->at(y, l) = this->length_comp_data[i_length_year];
-        length_comp_data->uncertainty[i_length_year] =
+        length_comp_data->set(i_length_year,
+                              this->length_comp_data[i_length_year]);
+        (*length_comp_data->uncertainty)[i_length_year] =
             this->uncertainty[i_length_year];
       }
     }
-    std::shared_ptr<fims_info::Information<Type>> info =
-        fims_info::Information<Type>::GetInstance();
-    info->data_objects[this->id] = length_comp_data;
-    return true;
-  }
 
-  /**
-   * @brief Adds the parameters to the TMB model.
-   * @return A boolean of true.
-   */
-  virtual bool add_to_fims_tmb() {
-    this->add_to_fims_tmb_internal<TMB_FIMS_REAL_TYPE>();
-    this->add_to_fims_tmb_internal<TMBAD_FIMS_TYPE>();
-
-    return true;
+    return this->add_data_object_to_fims_tmb(length_comp_data);
   }
+
 #endif
 };
 
@@ -427,34 +434,21 @@ class IndexDataInterface : public DataInterfaceBase {
 
 #ifdef TMB_MODEL
 
-  template <typename Type>
-  bool add_to_fims_tmb_internal() {
-    std::shared_ptr<fims_data_object::DataObject<Type>> data =
-        std::make_shared<fims_data_object::DataObject<Type>>(this->ymax);
-
-    data->id = this->id;
-
-    for (int y = 0; y < ymax; y++) {
-      data->at(y) = this->index_data[y];
-      data->uncertainty[y] = this->uncertainty[y];
-    }
-
-    std::shared_ptr<fims_info::Information<Type>> info =
-        fims_info::Information<Type>::GetInstance();
-
-    info->data_objects[this->id] = data;
-    return true;
-  }
-
   /**
    * @brief Adds the parameters to the TMB model.
    * @return A boolean of true.
    */
   virtual bool add_to_fims_tmb() {
-    this->add_to_fims_tmb_internal<TMB_FIMS_REAL_TYPE>();
-    this->add_to_fims_tmb_internal<TMBAD_FIMS_TYPE>();
+    std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>> data =
+        std::make_shared<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>(
+            this->ymax);
 
-    return true;
+    for (int y = 0; y < ymax; y++) {
+      data->set(y, this->index_data[y]);
+      (*data->uncertainty)[y] = this->uncertainty[y];
+    }
+
+    return this->add_data_object_to_fims_tmb(data);
   }
 
 #endif
@@ -548,34 +542,23 @@ class LandingsDataInterface : public DataInterfaceBase {
 
 #ifdef TMB_MODEL
 
-  template <typename Type>
-  bool add_to_fims_tmb_internal() {
-    std::shared_ptr<fims_data_object::DataObject<Type>> data =
-        std::make_shared<fims_data_object::DataObject<Type>>(this->ymax);
-
-    data->id = this->id;
-
-    for (int y = 0; y < ymax; y++) {
-      data->at(y) = this->landings_data[y];
-      data->uncertainty[y] = this->uncertainty[y];
-    }
-
-    std::shared_ptr<fims_info::Information<Type>> info =
-        fims_info::Information<Type>::GetInstance();
-
-    info->data_objects[this->id] = data;
-    return true;
-  }
-
   /**
    * @brief Adds the parameters to the TMB model.
    * @return A boolean of true.
    */
   virtual bool add_to_fims_tmb() {
-    this->add_to_fims_tmb_internal<TMB_FIMS_REAL_TYPE>();
-    this->add_to_fims_tmb_internal<TMBAD_FIMS_TYPE>();
+    std::shared_ptr<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>> data =
+        std::make_shared<fims_data_object::DataObject<TMB_FIMS_REAL_TYPE>>(
+            this->ymax);
 
-    return true;
+    for (int y = 0; y < ymax; y++) {
+      data->set(y, this->landings_data[y]);
+      (*data->uncertainty)[y] = this->uncertainty[y];
+    }
+    // landings are kept in every retrospective peel
+    data->retrospective_peel = false;
+
+    return this->add_data_object_to_fims_tmb(data);
   }
 
 #endif
@@ -130,6 +130,13 @@ class FleetInterface : public FleetInterfaceBase {
    * age-to-length-conversion matrix.
    */
   VariableVector age_to_length_conversion;
+  /**
+   * @brief The largest absolute value of an entry of the age-to-length
+   * conversion matrix that is pruned from the projection to length, see
+   * SetAgeToLengthTolerance().
+   */
+  std::shared_ptr<double> age_to_length_tolerance =
+      std::make_shared<double>(0.0);
 
   // Fleet based derived quantities
   /**
@@ -248,6 +255,7 @@ class FleetInterface : public FleetInterfaceBase {
         log_q(other.log_q),
         log_Fmort(other.log_Fmort),
         age_to_length_conversion(other.age_to_length_conversion),
+        age_to_length_tolerance(other.age_to_length_tolerance),
         landings_numbers_at_age(other.landings_numbers_at_age),
         landings_weight_at_age(other.landings_weight_at_age),
         landings_numbers_at_length(other.landings_numbers_at_length),
@@ -321,6 +329,26 @@ class FleetInterface : public FleetInterfaceBase {
   void SetObservedLandingsDataID(int observed_landings_data_id) {
     interface_observed_landings_data_id_m.set(observed_landings_data_id);
   }
+  /**
+   * @brief Sets the tolerance of the age-to-length conversion matrix.
+   *
+   * @details For each age, the leading and trailing entries of the
+   * conversion matrix whose absolute value is at most the tolerance are
+   * pruned when the model is created, so the projection to length only
+   * multiplies the band of length bins with non-negligible probability. The
+   * default of zero prunes entries that are exactly zero. Entries are never
+   * pruned if any entry of the matrix is estimated. Call this before
+   * `CreateTMBModel()`.
+   *
+   * @param tolerance The largest absolute value of a pruned entry.
+   */
+  void SetAgeToLengthTolerance(double tolerance) {
+    if (!(tolerance >= 0.0)) {
+      Rcpp::stop("The age-to-length tolerance must be non-negative.");
+    }
+    *this->age_to_length_tolerance = tolerance;
+  }
+
   /**
    * @brief Set the unique ID for the selectivity object.
    * @param selectivity_id Unique ID for the observed object.
@@ -515,12 +543,14 @@ class FleetInterface : public FleetInterfaceBase {
             fims::to_string((this->n_ages.get() * this->n_lengths.get())));
       }
 
+      bool estimated_conversion = false;
       for (size_t i = 0; i < fleet->age_to_length_conversion.size(); i++) {
         fleet->age_to_length_conversion[i] =
             this->age_to_length_conversion[i].initial_value_m;
 
         if (this->age_to_length_conversion[i].estimation_type_m.get() ==
             "fixed_effects") {
+          estimated_conversion = true;
           ss.str("");
           ss << "Fleet." << this->id << ".age_to_length_conversion."
              << this->age_to_length_conversion[i].id_m;
@@ -534,6 +564,10 @@ class FleetInterface : public FleetInterfaceBase {
         }
       }
 
+      // estimated entries can move away from zero, so they are not pruned
+      fleet->age_to_length_tolerance =
+          estimated_conversion ? -1.0 : *this->age_to_length_tolerance;
+
       info->variable_map[this->age_to_length_conversion.id_m] =
           &(fleet)->age_to_length_conversion;
     }
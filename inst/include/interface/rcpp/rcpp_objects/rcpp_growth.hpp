@@ -265,6 +265,10 @@ class EWAAGrowthInterface : public GrowthInterfaceBase {
     ewaa_growth->id = this->id;
     ewaa_growth->ewaa =
         make_map(this->ages, this->weights, this->n_years);  // this->ewaa;
+    // one weight vector by age is shared across years
+    if (this->weights.size() == this->ages.size()) {
+      ewaa_growth->time_dependence = fims_model_object::TimeInvariant;
+    }
     // add to Information
     info->growth_models[ewaa_growth->id] = ewaa_growth;
 
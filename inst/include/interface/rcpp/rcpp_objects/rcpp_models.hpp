@@ -118,11 +118,8 @@ class FisheryModelInterfaceBase : public FIMSRcppInterfaceBase {
     std::shared_ptr<fims_info::Information<double>> info0 =
         fims_info::Information<double>::GetInstance();
 
-    Rcpp::NumericVector p;
-
-    for (size_t i = 0; i < info0->fixed_effects_parameters.size(); i++) {
-      p.push_back(*info0->fixed_effects_parameters[i]);
-    }
+    Rcpp::NumericVector p(info0->fixed_effects_parameters.size());
+    info0->GetFixedEffects(p.begin());
 
     return p;
   }
@@ -138,11 +135,8 @@ class FisheryModelInterfaceBase : public FIMSRcppInterfaceBase {
     std::shared_ptr<fims_info::Information<double>> d0 =
         fims_info::Information<double>::GetInstance();
 
-    Rcpp::NumericVector p;
-
-    for (size_t i = 0; i < d0->random_effects_parameters.size(); i++) {
-      p.push_back(*d0->random_effects_parameters[i]);
-    }
+    Rcpp::NumericVector p(d0->random_effects_parameters.size());
+    d0->GetRandomEffects(p.begin());
 
     return p;
   }
@@ -214,11 +208,44 @@ class FisheryModelInterfaceBase : public FIMSRcppInterfaceBase {
  * CatchAtAge model. It inherits from the FisheryModelInterfaceBase class.
  */
 class CatchAtAgeInterface : public FisheryModelInterfaceBase {
+  /**
+   * @brief If true, equilibrium reference points are calculated and reported.
+   */
+  std::shared_ptr<bool> calculate_reference_points;
+  /**
+   * @brief Target ratio of spawning biomass per recruit for F_spr.
+   */
+  std::shared_ptr<double> spr_target;
+  /**
+   * @brief If true, the one-year update of the population is taped once and
+   * replayed for every year.
+   */
+  std::shared_ptr<bool> checkpoint_years;
+  /**
+   * @brief Names of the derived quantities that are ADREPORTed.
+   */
+  std::shared_ptr<std::set<std::string>> adreport_names;
+  /**
+   * @brief Ids of the populations that are ADREPORTed, empty for all.
+   */
+  std::shared_ptr<std::set<uint32_t>> adreport_population_ids;
+  /**
+   * @brief Ids of the fleets that are ADREPORTed, empty for all.
+   */
+  std::shared_ptr<std::set<uint32_t>> adreport_fleet_ids;
+
  public:
   /**
    * @brief The constructor.
    */
   CatchAtAgeInterface() : FisheryModelInterfaceBase() {
+    this->calculate_reference_points = std::make_shared<bool>(false);
+    this->spr_target = std::make_shared<double>(0.4);
+    this->checkpoint_years = std::make_shared<bool>(false);
+    this->adreport_names = std::make_shared<std::set<std::string>>(
+        fims_popdy::CatchAtAge<double>::DefaultAdreportNames());
+    this->adreport_population_ids = std::make_shared<std::set<uint32_t>>();
+    this->adreport_fleet_ids = std::make_shared<std::set<uint32_t>>();
     std::shared_ptr<CatchAtAgeInterface> caa =
         std::make_shared<CatchAtAgeInterface>(*this);
     FIMSRcppInterfaceBase::fims_interface_objects.push_back(caa);
@@ -231,7 +258,13 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
    * @param other
    */
   CatchAtAgeInterface(const CatchAtAgeInterface &other)
-      : FisheryModelInterfaceBase(other) {}
+      : FisheryModelInterfaceBase(other),
+        calculate_reference_points(other.calculate_reference_points),
+        spr_target(other.spr_target),
+        checkpoint_years(other.checkpoint_years),
+        adreport_names(other.adreport_names),
+        adreport_population_ids(other.adreport_population_ids),
+        adreport_fleet_ids(other.adreport_fleet_ids) {}
 
   /**
    * Method to add a population id to the set of population ids.
@@ -302,6 +335,258 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
    */
   virtual uint32_t get_id() { return this->id; }
 
+  /**
+   * @brief Turns the calculation of equilibrium reference points on or off.
+   *
+   * @details When on, F_msy, msy, spawning_biomass_msy, and F_spr are
+   * calculated for each population at the biology and selectivity of the last
+   * model year and are included in the report and the ADREPORT, i.e., they
+   * have standard errors from `TMB::sdreport()`. Call this before
+   * `CreateTMBModel()`.
+   *
+   * @param calculate Boolean flag to turn the calculation on (true) or off.
+   * @param spr_target Target ratio of spawning biomass per recruit for F_spr,
+   * e.g., 0.4 for F_40%.
+   */
+  void SetReferencePoints(bool calculate, double spr_target) {
+    if (!(spr_target > 0.0 && spr_target < 1.0)) {
+      Rcpp::stop("spr_target must be between 0 and 1.");
+    }
+    *this->calculate_reference_points = calculate;
+    *this->spr_target = spr_target;
+  }
+
+  /**
+   * @brief Turns the checkpointed one-year update on or off.
+   *
+   * @details When on, the mortality, survival, plus group, and landings
+   * numbers at age of one year are recorded once as an atomic function that
+   * the AD tape replays for every year, instead of recording the operations
+   * of every year and age. This adds fewer variables to the tape at the
+   * cost of replaying the update in each derivative sweep; compare both
+   * settings with set_tape_counters() and get_tape_counters(). The
+   * estimates are unchanged. Call this before `CreateTMBModel()`.
+   *
+   * @param checkpoint Boolean flag to turn the checkpointed update on (true)
+   * or off (false).
+   */
+  void SetCheckpointYears(bool checkpoint) {
+    *this->checkpoint_years = checkpoint;
+  }
+
+  /**
+   * @brief Selects the derived quantities that are ADREPORTed, i.e., that
+   * have standard errors from `TMB::sdreport()`.
+   *
+   * @details By default, biomass, spawning_biomass, expected_recruitment,
+   * mortality_F, and the reference points are ADREPORTed for all populations
+   * and fleets. The cost of `TMB::sdreport()` grows with the number of
+   * ADREPORTed values. All derived quantities are in the report regardless.
+   * Call this before `CreateTMBModel()`.
+   *
+   * @param names Names of the derived quantities, where "all" selects every
+   * derived quantity.
+   * @param population_ids Ids of the populations to ADREPORT, where an empty
+   * vector selects all populations.
+   * @param fleet_ids Ids of the fleets to ADREPORT, where an empty vector
+   * selects all fleets.
+   */
+  void SetAdreport(Rcpp::CharacterVector names,
+                   Rcpp::IntegerVector population_ids,
+                   Rcpp::IntegerVector fleet_ids) {
+    try {
+      std::vector<std::string> v = Rcpp::as<std::vector<std::string>>(names);
+      *this->adreport_names =
+          fims_popdy::CatchAtAge<double>::ExpandAdreportNames(
+              std::set<std::string>(v.begin(), v.end()));
+    } catch (const std::exception &e) {
+      Rcpp::stop(e.what());
+    }
+    *this->adreport_population_ids =
+        std::set<uint32_t>(population_ids.begin(), population_ids.end());
+    *this->adreport_fleet_ids =
+        std::set<uint32_t>(fleet_ids.begin(), fleet_ids.end());
+  }
+
+  /**
+   * @brief Gets the names of the derived quantities that are ADREPORTed.
+   */
+  Rcpp::CharacterVector GetAdreport() {
+    return Rcpp::wrap(std::vector<std::string>(this->adreport_names->begin(),
+                                               this->adreport_names->end()));
+  }
+
+  /**
+   * @brief Evaluates equilibrium quantities over a vector of fishing
+   * mortalities.
+   *
+   * @details The model is evaluated at the current parameter values and the
+   * biology and selectivity of the last model year of the first population
+   * are used. See fims_popdy::Equilibrium for details.
+   *
+   * @param F Fishing mortalities of the fully selected age.
+   * @return Rcpp::DataFrame One row per fishing mortality with the spawning
+   * biomass and yield per recruit, recruitment, spawning biomass, and yield.
+   */
+  Rcpp::DataFrame GetEquilibrium(Rcpp::NumericVector F) {
+    std::shared_ptr<fims_info::Information<double>> info =
+        fims_info::Information<double>::GetInstance();
+    std::shared_ptr<fims_popdy::CatchAtAge<double>> model =
+        std::dynamic_pointer_cast<fims_popdy::CatchAtAge<double>>(
+            info->models_map[this->get_id()]);
+    if (model == nullptr || model->populations.size() == 0) {
+      Rcpp::stop("CatchAtAge model " + fims::to_string(this->get_id()) +
+                 " has not been initialized.");
+    }
+
+#ifdef TMB_MODEL
+    bool do_reporting = model->do_reporting;
+    model->do_reporting = false;
+#endif
+    fims_model::Model<double>::GetInstance()->Evaluate();
+#ifdef TMB_MODEL
+    model->do_reporting = do_reporting;
+#endif
+
+    fims_popdy::EquilibriumGrid<double> grid;
+    try {
+      std::shared_ptr<fims_popdy::Population<double>> &population =
+          model->populations[0];
+      fims_popdy::Equilibrium<double> equilibrium;
+      equilibrium.Setup(population,
+                        model->GetPopulationDerivedQuantities(
+                            population->GetId()),
+                        population->n_years - 1);
+      grid = equilibrium.Evaluate(std::vector<double>(F.begin(), F.end()));
+    } catch (const std::exception &e) {
+      Rcpp::stop(e.what());
+    }
+
+    Rcpp::List out;
+    out["F"] = Rcpp::wrap(grid.F);
+    out["spawning_biomass_per_recruit"] =
+        Rcpp::wrap(grid.spawning_biomass_per_recruit);
+    out["yield_per_recruit"] = Rcpp::wrap(grid.yield_per_recruit);
+    out["recruitment"] = Rcpp::wrap(grid.recruitment);
+    out["spawning_biomass"] = Rcpp::wrap(grid.spawning_biomass);
+    out["yield"] = Rcpp::wrap(grid.yield);
+    return Rcpp::DataFrame(out);
+  }
+
+  /**
+   * @brief Projects the model forward under a harvest control rule with
+   * stochastic recruitment.
+   *
+   * @details The model is evaluated at the current parameter values, e.g.,
+   * those set by `set_fixed()`, and the numbers at age at the end of the last
+   * model year of the first population are projected. See
+   * fims_popdy::Projection for details.
+   *
+   * @param n_years Number of years to project.
+   * @param n_replicates Number of stochastic replicates.
+   * @param rule Harvest control rule, one of "constant_F", "constant_catch",
+   * or "ssb_ratio_ramp".
+   * @param value Fishing mortality of the fully selected age for
+   * "constant_F" and "ssb_ratio_ramp", or landings in weight for
+   * "constant_catch".
+   * @param lower_ratio Spawning biomass ratio at or below which there is no
+   * fishing for "ssb_ratio_ramp".
+   * @param upper_ratio Spawning biomass ratio at or above which `value` is
+   * applied for "ssb_ratio_ramp".
+   * @param sigma_recruit Standard deviation of the log recruitment
+   * deviations.
+   * @param seed Seed of the recruitment deviations.
+   * @param probabilities Probabilities of the quantiles.
+   * @param n_threads Number of threads, where zero uses the number of
+   * hardware threads.
+   * @return Rcpp::DataFrame One row per quantity and projected year with the
+   * mean and one column per quantile.
+   */
+  Rcpp::DataFrame Project(size_t n_years, size_t n_replicates,
+                          std::string rule, double value, double lower_ratio,
+                          double upper_ratio, double sigma_recruit,
+                          double seed, Rcpp::NumericVector probabilities,
+                          size_t n_threads) {
+    std::shared_ptr<fims_info::Information<double>> info =
+        fims_info::Information<double>::GetInstance();
+    std::shared_ptr<fims_popdy::CatchAtAge<double>> model =
+        std::dynamic_pointer_cast<fims_popdy::CatchAtAge<double>>(
+            info->models_map[this->get_id()]);
+    if (model == nullptr) {
+      Rcpp::stop("CatchAtAge model " + fims::to_string(this->get_id()) +
+                 " has not been initialized.");
+    }
+
+    std::shared_ptr<fims_popdy::HarvestControlRuleBase> hcr;
+    if (rule == "constant_F") {
+      hcr = std::make_shared<fims_popdy::ConstantFishingMortality>(value);
+    } else if (rule == "constant_catch") {
+      hcr = std::make_shared<fims_popdy::ConstantLandings>(value);
+    } else if (rule == "ssb_ratio_ramp") {
+      if (!(lower_ratio < upper_ratio)) {
+        Rcpp::stop("lower_ratio must be less than upper_ratio.");
+      }
+      hcr = std::make_shared<fims_popdy::SpawningBiomassRatioRamp>(
+          value, lower_ratio, upper_ratio);
+    } else {
+      Rcpp::stop("Unknown harvest control rule: " + rule);
+    }
+
+#ifdef TMB_MODEL
+    bool do_reporting = model->do_reporting;
+    model->do_reporting = false;
+#endif
+    fims_model::Model<double>::GetInstance()->Evaluate();
+#ifdef TMB_MODEL
+    model->do_reporting = do_reporting;
+#endif
+
+    std::vector<double> p(probabilities.begin(), probabilities.end());
+    fims_popdy::ProjectionSummary summary;
+    try {
+      fims_popdy::Projection<double> projection;
+      projection.Setup(*model);
+      summary = projection.Run(n_years, n_replicates, *hcr, sigma_recruit,
+                               static_cast<uint64_t>(seed), p, n_threads);
+    } catch (const std::exception &e) {
+      Rcpp::stop(e.what());
+    }
+
+    size_t n_rows = summary.mean.size() * n_years;
+    Rcpp::IntegerVector year(n_rows);
+    Rcpp::CharacterVector label(n_rows);
+    Rcpp::NumericVector mean(n_rows);
+    std::vector<Rcpp::NumericVector> quantiles(p.size());
+    for (size_t q = 0; q < p.size(); q++) {
+      quantiles[q] = Rcpp::NumericVector(n_rows);
+    }
+    size_t row = 0;
+    std::map<std::string, std::vector<double>>::iterator it;
+    for (it = summary.mean.begin(); it != summary.mean.end(); ++it) {
+      std::vector<double> &q_values = summary.quantiles[(*it).first];
+      for (size_t y = 0; y < n_years; y++) {
+        year[row] = static_cast<int>(y + 1);
+        label[row] = (*it).first;
+        mean[row] = (*it).second[y];
+        for (size_t q = 0; q < p.size(); q++) {
+          quantiles[q][row] = q_values[y * p.size() + q];
+        }
+        row++;
+      }
+    }
+
+    Rcpp::List out;
+    out["label"] = label;
+    out["year"] = year;
+    out["mean"] = mean;
+    for (size_t q = 0; q < p.size(); q++) {
+      std::stringstream name;
+      name << "q" << p[q];
+      out[name.str()] = quantiles[q];
+    }
+    return Rcpp::DataFrame(out);
+  }
+
   /**
    *
    */
@@ -468,82 +753,8 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
   std::string derived_quantity_to_json(
       std::map<std::string, fims::Vector<double>>::iterator it,
       const fims_popdy::DimensionInfo &dim_info) {
-    std::stringstream ss;
-    fims::Vector<double> &dq = (*it).second;
-    std::stringstream dim_entry;
-    // gather dimension information
-    switch (dim_info.ndims) {
-      case 1:
-        dim_entry << "\"dimensionality\": {\n";
-        dim_entry << "  \"header\": [\"" << dim_info.dim_names[0] << "\"],\n";
-        dim_entry << "  \"dimensions\": [";
-        for (size_t i = 0; i < dim_info.dims.size(); ++i) {
-          if (i > 0) dim_entry << ", ";
-          dim_entry << dim_info.dims[i];
-        }
-        dim_entry << "]\n";
-        dim_entry << "}";
-        break;
-      case 2:
-        dim_entry << "\"dimensionality\": {\n";
-        dim_entry << "  \"header\": [\"" << dim_info.dim_names[0] << "\", \""
-                  << dim_info.dim_names[1] << "\"],\n";
-        dim_entry << "  \"dimensions\": [";
-        for (size_t i = 0; i < dim_info.dims.size(); ++i) {
-          if (i > 0) dim_entry << ", ";
-          dim_entry << dim_info.dims[i];
-        }
-        dim_entry << "]\n";
-        dim_entry << "}";
-        break;
-      case 3:
-        dim_entry << "\"dimensionality\": {\n";
-        dim_entry << "  \"header\": [\"" << dim_info.dim_names[0] << "\", \""
-                  << dim_info.dim_names[1] << "\", \"" << dim_info.dim_names[2]
-                  << "\"],\n";
-        dim_entry << "  \"dimensions\": [";
-        for (size_t i = 0; i < dim_info.dims.size(); ++i) {
-          if (i > 0) dim_entry << ", ";
-          dim_entry << dim_info.dims[i];
-        }
-        dim_entry << "]\n";
-        dim_entry << "}";
-        break;
-      default:
-        dim_entry << "\"dimensionality\": {\n";
-        dim_entry << "  \"header\": [],\n";
-        dim_entry << "  \"dimensions\": []\n";
-        dim_entry << "}";
-        break;
-    }
-
-    // build JSON string
-    ss << "{\n";
-    ss << "\"name\":\"" << (*it).first << "\",\n";
-    ss << dim_entry.str() << ",\n";
-    ss << "\"value\":[";
-    ss << std::fixed << std::setprecision(10);
-    if (dq.size() > 0) {
-      for (size_t i = 0; i < dq.size() - 1; i++) {
-        if (dq[i] != dq[i])  // check for NaN
-        {
-          ss << "-999" << ", ";
-        } else {
-          ss << dq[i] << ", ";
-        }
-      }
-      if (dq[dq.size() - 1] != dq[dq.size() - 1])  // check for NaN
-      {
-        ss << "-999]" << "\n";
-      } else {
-        ss << dq[dq.size() - 1] << "]\n";
-      }
-    } else {
-      ss << "]\n";
-    }
-    ss << "}";
-
-    return ss.str();
+    return fims_popdy::DerivedQuantityToJson((*it).first, (*it).second,
+                                             dim_info);
   }
 
   /**
@@ -553,33 +764,7 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
   std::string derived_quantities_component_to_json(
       std::map<std::string, fims::Vector<double>> &dqs,
       std::map<std::string, fims_popdy::DimensionInfo> &dim_info) {
-    std::stringstream ss;
-    std::map<std::string, fims_popdy::DimensionInfo>::iterator dim_info_it;
-    std::map<std::string, fims::Vector<double>>::iterator it;
-    std::map<std::string, fims::Vector<double>>::iterator end_it;
-    end_it = dqs.end();
-    typename std::map<std::string, fims::Vector<double>>::iterator
-        second_to_last;
-    second_to_last = dqs.end();
-    if (it != end_it) {
-      second_to_last--;
-    }
-
-    it = dqs.begin();
-    for (; it != second_to_last; ++it) {
-      dim_info_it = dim_info.find(it->first);
-      ss << this->derived_quantity_to_json(it, dim_info_it->second) << ",\n";
-    }
-
-    dim_info_it = dim_info.find(second_to_last->first);
-    if (dim_info_it != dim_info.end()) {
-      ss << this->derived_quantity_to_json(second_to_last, dim_info_it->second)
-         << "\n";
-    } else {
-      ss << "{}";
-      // Handle case where dimension info is not found
-    }
-    return ss.str();
+    return fims_popdy::DerivedQuantitiesToJson(dqs, dim_info);
   }
 
   /**
@@ -967,6 +1152,13 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
     std::set<uint32_t> fleet_ids;  // all fleets in the model
     typedef typename std::set<uint32_t>::iterator fleet_ids_iterator;
 
+    model->calculate_reference_points = *this->calculate_reference_points;
+    model->spr_target = *this->spr_target;
+    model->checkpoint_years = *this->checkpoint_years;
+    model->adreport_names = *this->adreport_names;
+    model->adreport_population_ids = *this->adreport_population_ids;
+    model->adreport_fleet_ids = *this->adreport_fleet_ids;
+
     // add to Information
     info->models_map[this->get_id()] = model;
 
@@ -1151,6 +1343,16 @@ class CatchAtAgeInterface : public FisheryModelInterfaceBase {
       info->variable_map[population_interface->sum_selectivity.id_m] =
           &derived_quantities["sum_selectivity"];
 
+      if (*this->calculate_reference_points) {
+        const char *reference_points[] = {"F_msy", "msy",
+                                          "spawning_biomass_msy", "F_spr"};
+        for (const char *name : reference_points) {
+          derived_quantities[name] = fims::Vector<Type>(1);
+          derived_quantities_dim_info[name] = fims_popdy::DimensionInfo(
+              name, fims::Vector<int>{1}, fims::Vector<std::string>{"na"});
+        }
+      }
+
       // replace elements in the variable map
 
       for (fleet_ids_iterator fit = population_interface->fleet_ids->begin();
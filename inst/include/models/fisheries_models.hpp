@@ -11,5 +11,7 @@
 #define FIMS_MODELS_FISHERIES_MODELS_HPP
 
 #include "functors/catch_at_age.hpp"
+#include "functors/projection.hpp"
+#include "functors/reference_points.hpp"
 
 #endif
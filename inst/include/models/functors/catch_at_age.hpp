@@ -8,10 +8,16 @@
 #ifndef FIMS_MODELS_CATCH_AT_AGE_HPP
 #define FIMS_MODELS_CATCH_AT_AGE_HPP
 
-#include <set>
+#include <algorithm>
 #include <regex>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+#include "catch_at_age_year.hpp"
 #include "fishery_model_base.hpp"
+#include "reference_points.hpp"
 
 /* Dictionary block for shared parameter snippet documentations.
  * Referenced in function docs via @snippet{doc} this snippet_id.
@@ -40,6 +46,72 @@
 
 namespace fims_popdy {
 
+/**
+ * @brief Timers of the phases of the population dynamics of
+ * CatchAtAge::Evaluate(), which run for every year and age. Each phase is
+ * summed locally and added to fims::FIMSTimer once per evaluation, when the
+ * timers go out of scope, see fims::PhaseAccumulator.
+ */
+struct CatchAtAgeTimers {
+  fims::PhaseAccumulator mortality;   /*!< CalculateMortality */
+  fims::PhaseAccumulator numbers;     /*!< CalculateNumbers */
+  fims::PhaseAccumulator recruitment; /*!< CalculateRecruitment */
+  fims::PhaseAccumulator biomass;     /*!< CalculateBiomass */
+  fims::PhaseAccumulator spawning_biomass; /*!< CalculateSpawningBiomass */
+  fims::PhaseAccumulator year;        /*!< CalculateYear */
+  fims::PhaseAccumulator landings;    /*!< CalculateLandings */
+  fims::PhaseAccumulator index;       /*!< CalculateIndex */
+  /** CalculateSpawningBiomassRatio */
+  fims::PhaseAccumulator spawning_biomass_ratio;
+
+  /**
+   * @brief Starts the timers of one CatchAtAge object.
+   *
+   * @param id The id of the CatchAtAge object.
+   * @param type The name of the value type, see fims::FIMSTimer::TypeName().
+   */
+  CatchAtAgeTimers(uint32_t id, const char *type)
+      : mortality("CatchAtAge", id, type, "CalculateMortality"),
+        numbers("CatchAtAge", id, type, "CalculateNumbers"),
+        recruitment("CatchAtAge", id, type, "CalculateRecruitment"),
+        biomass("CatchAtAge", id, type, "CalculateBiomass"),
+        spawning_biomass("CatchAtAge", id, type, "CalculateSpawningBiomass"),
+        year("CatchAtAge", id, type, "CalculateYear"),
+        landings("CatchAtAge", id, type, "CalculateLandings"),
+        index("CatchAtAge", id, type, "CalculateIndex"),
+        spawning_biomass_ratio("CatchAtAge", id, type,
+                               "CalculateSpawningBiomassRatio") {}
+};
+
+/**
+ * @brief The unfished trajectory of a population and the values of the
+ * inputs that it was calculated from, see
+ * CatchAtAge::CalculateUnfishedTrajectory().
+ */
+template <typename Type>
+struct UnfishedTrajectory {
+  bool valid = false;             /*!< true once a trajectory is stored */
+  double log_rzero = 0.0;         /*!< unexploited recruitment, log scale */
+  std::vector<double> M;          /*!< natural mortality */
+  std::vector<double> maturity;   /*!< maturity at age by year */
+  std::vector<double> weight_at_age;     /*!< weight at age by year */
+  std::vector<double> proportion_female; /*!< proportion female by age */
+  fims::Vector<Type> numbers_at_age;   /*!< unfished numbers at age */
+  fims::Vector<Type> biomass;          /*!< unfished biomass */
+  fims::Vector<Type> spawning_biomass; /*!< unfished spawning biomass */
+
+  /**
+   * @brief Heap bytes owned by the trajectory.
+   */
+  size_t OwnedBytes() const {
+    return fims::HeapBytes(M) + fims::HeapBytes(maturity) +
+           fims::HeapBytes(weight_at_age) +
+           fims::HeapBytes(proportion_female) +
+           fims::HeapBytes(numbers_at_age) + fims::HeapBytes(biomass) +
+           fims::HeapBytes(spawning_biomass);
+  }
+};
+
 template <typename Type>
 /**
  * @brief CatchAtAge is a class containing a catch-at-age model, which is
@@ -116,9 +188,51 @@ class CatchAtAge : public FisheryModelBase<Type> {
    * parameters.
    */
   std::map<std::string, fims::Vector<fims::Vector<Type>>> report_vectors;
+  /**
+   * @brief The one-year update of each population, by population id, see
+   * CalculateCheckpointedYears().
+   */
+  std::map<uint32_t, CatchAtAgeYear<Type>> year_updates;
+  /**
+   * @brief The unfished trajectory of each population, by population id,
+   * which is reused by the double model while its inputs do not change, see
+   * CalculateUnfishedTrajectory().
+   */
+  std::map<uint32_t, UnfishedTrajectory<Type>> unfished_trajectories;
 
  public:
   std::vector<Type> ages; /*!< vector of the ages for referencing*/
+  /**
+   * @brief If true, equilibrium reference points are calculated for each
+   * population at the end of Evaluate() and reported.
+   */
+  bool calculate_reference_points = false;
+  /**
+   * @brief Target ratio of spawning biomass per recruit for F_spr.
+   */
+  double spr_target = 0.4;
+  /**
+   * @brief If true, the one-year update of the numbers at age, mortality,
+   * and landings numbers at age is taped once and replayed for every year,
+   * see CalculateCheckpointedYears().
+   */
+  bool checkpoint_years = false;
+  /**
+   * @brief Names of the derived quantities that are ADREPORTed, i.e., that
+   * have standard errors from `TMB::sdreport()`. All derived quantities are
+   * REPORTed regardless. See DefaultAdreportNames().
+   */
+  std::set<std::string> adreport_names = DefaultAdreportNames();
+  /**
+   * @brief Ids of the populations whose derived quantities are ADREPORTed,
+   * where an empty set selects all populations.
+   */
+  std::set<uint32_t> adreport_population_ids;
+  /**
+   * @brief Ids of the fleets whose derived quantities are ADREPORTed, where
+   * an empty set selects all fleets.
+   */
+  std::set<uint32_t> adreport_fleet_ids;
   /**
    * Constructor for the CatchAtAge class. This constructor initializes the
    * name of the model and sets the id of the model.
@@ -128,6 +242,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
     ss << "caa_" << this->GetId() << "_";
     this->name_m = ss.str();
     this->model_type_m = "caa";
+    this->model_type = CatchAtAgeModelType;
   }
 
   /**
@@ -136,8 +251,17 @@ class CatchAtAge : public FisheryModelBase<Type> {
    * @snippet{doc} this param_other
    */
   CatchAtAge(const CatchAtAge &other)
-      : FisheryModelBase<Type>(other), name_m(other.name_m), ages(other.ages) {
+      : FisheryModelBase<Type>(other),
+        name_m(other.name_m),
+        ages(other.ages),
+        calculate_reference_points(other.calculate_reference_points),
+        spr_target(other.spr_target),
+        checkpoint_years(other.checkpoint_years),
+        adreport_names(other.adreport_names),
+        adreport_population_ids(other.adreport_population_ids),
+        adreport_fleet_ids(other.adreport_fleet_ids) {
     this->model_type_m = "caa";
+    this->model_type = CatchAtAgeModelType;
   }
 
   /**
@@ -146,6 +270,158 @@ class CatchAtAge : public FisheryModelBase<Type> {
    */
   virtual ~CatchAtAge() {}
 
+  /**
+   * @brief The names of the population derived quantities in the report.
+   */
+  static const std::vector<std::string> &PopulationReportNames() {
+    static const std::vector<std::string> names = {
+        "biomass",
+        "expected_recruitment",
+        "mortality_F",
+        "mortality_M",
+        "mortality_Z",
+        "numbers_at_age",
+        "proportion_mature_at_age",
+        "spawning_biomass",
+        "sum_selectivity",
+        "total_landings_numbers",
+        "total_landings_weight",
+        "unfished_biomass",
+        "unfished_numbers_at_age",
+        "unfished_spawning_biomass",
+        "spawning_biomass_ratio"};
+    return names;
+  }
+
+  /**
+   * @brief The names of the reference points in the report, which are only
+   * calculated if calculate_reference_points is true.
+   */
+  static const std::vector<std::string> &ReferencePointReportNames() {
+    static const std::vector<std::string> names = {
+        "F_msy", "msy", "spawning_biomass_msy", "F_spr"};
+    return names;
+  }
+
+  /**
+   * @brief The names of the fleet derived quantities in the report.
+   */
+  static const std::vector<std::string> &FleetReportNames() {
+    static const std::vector<std::string> names = {
+        "agecomp_expected",
+        "agecomp_proportion",
+        "index_expected",
+        "index_numbers",
+        "index_numbers_at_age",
+        "index_numbers_at_length",
+        "index_weight",
+        "index_weight_at_age",
+        "landings_expected",
+        "landings_numbers",
+        "landings_numbers_at_age",
+        "landings_numbers_at_length",
+        "landings_weight",
+        "landings_weight_at_age",
+        "lengthcomp_expected",
+        "lengthcomp_proportion",
+        "log_index_expected",
+        "log_landings_expected"};
+    return names;
+  }
+
+  /**
+   * @brief The derived quantities that are ADREPORTed by default, i.e.,
+   * biomass, spawning biomass, recruitment, fishing mortality, and the
+   * reference points. The cost of `TMB::sdreport()` grows with the number of
+   * ADREPORTed values, so the age and length matrices are left out.
+   */
+  static std::set<std::string> DefaultAdreportNames() {
+    std::set<std::string> names = {"biomass", "spawning_biomass",
+                                   "expected_recruitment", "mortality_F"};
+    names.insert(ReferencePointReportNames().begin(),
+                 ReferencePointReportNames().end());
+    return names;
+  }
+
+  /**
+   * @brief Checks the names of derived quantities to ADREPORT and replaces
+   * "all" with every derived quantity.
+   *
+   * @param names The names of the derived quantities, see
+   * PopulationReportNames(), ReferencePointReportNames(), and
+   * FleetReportNames().
+   * @return The checked names.
+   * @throws std::invalid_argument If a name is not a derived quantity.
+   */
+  static std::set<std::string> ExpandAdreportNames(
+      const std::set<std::string> &names) {
+    const std::vector<std::string> *all[] = {&PopulationReportNames(),
+                                             &ReferencePointReportNames(),
+                                             &FleetReportNames()};
+    std::set<std::string> selected;
+    for (const std::string &name : names) {
+      bool found = false;
+      for (const std::vector<std::string> *known : all) {
+        if (name == "all") {
+          selected.insert(known->begin(), known->end());
+          found = true;
+        } else if (std::find(known->begin(), known->end(), name) !=
+                   known->end()) {
+          selected.insert(name);
+          found = true;
+        }
+      }
+      if (!found) {
+        throw std::invalid_argument("CatchAtAge: \"" + name +
+                                    "\" is not a derived quantity that can "
+                                    "be ADREPORTed.");
+      }
+    }
+    return selected;
+  }
+
+  /**
+   * @brief Selects the derived quantities that are ADREPORTed.
+   *
+   * @param names The names of the derived quantities, where "all" selects
+   * every derived quantity, see ExpandAdreportNames().
+   * @param population_ids The ids of the populations to ADREPORT, where an
+   * empty set selects all populations.
+   * @param fleet_ids The ids of the fleets to ADREPORT, where an empty set
+   * selects all fleets.
+   * @throws std::invalid_argument If a name is not a derived quantity.
+   */
+  void SetAdreport(const std::set<std::string> &names,
+                   const std::set<uint32_t> &population_ids,
+                   const std::set<uint32_t> &fleet_ids) {
+    this->adreport_names = ExpandAdreportNames(names);
+    this->adreport_population_ids = population_ids;
+    this->adreport_fleet_ids = fleet_ids;
+  }
+
+  /**
+   * @brief If true, the derived quantity is ADREPORTed.
+   */
+  bool IsAdreported(const std::string &name) const {
+    return this->adreport_names.count(name) > 0;
+  }
+
+  /**
+   * @brief If true, the derived quantities of the population are ADREPORTed.
+   */
+  bool IsAdreportedPopulation(uint32_t id) const {
+    return this->adreport_population_ids.empty() ||
+           this->adreport_population_ids.count(id) > 0;
+  }
+
+  /**
+   * @brief If true, the derived quantities of the fleet are ADREPORTed.
+   */
+  bool IsAdreportedFleet(uint32_t id) const {
+    return this->adreport_fleet_ids.empty() ||
+           this->adreport_fleet_ids.count(id) > 0;
+  }
+
   /**
    * This function is called once at the beginning of the model run. It
    * initializes the derived quantities for the populations and fleets.
@@ -176,14 +452,18 @@ class CatchAtAge : public FisheryModelBase<Type> {
       }
       fleet->q.resize(fleet->log_q.size());
       fleet->Fmort.resize(fleet->n_years);
+      fleet->Initialize();
     }
   }
 
   /**
    * This function is used to reset the derived quantities of a population or
-   * fleet to a given value.
+   * fleet to a given value. It also performs the parameter transformations
+   * and evaluates selectivity and weight at age once for the evaluation.
    */
   virtual void Prepare() {
+    fims::ScopedTimer timer("CatchAtAge", this->GetId(),
+                            fims::FIMSTimer::TypeName<Type>(), "Prepare");
     for (size_t p = 0; p < this->populations.size(); p++) {
       std::shared_ptr<fims_popdy::Population<Type>> &population =
           this->populations[p];
@@ -209,6 +489,47 @@ class CatchAtAge : public FisheryModelBase<Type> {
         population->f_multiplier[year] =
             fims_math::exp(population->log_f_multiplier[year]);
       }
+
+      // Scalar or by-age parameters are resolved into strided views once so
+      // the kernels below index them without branching
+      population->proportion_female_view =
+          population->proportion_female.strided_view(population->n_ages);
+
+      // Life-history modules are evaluated once per block of years with the
+      // same values and the values are copied to the other years
+      const size_t n_ages = population->n_ages;
+      if (population->growth != nullptr) {
+        population->weight_at_age.resize((population->n_years + 1) * n_ages);
+        for (size_t year = 0; year <= population->n_years; year++) {
+          size_t block_year = population->growth->GetTimeBlockYear(year);
+          Type *row = population->weight_at_age.data() + year * n_ages;
+          if (block_year < year) {
+            std::copy_n(population->weight_at_age.data() + block_year * n_ages,
+                        n_ages, row);
+          } else {
+            population->growth->evaluate_ages(population->ages.data(), n_ages,
+                                              year, row);
+          }
+        }
+      }
+      for (size_t f = 0; f < population->fleets.size(); f++) {
+        std::shared_ptr<fims_popdy::Fleet<Type>> &fleet = population->fleets[f];
+        if (fleet->selectivity == nullptr) {
+          continue;
+        }
+        fleet->selectivity_at_age.resize(population->n_years * n_ages);
+        for (size_t year = 0; year < population->n_years; year++) {
+          size_t block_year = fleet->selectivity->GetTimeBlockYear(year);
+          Type *row = fleet->selectivity_at_age.data() + year * n_ages;
+          if (block_year < year) {
+            std::copy_n(fleet->selectivity_at_age.data() + block_year * n_ages,
+                        n_ages, row);
+          } else {
+            fleet->selectivity->evaluate_ages(population->ages.data(), n_ages,
+                                              year, row);
+          }
+        }
+      }
     }
 
     for (fleet_iterator fit = this->fleets.begin(); fit != this->fleets.end();
@@ -229,6 +550,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
       for (size_t year = 0; year < fleet->n_years; year++) {
         fleet->Fmort[year] = fims_math::exp(fleet->log_Fmort[year]);
       }
+      fleet->q_view = fleet->q.strided_view(fleet->n_years);
     }
   }
   /**
@@ -396,8 +718,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
     for (size_t fleet_ = 0; fleet_ < population->n_fleets; fleet_++) {
       // evaluate is a member function of the selectivity class
-      Type s = population->fleets[fleet_]->selectivity->evaluate(
-          population->ages[age], year);
+      Type s = population->fleets[fleet_]->selectivity_at_age[i_age_year];
 
       dq_["mortality_F"][i_age_year] +=
           population->fleets[fleet_]->Fmort[year] *
@@ -433,7 +754,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
     dq_["biomass"][year] +=
         dq_["numbers_at_age"][i_age_year] *
-        population->growth->evaluate(year, population->ages[age]);
+        population->weight_at_age[i_age_year];
   }
 
   /**
@@ -458,7 +779,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
     dq_["unfished_biomass"][year] +=
         dq_["unfished_numbers_at_age"][i_age_year] *
-        population->growth->evaluate(year, population->ages[age]);
+        population->weight_at_age[i_age_year];
   }
 
   /**
@@ -484,10 +805,10 @@ class CatchAtAge : public FisheryModelBase<Type> {
         this->GetPopulationDerivedQuantities(population->GetId());
 
     dq_["spawning_biomass"][year] +=
-        population->proportion_female.get_force_scalar(age) *
+        population->proportion_female_view[age] *
         dq_["numbers_at_age"][i_age_year] *
         dq_["proportion_mature_at_age"][i_age_year] *
-        population->growth->evaluate(year, population->ages[age]);
+        population->weight_at_age[i_age_year];
   }
 
   /**
@@ -512,10 +833,133 @@ class CatchAtAge : public FisheryModelBase<Type> {
         this->GetPopulationDerivedQuantities(population->GetId());
 
     dq_["unfished_spawning_biomass"][year] +=
-        population->proportion_female.get_force_scalar(age) *
+        population->proportion_female_view[age] *
         dq_["unfished_numbers_at_age"][i_age_year] *
         dq_["proportion_mature_at_age"][i_age_year] *
-        population->growth->evaluate(year, population->ages[age]);
+        population->weight_at_age[i_age_year];
+  }
+
+  /**
+   * @brief Copies values into a key of the unfished trajectory unless they
+   * are already equal to it.
+   *
+   * @param key The stored values.
+   * @param values The current values, indexed by position.
+   * @param n The number of values.
+   * @return true if the key already held the values.
+   */
+  template <typename Values>
+  static bool UpdateUnfishedKey(std::vector<double> &key, Values &values,
+                                size_t n) {
+    bool same = key.size() == n;
+    for (size_t i = 0; same && i < n; i++) {
+      same = key[i] == fims_math::to_double(values[i]);
+    }
+    if (!same) {
+      key.resize(n);
+      for (size_t i = 0; i < n; i++) {
+        key[i] = fims_math::to_double(values[i]);
+      }
+    }
+    return same;
+  }
+
+  /**
+   * @brief Calculates maturity at age and the unfished numbers at age,
+   * biomass, and spawning biomass of a population for all years.
+   *
+   * @details The unfished trajectory only depends on unexploited
+   * recruitment, natural mortality, maturity, weight at age, and proportion
+   * female, so it is calculated in one pass over years and ages before the
+   * fished projection rather than cell by cell within it.
+   *
+   * These inputs rarely change between evaluations of the double model,
+   * e.g., for reporting, projections, or equilibria, so with doubles the
+   * trajectory is stored by population with the values of its inputs after
+   * Prepare(). The stored values are compared in place and, if all are
+   * equal, the stored trajectory is copied back instead of recalculated.
+   * Only the inputs that differ are copied into the key. AD types always
+   * recalculate: a tape records the trajectory once, in the single
+   * evaluation that it is recorded from, and reusing values would put them
+   * on the tape as constants without derivatives.
+   *
+   * @snippet{doc} this param_population
+   */
+  void CalculateUnfishedTrajectory(
+      std::shared_ptr<fims_popdy::Population<Type>> &population) {
+    std::map<std::string, fims::Vector<Type>> &dq_ =
+        this->GetPopulationDerivedQuantities(population->GetId());
+    const size_t n_ages = population->n_ages;
+    const size_t n_years = population->n_years;
+
+    // maturity is evaluated once per block of years with the same values,
+    // like growth and selectivity in Prepare(), and the year after the last
+    // year shares the values of the last year
+    fims::Vector<Type> &maturity = dq_["proportion_mature_at_age"];
+    for (size_t y = 0; y <= n_years; y++) {
+      size_t block_year =
+          population->maturity->GetTimeBlockYear(std::min(y, n_years - 1));
+      Type *row = maturity.data() + y * n_ages;
+      if (block_year < y) {
+        std::copy_n(maturity.data() + block_year * n_ages, n_ages, row);
+      } else {
+        population->maturity->evaluate_ages(population->ages.data(), n_ages, y,
+                                            row);
+      }
+    }
+
+    fims::Vector<Type> &numbers_at_age = dq_["unfished_numbers_at_age"];
+    fims::Vector<Type> &biomass = dq_["unfished_biomass"];
+    fims::Vector<Type> &spawning_biomass = dq_["unfished_spawning_biomass"];
+    UnfishedTrajectory<Type> *cache = nullptr;
+    if (std::is_same<Type, double>::value) {
+      cache = &this->unfished_trajectories[population->GetId()];
+      double log_rzero =
+          fims_math::to_double(population->recruitment->log_rzero[0]);
+      bool same = cache->valid && cache->log_rzero == log_rzero;
+      cache->log_rzero = log_rzero;
+      same &= UpdateUnfishedKey(cache->M, population->M, population->M.size());
+      same &= UpdateUnfishedKey(cache->maturity, maturity,
+                                (n_years + 1) * n_ages);
+      same &= UpdateUnfishedKey(cache->weight_at_age,
+                                population->weight_at_age,
+                                (n_years + 1) * n_ages);
+      same &= UpdateUnfishedKey(cache->proportion_female,
+                                population->proportion_female_view, n_ages);
+      if (same) {
+        std::copy(cache->numbers_at_age.begin(), cache->numbers_at_age.end(),
+                  numbers_at_age.begin());
+        std::copy(cache->biomass.begin(), cache->biomass.end(),
+                  biomass.begin());
+        std::copy(cache->spawning_biomass.begin(),
+                  cache->spawning_biomass.end(), spawning_biomass.begin());
+        return;
+      }
+    }
+
+    for (size_t y = 0; y <= n_years; y++) {
+      for (size_t a = 0; a < n_ages; a++) {
+        size_t i_age_year = y * n_ages + a;
+        if (a == 0) {
+          numbers_at_age[i_age_year] =
+              fims_math::exp(population->recruitment->log_rzero[0]);
+        } else if (y == 0) {
+          CalculateUnfishedNumbersAA(population, i_age_year, a - 1, a);
+        } else {
+          CalculateUnfishedNumbersAA(population, i_age_year,
+                                     (y - 1) * n_ages + (a - 1), a);
+        }
+        CalculateUnfishedBiomass(population, i_age_year, y, a);
+        CalculateUnfishedSpawningBiomass(population, i_age_year, y, a);
+      }
+    }
+
+    if (cache != nullptr) {
+      cache->numbers_at_age = numbers_at_age;
+      cache->biomass = biomass;
+      cache->spawning_biomass = spawning_biomass;
+      cache->valid = true;
+    }
   }
 
   /**
@@ -572,15 +1016,15 @@ class CatchAtAge : public FisheryModelBase<Type> {
     std::vector<Type> numbers_spr(population->n_ages, 1.0);
     Type phi_0 = 0.0;
     phi_0 += numbers_spr[0] *
-             population->proportion_female.get_force_scalar(0) *
+             population->proportion_female_view[0] *
              dq_["proportion_mature_at_age"][0] *
-             population->growth->evaluate(0, population->ages[0]);
+             population->weight_at_age[0];
     for (size_t a = 1; a < (population->n_ages - 1); a++) {
       numbers_spr[a] = numbers_spr[a - 1] * fims_math::exp(-population->M[a]);
       phi_0 += numbers_spr[a] *
-               population->proportion_female.get_force_scalar(a) *
+               population->proportion_female_view[a] *
                dq_["proportion_mature_at_age"][a] *
-               population->growth->evaluate(0, population->ages[a]);
+               population->weight_at_age[a];
     }
 
     numbers_spr[population->n_ages - 1] =
@@ -589,10 +1033,9 @@ class CatchAtAge : public FisheryModelBase<Type> {
         (1 - fims_math::exp(-population->M[population->n_ages - 1]));
     phi_0 +=
         numbers_spr[population->n_ages - 1] *
-        population->proportion_female.get_force_scalar(population->n_ages - 1) *
+        population->proportion_female_view[population->n_ages - 1] *
         dq_["proportion_mature_at_age"][population->n_ages - 1] *
-        population->growth->evaluate(0,
-                                     population->ages[population->n_ages - 1]);
+        population->weight_at_age[population->n_ages - 1];
 
     return phi_0;
   }
@@ -737,7 +1180,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
       fdq_["landings_weight_at_age"][i_age_year] =
           fdq_["landings_numbers_at_age"][i_age_year] *
-          population->growth->evaluate(year, population->ages[age]);
+          population->weight_at_age[i_age_year];
     }
   }
 
@@ -772,8 +1215,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
       fdq_["landings_numbers_at_age"][i_age_year] +=
           (population->fleets[fleet_]->Fmort[year] *
            population->f_multiplier[year] *
-           population->fleets[fleet_]->selectivity->evaluate(
-               population->ages[age], year)) /
+           population->fleets[fleet_]->selectivity_at_age[i_age_year]) /
           pdq_["mortality_Z"][i_age_year] * pdq_["numbers_at_age"][i_age_year] *
           (1 - fims_math::exp(-(pdq_["mortality_Z"][i_age_year])));
     }
@@ -838,9 +1280,8 @@ class CatchAtAge : public FisheryModelBase<Type> {
           this->GetFleetDerivedQuantities(population->fleets[fleet_]->GetId());
 
       fdq_["index_numbers_at_age"][i_age_year] +=
-          (population->fleets[fleet_]->q.get_force_scalar(year) *
-           population->fleets[fleet_]->selectivity->evaluate(
-               population->ages[age], year)) *
+          (population->fleets[fleet_]->q_view[year] *
+           population->fleets[fleet_]->selectivity_at_age[i_age_year]) *
           pdq_["numbers_at_age"][i_age_year];
     }
   }
@@ -869,7 +1310,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
       fdq_["index_weight_at_age"][i_age_year] =
           fdq_["index_numbers_at_age"][i_age_year] *
-          population->growth->evaluate(year, population->ages[age]);
+          population->weight_at_age[i_age_year];
     }
   }
 
@@ -902,7 +1343,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
           // In the future this will have more impact as we implement
           // timing rather than everything occurring at the start of
           // the year.
-          if (fleet->fleet_observed_landings_data_id_m == -999) {
+          if (!fleet->has_landings_data) {
             fdq_["agecomp_expected"][i_age_year] =
                 fdq_["index_numbers_at_age"][i_age_year];
           } else {
@@ -919,7 +1360,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
           // This is need to be re-explored if/when we modify FIMS to
           // allow for composition bins that do not match the population
           // bins.
-          if (fleet->fleet_observed_agecomp_data_id_m != -999) {
+          if (fleet->has_agecomp_data) {
             if (fleet->observed_agecomp_data->at(i_age_year) !=
                 fleet->observed_agecomp_data->na_value) {
               sum_obs += fleet->observed_agecomp_data->at(i_age_year);
@@ -932,7 +1373,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
               fdq_["agecomp_expected"][i_age_year] / sum;
           // robust_add + robust_sum * this->agecomp_expected[i_age_year] / sum;
 
-          if (fleet->fleet_observed_agecomp_data_id_m != -999) {
+          if (fleet->has_agecomp_data) {
             fdq_["agecomp_expected"][i_age_year] =
                 fdq_["agecomp_proportion"][i_age_year] * sum_obs;
           }
@@ -943,6 +1384,11 @@ class CatchAtAge : public FisheryModelBase<Type> {
 
   /**
    * Evaluate the proportion of landings numbers at length.
+   *
+   * @details The expected age composition and the landings and index numbers
+   * at age are projected to length in one fused and blocked matrix product
+   * over the band of length bins of each age, see ProjectAgeToLength() and
+   * Fleet::Initialize().
    */
   void evaluate_length_comp() {
     fleet_iterator fit;
@@ -953,6 +1399,21 @@ class CatchAtAge : public FisheryModelBase<Type> {
       std::shared_ptr<fims_popdy::Fleet<Type>> &fleet = (*fit).second;
 
       if (fleet->n_lengths > 0) {
+        fims::Vector<Type> &lengthcomp_expected = fdq_["lengthcomp_expected"];
+        fims::Vector<Type> &lengthcomp_proportion =
+            fdq_["lengthcomp_proportion"];
+        const Type *const at_age[n_age_to_length_rhs] = {
+            fdq_["agecomp_expected"].data(),
+            fdq_["landings_numbers_at_age"].data(),
+            fdq_["index_numbers_at_age"].data()};
+        Type *const at_length[n_age_to_length_rhs] = {
+            lengthcomp_expected.data(),
+            fdq_["landings_numbers_at_length"].data(),
+            fdq_["index_numbers_at_length"].data()};
+        ProjectAgeToLength(fleet->n_years, fleet->n_ages, fleet->n_lengths,
+                           fleet->age_to_length_conversion.data(),
+                           fleet->age_to_length_band, at_age, at_length);
+
         for (size_t y = 0; y < fleet->n_years; y++) {
           Type sum = static_cast<Type>(0.0);
           Type sum_obs = static_cast<Type>(0.0);
@@ -965,26 +1426,10 @@ class CatchAtAge : public FisheryModelBase<Type> {
           // robust_sum = static_cast<Type>(1.0);
           for (size_t l = 0; l < fleet->n_lengths; l++) {
             size_t i_length_year = y * fleet->n_lengths + l;
-            for (size_t a = 0; a < fleet->n_ages; a++) {
-              size_t i_age_year = y * fleet->n_ages + a;
-              size_t i_length_age = a * fleet->n_lengths + l;
-              fdq_["lengthcomp_expected"][i_length_year] +=
-                  fdq_["agecomp_expected"][i_age_year] *
-                  fleet->age_to_length_conversion[i_length_age];
-
-              fdq_["landings_numbers_at_length"][i_length_year] +=
-                  fdq_["landings_numbers_at_age"][i_age_year] *
-                  fleet->age_to_length_conversion[i_length_age];
-
-              fdq_["index_numbers_at_length"][i_length_year] +=
-                  fdq_["index_numbers_at_age"][i_age_year] *
-                  fleet->age_to_length_conversion[i_length_age];
-            }
-
-            sum += fdq_["lengthcomp_expected"][i_length_year];
+            sum += lengthcomp_expected[i_length_year];
             // robust_sum -= robust_add;
 
-            if (fleet->fleet_observed_lengthcomp_data_id_m != -999) {
+            if (fleet->has_lengthcomp_data) {
               if (fleet->observed_lengthcomp_data->at(i_length_year) !=
                   fleet->observed_lengthcomp_data->na_value) {
                 sum_obs += fleet->observed_lengthcomp_data->at(i_length_year);
@@ -993,13 +1438,13 @@ class CatchAtAge : public FisheryModelBase<Type> {
           }
           for (size_t l = 0; l < fleet->n_lengths; l++) {
             size_t i_length_year = y * fleet->n_lengths + l;
-            fdq_["lengthcomp_proportion"][i_length_year] =
-                fdq_["lengthcomp_expected"][i_length_year] / sum;
+            lengthcomp_proportion[i_length_year] =
+                lengthcomp_expected[i_length_year] / sum;
             // robust_add + robust_sum *
             // this->lengthcomp_expected[i_length_year] / sum;
-            if (fleet->fleet_observed_lengthcomp_data_id_m != -999) {
-              fdq_["lengthcomp_expected"][i_length_year] =
-                  fdq_["lengthcomp_proportion"][i_length_year] * sum_obs;
+            if (fleet->has_lengthcomp_data) {
+              lengthcomp_expected[i_length_year] =
+                  lengthcomp_proportion[i_length_year] * sum_obs;
             }
           }
         }
@@ -1018,7 +1463,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
       std::shared_ptr<fims_popdy::Fleet<Type>> &fleet = (*fit).second;
 
       for (size_t i = 0; i < fdq_["index_numbers"].size(); i++) {
-        if (fleet->observed_index_units == "number") {
+        if (fleet->index_in_numbers) {
           fdq_["index_expected"][i] = fdq_["index_numbers"][i];
         } else {
           fdq_["index_expected"][i] = fdq_["index_weight"][i];
@@ -1039,7 +1484,7 @@ class CatchAtAge : public FisheryModelBase<Type> {
       std::shared_ptr<fims_popdy::Fleet<Type>> &fleet = (*fit).second;
 
       for (size_t i = 0; i < fdq_["landings_weight"].size(); i++) {
-        if (fleet->observed_landings_units == "number") {
+        if (fleet->landings_in_numbers) {
           fdq_["landings_expected"][i] = fdq_["landings_numbers"][i];
         } else {
           fdq_["landings_expected"][i] = fdq_["landings_weight"][i];
@@ -1049,13 +1494,173 @@ class CatchAtAge : public FisheryModelBase<Type> {
     }
   }
 
+  /**
+   * @brief Heap bytes owned by the model, including its report vectors.
+   */
+  virtual size_t OwnedBytes() const {
+    size_t bytes = FisheryModelBase<Type>::OwnedBytes() +
+                   fims::HeapBytes(name_m) + fims::HeapBytes(report_vectors) +
+                   fims::HeapBytes(ages);
+    for (const auto &kv : year_updates) {
+      bytes += sizeof(kv) + fims::NodeOverheadBytes() + kv.second.OwnedBytes();
+    }
+    for (const auto &kv : unfished_trajectories) {
+      bytes += sizeof(kv) + fims::NodeOverheadBytes() + kv.second.OwnedBytes();
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Calculates F_MSY, MSY, spawning biomass at F_MSY, and F_spr at
+   * the biology and selectivity of the last model year.
+   *
+   * @details See Equilibrium for the equations. The results are stored in
+   * the population derived quantities "F_msy", "msy",
+   * "spawning_biomass_msy", and "F_spr".
+   *
+   * @snippet{doc} this param_population
+   */
+  void CalculateReferencePoints(
+      std::shared_ptr<fims_popdy::Population<Type>> &population) {
+    std::map<std::string, fims::Vector<Type>> &dq_ =
+        this->GetPopulationDerivedQuantities(population->GetId());
+    Equilibrium<Type> equilibrium;
+    equilibrium.Setup(population, dq_, population->n_years - 1);
+    ReferencePoints<Type> reference_points =
+        equilibrium.Solve(this->spr_target);
+    const char *names[] = {"F_msy", "msy", "spawning_biomass_msy", "F_spr"};
+    for (const char *name : names) {
+      if (dq_[name].size() != 1) {
+        dq_[name] = fims::Vector<Type>(1);
+      }
+    }
+    dq_["F_msy"][0] = reference_points.F_msy;
+    dq_["msy"][0] = reference_points.msy;
+    dq_["spawning_biomass_msy"][0] = reference_points.spawning_biomass_msy;
+    dq_["F_spr"][0] = reference_points.F_spr;
+  }
+
+  /**
+   * @brief Calculates the population dynamics of all years with the
+   * one-year update of CatchAtAgeYear.
+   *
+   * @details Each year, the numbers at age are completed with recruitment
+   * and summed into biomass and spawning biomass. For years before n_years,
+   * the numbers at age, natural mortality, fishing mortality of each fleet,
+   * and selectivity are staged into the one-year update, which calculates
+   * mortality at age, the numbers at age of the next year, and the landings
+   * numbers at age of each fleet. The remaining landings and index
+   * quantities are then calculated by age as in Evaluate(). The results are
+   * identical to those of the loop over years and ages in Evaluate(), but an
+   * AD tape records the update once and replays it every year, which trades
+   * tape memory for time in the derivative sweeps.
+   *
+   * @snippet{doc} this param_population
+   */
+  void CalculateCheckpointedYears(
+      std::shared_ptr<fims_popdy::Population<Type>> &population,
+      CatchAtAgeTimers &timers) {
+    std::map<std::string, fims::Vector<Type>> &pdq_ =
+        this->GetPopulationDerivedQuantities(population->GetId());
+    const size_t n_ages = population->n_ages;
+    const size_t n_fleets = population->n_fleets;
+    CatchAtAgeYear<Type> &update = this->year_updates[population->GetId()];
+    update.Resize(n_ages, n_fleets);
+
+    for (size_t y = 0; y <= population->n_years; y++) {
+      for (size_t a = 0; a < n_ages; a++) {
+        size_t i_age_year = y * n_ages + a;
+        // ages 1 and older of later years are set by the update of the
+        // previous year
+        if (y == 0) {
+          fims::PhaseAccumulator::Scope timer(timers.numbers);
+          CalculateInitialNumbersAA(population, i_age_year, a);
+          if (a == 0) {
+            pdq_["expected_recruitment"][y] =
+                pdq_["numbers_at_age"][i_age_year];
+          }
+        } else if (a == 0) {
+          fims::PhaseAccumulator::Scope timer(timers.recruitment);
+          CalculateRecruitment(population, i_age_year, y, y);
+        }
+        {
+          fims::PhaseAccumulator::Scope timer(timers.biomass);
+          CalculateBiomass(population, i_age_year, y, a);
+        }
+        {
+          fims::PhaseAccumulator::Scope timer(timers.spawning_biomass);
+          CalculateSpawningBiomass(population, i_age_year, y, a);
+        }
+      }
+
+      if (y < population->n_years) {
+        {
+          fims::PhaseAccumulator::Scope timer(timers.year);
+          const size_t i_year = y * n_ages;
+          for (size_t a = 0; a < n_ages; a++) {
+            update.inputs[a] = pdq_["numbers_at_age"][i_year + a];
+            update.inputs[update.MIndex() + a] = population->M[i_year + a];
+          }
+          for (size_t f = 0; f < n_fleets; f++) {
+            std::shared_ptr<fims_popdy::Fleet<Type>> &fleet =
+                population->fleets[f];
+            update.inputs[update.FleetFIndex() + f] =
+                fleet->Fmort[y] * population->f_multiplier[y];
+            std::copy_n(fleet->selectivity_at_age.data() + i_year, n_ages,
+                        update.inputs.begin() + update.SelectivityIndex(f));
+          }
+
+          update.Evaluate();
+
+          for (size_t a = 0; a < n_ages; a++) {
+            pdq_["mortality_F"][i_year + a] = update.outputs[a];
+            pdq_["mortality_M"][i_year + a] = population->M[i_year + a];
+            pdq_["mortality_Z"][i_year + a] =
+                update.outputs[update.ZIndex() + a];
+          }
+          for (size_t a = 1; a < n_ages; a++) {
+            pdq_["numbers_at_age"][i_year + n_ages + a] =
+                update.outputs[update.NumbersIndex() + a - 1];
+          }
+          for (size_t f = 0; f < n_fleets; f++) {
+            std::map<std::string, fims::Vector<Type>> &fdq_ =
+                this->GetFleetDerivedQuantities(
+                    population->fleets[f]->GetId());
+            for (size_t a = 0; a < n_ages; a++) {
+              fdq_["landings_numbers_at_age"][i_year + a] +=
+                  update.outputs[update.LandingsIndex(f) + a];
+              pdq_["sum_selectivity"][i_year + a] +=
+                  population->fleets[f]->selectivity_at_age[i_year + a];
+            }
+          }
+        }
+        for (size_t a = 0; a < n_ages; a++) {
+          size_t i_age_year = y * n_ages + a;
+          {
+            fims::PhaseAccumulator::Scope timer(timers.landings);
+            CalculateLandingsWeightAA(population, y, a);
+            CalculateLandings(population, y, a);
+          }
+          {
+            fims::PhaseAccumulator::Scope timer(timers.index);
+            CalculateIndexNumbersAA(population, i_age_year, y, a);
+            CalculateIndexWeightAA(population, y, a);
+            CalculateIndex(population, i_age_year, y, a);
+          }
+        }
+      }
+      fims::PhaseAccumulator::Scope timer(timers.spawning_biomass_ratio);
+      CalculateSpawningBiomassRatio(population, y);
+    }
+  }
+
+  /**
+   * @brief Evaluates the population dynamics and the expected values of the
+   * data. Prepare() must be called first, which Model::Evaluate() does
+   * before every evaluation.
+   */
   virtual void Evaluate() {
-    /*
-               Sets derived vectors to zero
-               Performs parameters transformations
-               Sets recruitment deviations to mean 0.
-     */
-    Prepare();
+    const char *type_name = fims::FIMSTimer::TypeName<Type>();
     /*
      start at year=0, age=0;
      here year 0 is the estimated initial population structure and age 0 are
@@ -1073,390 +1678,308 @@ class CatchAtAge : public FisheryModelBase<Type> {
      explicitly referencing the exact date (or period of averaging) at which any
      calculation or output is being made.
      */
+    CatchAtAgeTimers timers(this->GetId(), type_name);
     for (size_t p = 0; p < this->populations.size(); p++) {
       std::shared_ptr<fims_popdy::Population<Type>> &population =
           this->populations[p];
       std::map<std::string, fims::Vector<Type>> &pdq_ =
           this->GetPopulationDerivedQuantities(population->GetId());
       // CAAPopulationProxy<Type>& population = this->populations_proxies[p];
+      {
+        fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                                "CalculateUnfished");
+        CalculateUnfishedTrajectory(population);
+      }
+      {
+        fims::ScopedTimer dynamics_timer("CatchAtAge", this->GetId(), type_name,
+                                         "population_dynamics");
 
-      for (size_t y = 0; y <= population->n_years; y++) {
-        for (size_t a = 0; a < population->n_ages; a++) {
-          /*
-           index naming defines the dimensional folding structure
-           i.e. i_age_year is referencing folding over years and ages.
-           */
-          size_t i_age_year = y * population->n_ages + a;
-          /*
-           Mortality rates are not estimated in the final year which is
-           used to show expected population structure at the end of the model
-           period. This is because biomass in year i represents biomass at the
-           start of the year. Should we add complexity to track more values such
-           as start, mid, and end biomass in all years where, start biomass=end
-           biomass of the previous year? Referenced above, this is probably not
-           worth exploring as later milestone changes will eliminate this
-           confusion.
-           */
-          if (y < population->n_years) {
-            /*
-             First thing we need is total mortality aggregated across all fleets
-             to inform the subsequent catch and change in numbers at age
-             calculations. This is only calculated for years < n_years as these
-             are the model estimated years with data. The year loop extends to
-             y=n_years so that population numbers at age and SSB can be
-             calculated at the end of the last year of the model
-             */
-            CalculateMortality(population, i_age_year, y, a);
-          }
-          CalculateMaturityAA(population, i_age_year, a);
-          /* if statements needed because some quantities are only needed
-          for the first year and/or age, so these steps are included here.
-           */
-          if (y == 0) {
-            // Initial numbers at age is a user input or estimated parameter
-            // vector.
-            CalculateInitialNumbersAA(population, i_age_year, a);
-
-            if (a == 0) {
+        if (this->checkpoint_years) {
+          CalculateCheckpointedYears(population, timers);
+        } else {
+          for (size_t y = 0; y <= population->n_years; y++) {
+            for (size_t a = 0; a < population->n_ages; a++) {
               /*
-             Expected recruitment in year 0 is numbers at age 0 in year 0.
-             */
-              pdq_["expected_recruitment"][y] =
-                  pdq_["numbers_at_age"][i_age_year];
-              pdq_["unfished_numbers_at_age"][i_age_year] =
-                  fims_math::exp(population->recruitment->log_rzero[0]);
-            } else {
-              CalculateUnfishedNumbersAA(population, i_age_year, a - 1, a);
-            }
-
-          } else {
-            if (a == 0) {
-              // Set the nrecruits for age a=0 year y (use pointers instead of
-              // functional returns) assuming fecundity = 1 and 50:50 sex ratio
-              CalculateRecruitment(population, i_age_year, y, y);
-              pdq_["unfished_numbers_at_age"][i_age_year] =
-                  fims_math::exp(population->recruitment->log_rzero[0]);
-            } else {
-              size_t i_agem1_yearm1 = (y - 1) * population->n_ages + (a - 1);
-              CalculateNumbersAA(population, i_age_year, i_agem1_yearm1, a);
-              CalculateUnfishedNumbersAA(population, i_age_year, i_agem1_yearm1,
-                                         a);
-            }
-          }
-
-          /*
-            Fished and unfished biomass vectors are summing biomass at
-            age across ages.
-          */
+               index naming defines the dimensional folding structure
+               i.e. i_age_year is referencing folding over years and ages.
+               */
+              size_t i_age_year = y * population->n_ages + a;
+              /*
+               Mortality rates are not estimated in the final year which is
+               used to show expected population structure at the end of the
+               model period. This is because biomass in year i represents
+               biomass at the start of the year. Should we add complexity to
+               track more values such as start, mid, and end biomass in all
+               years where, start biomass=end biomass of the previous year?
+               Referenced above, this is probably not worth exploring as later
+               milestone changes will eliminate this confusion.
+               */
+              if (y < population->n_years) {
+                /*
+                 First thing we need is total mortality aggregated across all
+                 fleets to inform the subsequent catch and change in numbers
+                 at age calculations. This is only calculated for years <
+                 n_years as these are the model estimated years with data. The
+                 year loop extends to y=n_years so that population numbers at
+                 age and SSB can be calculated at the end of the last year of
+                 the model
+                 */
+                fims::PhaseAccumulator::Scope timer(timers.mortality);
+                CalculateMortality(population, i_age_year, y, a);
+              }
+              /* if statements needed because some quantities are only needed
+              for the first year and/or age, so these steps are included here.
+               */
+              if (y == 0) {
+                fims::PhaseAccumulator::Scope timer(timers.numbers);
+                // Initial numbers at age is a user input or estimated parameter
+                // vector.
+                CalculateInitialNumbersAA(population, i_age_year, a);
+
+                if (a == 0) {
+                  /*
+                 Expected recruitment in year 0 is numbers at age 0 in year 0.
+                 */
+                  pdq_["expected_recruitment"][y] =
+                      pdq_["numbers_at_age"][i_age_year];
+                }
+
+              } else {
+                if (a == 0) {
+                  fims::PhaseAccumulator::Scope timer(timers.recruitment);
+                  // Set the nrecruits for age a=0 year y (use pointers instead
+                  // of functional returns) assuming fecundity = 1 and 50:50 sex
+                  // ratio
+                  CalculateRecruitment(population, i_age_year, y, y);
+                } else {
+                  fims::PhaseAccumulator::Scope timer(timers.numbers);
+                  size_t i_agem1_yearm1 =
+                      (y - 1) * population->n_ages + (a - 1);
+                  CalculateNumbersAA(population, i_age_year, i_agem1_yearm1, a);
+                }
+              }
 
-          CalculateBiomass(population, i_age_year, y, a);
+              /*
+                Biomass vectors are summing biomass at age across ages. The
+                unfished vectors are calculated by
+                CalculateUnfishedTrajectory().
+              */
+              {
+                fims::PhaseAccumulator::Scope timer(timers.biomass);
+                CalculateBiomass(population, i_age_year, y, a);
+              }
 
-          CalculateUnfishedBiomass(population, i_age_year, y, a);
+              /*
+                Spawning biomass vectors are summing biomass at age across ages
+                to allow calculation of recruitment in the next year.
+              */
+              {
+                fims::PhaseAccumulator::Scope timer(timers.spawning_biomass);
+                CalculateSpawningBiomass(population, i_age_year, y, a);
+              }
 
-          /*
-            Fished and unfished spawning biomass vectors are summing biomass at
-            age across ages to allow calculation of recruitment in the next
-            year.
-          */
+              /*
+              Here composition, total catch, and index values are calculated for
+              all years with reference data. They are not calculated for
+              y=n_years as there is this is just to get final population
+              structure at the end of the terminal year.
+               */
+              if (y < population->n_years) {
+                {
+                  fims::PhaseAccumulator::Scope timer(timers.landings);
+                  CalculateLandingsNumbersAA(population, i_age_year, y, a);
+                  CalculateLandingsWeightAA(population, y, a);
+                  CalculateLandings(population, y, a);
+                }
+                {
+                  fims::PhaseAccumulator::Scope timer(timers.index);
+                  CalculateIndexNumbersAA(population, i_age_year, y, a);
+                  CalculateIndexWeightAA(population, y, a);
+                  CalculateIndex(population, i_age_year, y, a);
+                }
+              }
+            }
+            /* Calculate spawning biomass depletion ratio */
+            fims::PhaseAccumulator::Scope timer(timers.spawning_biomass_ratio);
+            CalculateSpawningBiomassRatio(population, y);
+          }
+        }
+      }
+      if (this->calculate_reference_points) {
+        fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                                "reference_points");
+        CalculateReferencePoints(population);
+      }
+    }
+    {
+      fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                              "evaluate_age_comp");
+      evaluate_age_comp();
+    }
+    {
+      fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                              "evaluate_length_comp");
+      evaluate_length_comp();
+    }
+    {
+      fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                              "evaluate_index");
+      evaluate_index();
+    }
+    {
+      fims::ScopedTimer timer("CatchAtAge", this->GetId(), type_name,
+                              "evaluate_landings");
+      evaluate_landings();
+    }
+  }
+#ifdef TMB_MODEL
+  /**
+   * @brief Check if the values of a derived quantity are collected by the
+   * current evaluation, i.e., if they are REPORTed or ADREPORTed.
+   *
+   * @param name The name of the derived quantity.
+   */
+  bool IsCollected(const std::string &name) const {
+    return this->collect_report ||
+           (this->collect_adreport && this->IsAdreported(name));
+  }
 
-          CalculateSpawningBiomass(population, i_age_year, y, a);
+  /**
+   * @brief Copy a derived quantity of each population into a TMB vector.
+   *
+   * @param name The name of the derived quantity.
+   */
+  vector<vector<Type>> PopulationReportValues(const std::string &name) {
+    vector<vector<Type>> x(this->populations.size());
+    for (size_t p = 0; p < this->populations.size(); p++) {
+      if (name == "spawning_biomass_ratio") {
+        x(p) = this->populations[p]->spawning_biomass_ratio.to_tmb();
+      } else {
+        x(p) = this->GetPopulationDerivedQuantities(
+                       this->populations[p]->GetId())[name]
+                   .to_tmb();
+      }
+    }
+    return x;
+  }
 
-          CalculateUnfishedSpawningBiomass(population, i_age_year, y, a);
+  /**
+   * @brief Copy a derived quantity of each fleet into a TMB vector.
+   *
+   * @param name The name of the derived quantity.
+   */
+  vector<vector<Type>> FleetReportValues(const std::string &name) {
+    vector<vector<Type>> x(this->fleets.size());
+    int fleet_idx = 0;
+    fleet_iterator fit;
+    for (fit = this->fleets.begin(); fit != this->fleets.end(); ++fit) {
+      x(fleet_idx) =
+          this->GetFleetDerivedQuantities((*fit).second->GetId())[name]
+              .to_tmb();
+      fleet_idx += 1;
+    }
+    return x;
+  }
 
-          /*
-          Here composition, total catch, and index values are calculated for all
-          years with reference data. They are not calculated for y=n_years as
-          there is this is just to get final population structure at the end of
-          the terminal year.
-           */
-          if (y < population->n_years) {
-            CalculateLandingsNumbersAA(population, i_age_year, y, a);
-            CalculateLandingsWeightAA(population, y, a);
-            CalculateLandings(population, y, a);
+  /**
+   * @brief REPORTs the values of all populations or fleets and ADREPORTs the
+   * selected ones, as far as the current evaluation collects them.
+   *
+   * @param name The name of the derived quantity.
+   * @param x The values of each population or fleet.
+   * @param selected If true, the population or fleet is ADREPORTed.
+   */
+  void ReportValues(const std::string &name, vector<vector<Type>> &x,
+                    const std::vector<bool> &selected) {
+    if (this->collect_report) {
+      FIMS_REPORT_F_(name.c_str(), x, this->of);
+    }
+    if (this->collect_adreport) {
+      this->AdreportSelected(name, x, selected);
+    }
+  }
 
-            CalculateIndexNumbersAA(population, i_age_year, y, a);
-            CalculateIndexWeightAA(population, y, a);
-            CalculateIndex(population, i_age_year, y, a);
-          }
-        }
-        /* Calculate spawning biomass depletion ratio */
-        CalculateSpawningBiomassRatio(population, y);
+  /**
+   * @brief ADREPORTs the values of the selected populations or fleets if the
+   * derived quantity is selected, see SetAdreport().
+   *
+   * @param name The name of the derived quantity.
+   * @param x The values of each population or fleet.
+   * @param selected If true, the population or fleet is ADREPORTed.
+   */
+  void AdreportSelected(const std::string &name, vector<vector<Type>> &x,
+                        const std::vector<bool> &selected) {
+    int n = std::count(selected.begin(), selected.end(), true);
+    if (!this->IsAdreported(name) || n == 0) {
+      return;
+    }
+    vector<vector<Type>> y(n);
+    int j = 0;
+    for (int i = 0; i < x.size(); i++) {
+      if (selected[i]) {
+        y(j++) = x(i);
       }
     }
-    evaluate_age_comp();
-    evaluate_length_comp();
-    evaluate_index();
-    evaluate_landings();
+    vector<Type> values = ADREPORTvector(y);
+    ADREPORT_F_(name.c_str(), values, this->of);
   }
+#endif
   /**
-   * * This method is used to generate TMB reports from the population dynamics
-   * model.
+   * @brief REPORTs and ADREPORTs the derived quantities.
+   *
+   * @details Only the quantities that TMB collects from the current
+   * evaluation are copied, see Model::Evaluate(), so the taped evaluations
+   * only copy the quantities selected with SetAdreport().
    */
   virtual void Report() {
-    int n_fleets = this->fleets.size();
-    int n_pops = this->populations.size();
+    fims::ScopedTimer timer("CatchAtAge", this->GetId(),
+                            fims::FIMSTimer::TypeName<Type>(), "Report");
 #ifdef TMB_MODEL
-    if (this->do_reporting == true) {
+    if (this->do_reporting == true &&
+        (this->collect_report || this->collect_adreport)) {
       report_vectors.clear();
-      // initialize population vectors
-      vector<vector<Type>> biomass_p(n_pops);
-      vector<vector<Type>> expected_recruitment_p(n_pops);
-      vector<vector<Type>> mortality_F_p(n_pops);
-      vector<vector<Type>> mortality_M_p(n_pops);
-      vector<vector<Type>> mortality_Z_p(n_pops);
-      vector<vector<Type>> numbers_at_age_p(n_pops);
-      vector<vector<Type>> proportion_mature_at_age_p(n_pops);
-      vector<vector<Type>> spawning_biomass_p(n_pops);
-      vector<vector<Type>> sum_selectivity_p(n_pops);
-      vector<vector<Type>> total_landings_numbers_p(n_pops);
-      vector<vector<Type>> total_landings_weight_p(n_pops);
-      vector<vector<Type>> unfished_biomass_p(n_pops);
-      vector<vector<Type>> unfished_numbers_at_age_p(n_pops);
-      vector<vector<Type>> unfished_spawning_biomass_p(n_pops);
-      vector<vector<Type>> spawning_biomass_ratio_p(n_pops);
-
-      // initialize fleet vectors
-      vector<vector<Type>> agecomp_expected_f(n_fleets);
-      vector<vector<Type>> agecomp_proportion_f(n_fleets);
-      vector<vector<Type>> index_expected_f(n_fleets);
-      vector<vector<Type>> index_numbers_f(n_fleets);
-      vector<vector<Type>> index_numbers_at_age_f(n_fleets);
-      vector<vector<Type>> index_numbers_at_length_f(n_fleets);
-      vector<vector<Type>> index_weight_f(n_fleets);
-      vector<vector<Type>> index_weight_at_age_f(n_fleets);
-      vector<vector<Type>> landings_expected_f(n_fleets);
-      vector<vector<Type>> landings_numbers_f(n_fleets);
-      vector<vector<Type>> landings_numbers_at_age_f(n_fleets);
-      vector<vector<Type>> landings_numbers_at_length_f(n_fleets);
-      vector<vector<Type>> landings_weight_f(n_fleets);
-      vector<vector<Type>> landings_weight_at_age_f(n_fleets);
-      vector<vector<Type>> lengthcomp_expected_f(n_fleets);
-      vector<vector<Type>> lengthcomp_proportion_f(n_fleets);
-      vector<vector<Type>> log_index_expected_f(n_fleets);
-      vector<vector<Type>> log_landings_expected_f(n_fleets);
-
-      // initiate population index for structuring report out objects
-      int pop_idx = 0;
+      // populations
+      std::vector<bool> population_selected(this->populations.size());
       for (size_t p = 0; p < this->populations.size(); p++) {
-        std::map<std::string, fims::Vector<Type>> &derived_quantities =
-            this->GetPopulationDerivedQuantities(this->populations[p]->GetId());
-        biomass_p(pop_idx) = derived_quantities["biomass"].to_tmb();
-        expected_recruitment_p(pop_idx) =
-            derived_quantities["expected_recruitment"].to_tmb();
-        mortality_F_p(pop_idx) = derived_quantities["mortality_F"].to_tmb();
-        mortality_M_p(pop_idx) = derived_quantities["mortality_M"].to_tmb();
-        mortality_Z_p(pop_idx) = derived_quantities["mortality_Z"].to_tmb();
-        numbers_at_age_p(pop_idx) =
-            derived_quantities["numbers_at_age"].to_tmb();
-        proportion_mature_at_age_p(pop_idx) =
-            derived_quantities["proportion_mature_at_age"].to_tmb();
-        spawning_biomass_p(pop_idx) =
-            derived_quantities["spawning_biomass"].to_tmb();
-        sum_selectivity_p(pop_idx) =
-            derived_quantities["sum_selectivity"].to_tmb();
-        total_landings_numbers_p(pop_idx) =
-            derived_quantities["total_landings_numbers"].to_tmb();
-        total_landings_weight_p(pop_idx) =
-            derived_quantities["total_landings_weight"].to_tmb();
-        unfished_biomass_p(pop_idx) =
-            derived_quantities["unfished_biomass"].to_tmb();
-        unfished_numbers_at_age_p(pop_idx) =
-            derived_quantities["unfished_numbers_at_age"].to_tmb();
-        unfished_spawning_biomass_p(pop_idx) =
-            derived_quantities["unfished_spawning_biomass"].to_tmb();
-        spawning_biomass_ratio_p(pop_idx) =
-            this->populations[pop_idx]->spawning_biomass_ratio.to_tmb();
-
-        pop_idx += 1;
+        population_selected[p] =
+            this->IsAdreportedPopulation(this->populations[p]->GetId());
       }
-
-      // initiate fleet index for structuring report out objects
-      int fleet_idx = 0;
-      fleet_iterator fit;
-      for (fit = this->fleets.begin(); fit != this->fleets.end(); ++fit) {
-        std::shared_ptr<fims_popdy::Fleet<Type>> &fleet = (*fit).second;
-        std::map<std::string, fims::Vector<Type>> &derived_quantities =
-            this->GetFleetDerivedQuantities(fleet->GetId());
-
-        agecomp_expected_f(fleet_idx) =
-            derived_quantities["agecomp_expected"].to_tmb();
-        agecomp_proportion_f(fleet_idx) =
-            derived_quantities["agecomp_proportion"].to_tmb();
-        index_expected_f(fleet_idx) =
-            derived_quantities["index_expected"].to_tmb();
-        index_numbers_f(fleet_idx) =
-            derived_quantities["index_numbers"].to_tmb();
-        index_numbers_at_age_f(fleet_idx) =
-            derived_quantities["index_numbers_at_age"].to_tmb();
-        index_numbers_at_length_f(fleet_idx) =
-            derived_quantities["index_numbers_at_length"].to_tmb();
-        index_weight_f(fleet_idx) = derived_quantities["index_weight"].to_tmb();
-        index_weight_at_age_f(fleet_idx) =
-            derived_quantities["index_weight_at_age"].to_tmb();
-        landings_expected_f(fleet_idx) =
-            derived_quantities["landings_expected"].to_tmb();
-        landings_numbers_f(fleet_idx) =
-            derived_quantities["landings_numbers"].to_tmb();
-        landings_numbers_at_age_f(fleet_idx) =
-            derived_quantities["landings_numbers_at_age"].to_tmb();
-        landings_numbers_at_length_f(fleet_idx) =
-            derived_quantities["landings_numbers_at_length"].to_tmb();
-        landings_weight_f(fleet_idx) =
-            derived_quantities["landings_weight"].to_tmb();
-        landings_weight_at_age_f(fleet_idx) =
-            derived_quantities["landings_weight_at_age"].to_tmb();
-        // length_comp_expected_f(fleet_idx) =
-        // derived_quantities["length_comp_expected"];
-        // length_comp_proportion_f(fleet_idx) =
-        // derived_quantities["length_comp_proportion"];
-        lengthcomp_expected_f(fleet_idx) =
-            derived_quantities["lengthcomp_expected"].to_tmb();
-        lengthcomp_proportion_f(fleet_idx) =
-            derived_quantities["lengthcomp_proportion"].to_tmb();
-        log_index_expected_f(fleet_idx) =
-            derived_quantities["log_index_expected"].to_tmb();
-        log_landings_expected_f(fleet_idx) =
-            derived_quantities["log_landings_expected"].to_tmb();
-        fleet_idx += 1;
+      const std::vector<std::string> &population_names =
+          PopulationReportNames();
+      for (size_t i = 0; i < population_names.size(); i++) {
+        if (this->IsCollected(population_names[i])) {
+          vector<vector<Type>> x = PopulationReportValues(population_names[i]);
+          this->ReportValues(population_names[i], x, population_selected);
+        }
       }
 
-      vector<Type> biomass = ADREPORTvector(biomass_p);
-      vector<Type> expected_recruitment =
-          ADREPORTvector(expected_recruitment_p);
-      vector<Type> mortality_F = ADREPORTvector(mortality_F_p);
-      vector<Type> mortality_M = ADREPORTvector(mortality_M_p);
-      vector<Type> mortality_Z = ADREPORTvector(mortality_Z_p);
-      vector<Type> numbers_at_age = ADREPORTvector(numbers_at_age_p);
-      vector<Type> proportion_mature_at_age =
-          ADREPORTvector(proportion_mature_at_age_p);
-      vector<Type> spawning_biomass = ADREPORTvector(spawning_biomass_p);
-      vector<Type> sum_selectivity = ADREPORTvector(sum_selectivity_p);
-      vector<Type> total_landings_numbers =
-          ADREPORTvector(total_landings_numbers_p);
-      vector<Type> total_landings_weight =
-          ADREPORTvector(total_landings_weight_p);
-      vector<Type> unfished_biomass = ADREPORTvector(unfished_biomass_p);
-      vector<Type> unfished_numbers_at_age =
-          ADREPORTvector(unfished_numbers_at_age_p);
-      vector<Type> unfished_spawning_biomass =
-          ADREPORTvector(unfished_spawning_biomass_p);
-      vector<Type> spawning_biomass_ratio =
-          ADREPORTvector(spawning_biomass_ratio_p);
-
-      vector<Type> agecomp_expected = ADREPORTvector(agecomp_expected_f);
-      vector<Type> agecomp_proportion = ADREPORTvector(agecomp_proportion_f);
-      vector<Type> index_expected = ADREPORTvector(index_expected_f);
-      vector<Type> index_numbers = ADREPORTvector(index_numbers_f);
-      vector<Type> index_numbers_at_age =
-          ADREPORTvector(index_numbers_at_age_f);
-      vector<Type> index_numbers_at_length =
-          ADREPORTvector(index_numbers_at_length_f);
-      vector<Type> index_weight = ADREPORTvector(index_weight_f);
-      vector<Type> index_weight_at_age = ADREPORTvector(index_weight_at_age_f);
-      vector<Type> landings_expected = ADREPORTvector(landings_expected_f);
-      vector<Type> landings_numbers = ADREPORTvector(landings_numbers_f);
-      vector<Type> landings_numbers_at_age =
-          ADREPORTvector(landings_numbers_at_age_f);
-      vector<Type> landings_numbers_at_length =
-          ADREPORTvector(landings_numbers_at_length_f);
-      vector<Type> landings_weight = ADREPORTvector(landings_weight_f);
-      vector<Type> landings_weight_at_age =
-          ADREPORTvector(landings_weight_at_age_f);
-      // vector<Type> length_comp_expected =
-      // ADREPORTvector(length_comp_expected_f); vector<Type>
-      // length_comp_proportion = ADREPORTvector(length_comp_proportion_f);
-      vector<Type> lengthcomp_expected = ADREPORTvector(lengthcomp_expected_f);
-      vector<Type> lengthcomp_proportion =
-          ADREPORTvector(lengthcomp_proportion_f);
-      vector<Type> log_index_expected = ADREPORTvector(log_index_expected_f);
-      vector<Type> log_landings_expected =
-          ADREPORTvector(log_landings_expected_f);
-      // populations
-      // report
-      FIMS_REPORT_F_("biomass", biomass_p, this->of);
-      FIMS_REPORT_F_("expected_recruitment", expected_recruitment_p, this->of);
-      FIMS_REPORT_F_("mortality_F", mortality_F_p, this->of);
-      FIMS_REPORT_F_("mortality_M", mortality_M_p, this->of);
-      FIMS_REPORT_F_("mortality_Z", mortality_Z_p, this->of);
-      FIMS_REPORT_F_("numbers_at_age", numbers_at_age_p, this->of);
-      FIMS_REPORT_F_("proportion_mature_at_age", proportion_mature_at_age_p,
-                     this->of);
-      FIMS_REPORT_F_("spawning_biomass", spawning_biomass_p, this->of);
-      FIMS_REPORT_F_("sum_selectivity", sum_selectivity_p, this->of);
-      FIMS_REPORT_F_("total_landings_numbers", total_landings_numbers_p,
-                     this->of);
-      FIMS_REPORT_F_("total_landings_weight", total_landings_weight_p,
-                     this->of);
-      FIMS_REPORT_F_("unfished_biomass", unfished_biomass_p, this->of);
-      FIMS_REPORT_F_("unfished_numbers_at_age", unfished_numbers_at_age_p,
-                     this->of);
-      FIMS_REPORT_F_("unfished_spawning_biomass", unfished_spawning_biomass_p,
-                     this->of);
-      FIMS_REPORT_F_("spawning_biomass_ratio", spawning_biomass_ratio_p,
-                     this->of);
-
-      // adreport
-      ADREPORT_F(biomass, this->of);
-      ADREPORT_F(expected_recruitment, this->of);
-      ADREPORT_F(mortality_F, this->of);
-      ADREPORT_F(mortality_M, this->of);
-      ADREPORT_F(mortality_Z, this->of);
-      ADREPORT_F(numbers_at_age, this->of);
-      ADREPORT_F(proportion_mature_at_age, this->of);
-      ADREPORT_F(spawning_biomass, this->of);
-      ADREPORT_F(sum_selectivity, this->of);
-      ADREPORT_F(total_landings_numbers, this->of);
-      ADREPORT_F(total_landings_weight, this->of);
-      ADREPORT_F(unfished_biomass, this->of);
-      ADREPORT_F(unfished_numbers_at_age, this->of);
-      ADREPORT_F(unfished_spawning_biomass, this->of);
-      ADREPORT_F(spawning_biomass_ratio, this->of);
+      if (this->calculate_reference_points) {
+        const std::vector<std::string> &reference_point_names =
+            ReferencePointReportNames();
+        for (size_t i = 0; i < reference_point_names.size(); i++) {
+          if (this->IsCollected(reference_point_names[i])) {
+            vector<vector<Type>> x =
+                PopulationReportValues(reference_point_names[i]);
+            this->ReportValues(reference_point_names[i], x,
+                               population_selected);
+          }
+        }
+      }
 
       // fleets
-      // report
-      FIMS_REPORT_F_("agecomp_expected", agecomp_expected_f, this->of);
-      FIMS_REPORT_F_("agecomp_proportion", agecomp_proportion_f, this->of);
-      FIMS_REPORT_F_("index_expected", index_expected_f, this->of);
-      FIMS_REPORT_F_("index_numbers", index_numbers_f, this->of);
-      FIMS_REPORT_F_("index_numbers_at_age", index_numbers_at_age_f, this->of);
-      FIMS_REPORT_F_("index_numbers_at_length", index_numbers_at_length_f,
-                     this->of);
-      FIMS_REPORT_F_("index_weight", index_weight_f, this->of);
-      FIMS_REPORT_F_("index_weight_at_age", index_weight_at_age_f, this->of);
-      FIMS_REPORT_F_("landings_expected", landings_expected_f, this->of);
-      FIMS_REPORT_F_("landings_numbers", landings_numbers_f, this->of);
-      FIMS_REPORT_F_("landings_numbers_at_age", landings_numbers_at_age_f,
-                     this->of);
-      FIMS_REPORT_F_("landings_numbers_at_length", landings_numbers_at_length_f,
-                     this->of);
-      FIMS_REPORT_F_("landings_weight", landings_weight_f, this->of);
-      FIMS_REPORT_F_("landings_weight_at_age", landings_weight_at_age_f,
-                     this->of);
-      FIMS_REPORT_F_("lengthcomp_expected", lengthcomp_expected_f, this->of);
-      FIMS_REPORT_F_("lengthcomp_proportion", lengthcomp_proportion_f,
-                     this->of);
-      FIMS_REPORT_F_("log_index_expected", log_index_expected_f, this->of);
-      FIMS_REPORT_F_("log_landings_expected", log_landings_expected_f,
-                     this->of);
-      // adreport
-      ADREPORT_F(agecomp_expected, this->of);
-      ADREPORT_F(agecomp_proportion, this->of);
-      ADREPORT_F(index_expected, this->of);
-      ADREPORT_F(index_numbers, this->of);
-      ADREPORT_F(index_numbers_at_age, this->of);
-      ADREPORT_F(index_numbers_at_length, this->of);
-      ADREPORT_F(index_weight, this->of);
-      ADREPORT_F(index_weight_at_age, this->of);
-      ADREPORT_F(landings_expected, this->of);
-      ADREPORT_F(landings_numbers, this->of);
-      ADREPORT_F(landings_numbers_at_age, this->of);
-      ADREPORT_F(landings_numbers_at_length, this->of);
-      ADREPORT_F(landings_weight, this->of);
-      ADREPORT_F(landings_weight_at_age, this->of);
-      ADREPORT_F(lengthcomp_expected, this->of);
-      ADREPORT_F(lengthcomp_proportion, this->of);
-      ADREPORT_F(log_index_expected, this->of);
-      ADREPORT_F(log_landings_expected, this->of);
+      std::vector<bool> fleet_selected;
+      fleet_iterator fit;
+      for (fit = this->fleets.begin(); fit != this->fleets.end(); ++fit) {
+        fleet_selected.push_back(
+            this->IsAdreportedFleet((*fit).second->GetId()));
+      }
+      const std::vector<std::string> &fleet_names = FleetReportNames();
+      for (size_t i = 0; i < fleet_names.size(); i++) {
+        if (this->IsCollected(fleet_names[i])) {
+          vector<vector<Type>> x = FleetReportValues(fleet_names[i]);
+          this->ReportValues(fleet_names[i], x, fleet_selected);
+        }
+      }
       std::stringstream var_name;
       typename std::map<std::string, fims::Vector<fims::Vector<Type>>>::iterator
           rvit;
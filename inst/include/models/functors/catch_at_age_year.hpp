@@ -0,0 +1,226 @@
+/**
+ * @file catch_at_age_year.hpp
+ * @brief Declares the one-year update of a catch-at-age population, which an
+ * AD tape records once as a checkpointed atomic function and replays for
+ * every year.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_MODELS_CATCH_AT_AGE_YEAR_HPP
+#define FIMS_MODELS_CATCH_AT_AGE_YEAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "../../common/fims_math.hpp"
+#include "../../common/memory.hpp"
+
+namespace fims_popdy {
+
+/**
+ * @brief Calculates the one-year update of a catch-at-age population, i.e.,
+ * mortality, survival, the plus group, and the landings numbers at age.
+ *
+ * @details The inputs of year \f$y\f$ are, in order, the numbers at age
+ * \f$N_{a,y}\f$, natural mortality at age \f$M_{a,y}\f$, the fishing
+ * mortality \f$F_{f,y} f_y\f$ of each fleet including the F multiplier, and
+ * the selectivity at age \f$S_{f,a,y}\f$ of each fleet. The outputs are, in
+ * order,
+ * \f[
+ * F_{a,y} = \sum_f F_{f,y} f_y S_{f,a,y}, \quad Z_{a,y} = M_{a,y} + F_{a,y},
+ * \f]
+ * the numbers at ages 1 to \f$A\f$ of year \f$y+1\f$,
+ * \f[
+ * N_{a,y+1} = N_{a-1,y} \exp(-Z_{a-1,y}), \quad
+ * N_{A,y+1} = N_{A-1,y} \exp(-Z_{A-1,y}) + N_{A,y} \exp(-Z_{A,y}),
+ * \f]
+ * and the landings numbers at age of each fleet from the Baranov catch
+ * equation,
+ * \f[
+ * C_{f,a,y} = \frac{F_{f,y} f_y S_{f,a,y}}{Z_{a,y}} N_{a,y}
+ * \left(1 - \exp(-Z_{a,y})\right).
+ * \f]
+ * The operations are those of CatchAtAge::CalculateMortality(),
+ * CatchAtAge::CalculateNumbersAA(), and
+ * CatchAtAge::CalculateLandingsNumbersAA() in the same order, so the results
+ * are identical. The update has no branches on values, so one recording is
+ * valid for all years.
+ *
+ * @param n_ages The number of ages.
+ * @param n_fleets The number of fleets.
+ * @param x The inputs.
+ * @param y The outputs.
+ */
+template <typename T>
+void CalculateCatchAtAgeYear(size_t n_ages, size_t n_fleets, const T *x,
+                             T *y) {
+  const T *numbers = x;
+  const T *M = x + n_ages;
+  const T *fleet_F = x + 2 * n_ages;
+  const T *selectivity = fleet_F + n_fleets;
+  T *F = y;
+  T *Z = y + n_ages;
+  T *numbers_next = y + 2 * n_ages;
+  T *landings = numbers_next + (n_ages - 1);
+
+  for (size_t a = 0; a < n_ages; a++) {
+    F[a] = static_cast<T>(0.0);
+    for (size_t f = 0; f < n_fleets; f++) {
+      F[a] += fleet_F[f] * selectivity[f * n_ages + a];
+    }
+    Z[a] = M[a] + F[a];
+  }
+  for (size_t a = 0; a < n_ages; a++) {
+    T survival = fims_math::exp(-Z[a]);
+    if (a + 1 < n_ages) {
+      numbers_next[a] = numbers[a] * survival;
+    } else if (a > 0) {
+      // plus group
+      numbers_next[a - 1] = numbers_next[a - 1] + numbers[a] * survival;
+    }
+    for (size_t f = 0; f < n_fleets; f++) {
+      landings[f * n_ages + a] = (fleet_F[f] * selectivity[f * n_ages + a]) /
+                                 Z[a] * numbers[a] *
+                                 (static_cast<T>(1.0) - survival);
+    }
+  }
+}
+
+#ifdef TMB_MODEL
+/**
+ * @brief Functor that records CalculateCatchAtAgeYear() on a TMBad tape.
+ */
+struct CatchAtAgeYearTape {
+  size_t n_ages;    /**< number of ages */
+  size_t n_fleets;  /**< number of fleets */
+  size_t n_outputs; /**< number of outputs */
+
+  /**
+   * @brief Records the one-year update.
+   *
+   * @param x The inputs.
+   */
+  std::vector<TMBad::ad_aug> operator()(
+      const std::vector<TMBad::ad_aug> &x) const {
+    std::vector<TMBad::ad_aug> y(n_outputs);
+    CalculateCatchAtAgeYear(n_ages, n_fleets, x.data(), y.data());
+    return y;
+  }
+};
+#endif
+
+/**
+ * @brief One-year update of a catch-at-age population with its inputs and
+ * outputs staged in contiguous vectors, see CalculateCatchAtAgeYear().
+ *
+ * @details When the AD model is taped, the update is recorded once into its
+ * own tape, which is converted into an atomic function, and every year adds
+ * a single operation that replays it. The tape of the population dynamics
+ * then grows with the inputs and outputs of each year rather than with all
+ * of its operations, at the cost of replaying the update in each derivative
+ * sweep. The recording only depends on the number of ages and fleets, so it
+ * is kept across tapes. With doubles, the update is calculated directly.
+ */
+template <typename Type>
+class CatchAtAgeYear {
+ public:
+  size_t n_ages = 0;        /**< number of ages */
+  size_t n_fleets = 0;      /**< number of fleets */
+  std::vector<Type> inputs;  /**< inputs of the year */
+  std::vector<Type> outputs; /**< outputs of the year */
+
+  /**
+   * @brief Sizes the inputs and outputs, and drops the recording if the
+   * number of ages or fleets changed.
+   *
+   * @param n_ages The number of ages.
+   * @param n_fleets The number of fleets.
+   */
+  void Resize(size_t n_ages, size_t n_fleets) {
+    if (n_ages != this->n_ages || n_fleets != this->n_fleets) {
+#ifdef TMB_MODEL
+      this->atomic_m.reset();
+#endif
+    }
+    this->n_ages = n_ages;
+    this->n_fleets = n_fleets;
+    this->inputs.resize(2 * n_ages + n_fleets + n_fleets * n_ages);
+    this->outputs.resize(n_ages > 0 ? 3 * n_ages - 1 + n_fleets * n_ages : 0);
+  }
+
+  /** @brief Offset of natural mortality at age in the inputs. */
+  size_t MIndex() const { return n_ages; }
+  /** @brief Offset of the fishing mortality of each fleet in the inputs. */
+  size_t FleetFIndex() const { return 2 * n_ages; }
+  /** @brief Offset of the selectivity of fleet f in the inputs. */
+  size_t SelectivityIndex(size_t f) const {
+    return 2 * n_ages + n_fleets + f * n_ages;
+  }
+  /** @brief Offset of total mortality at age in the outputs. */
+  size_t ZIndex() const { return n_ages; }
+  /** @brief Offset of the numbers at age 1 of the next year in the outputs. */
+  size_t NumbersIndex() const { return 2 * n_ages; }
+  /** @brief Offset of the landings numbers of fleet f in the outputs. */
+  size_t LandingsIndex(size_t f) const {
+    return 3 * n_ages - 1 + f * n_ages;
+  }
+
+  /**
+   * @brief Calculates the outputs from the inputs.
+   */
+  void Evaluate() {
+    if (n_ages == 0) {
+      return;
+    }
+#ifdef TMB_MODEL
+    if constexpr (std::is_same<Type, TMBad::ad_aug>::value) {
+      if (TMBad::get_glob() != NULL) {
+        this->EvaluateAtomic();
+        return;
+      }
+    }
+#endif
+    CalculateCatchAtAgeYear(n_ages, n_fleets, this->inputs.data(),
+                            this->outputs.data());
+  }
+
+  /**
+   * @brief Heap bytes owned by the staged inputs and outputs. The recording
+   * is owned by the tapes that replay it and is not counted.
+   */
+  size_t OwnedBytes() const {
+    return fims::HeapBytes(inputs) + fims::HeapBytes(outputs);
+  }
+
+ private:
+#ifdef TMB_MODEL
+  std::shared_ptr<TMBad::ADFun<>> atomic_m; /**< recording of the update */
+
+  /**
+   * @brief Replays the recording of the update onto the current tape. The
+   * update is recorded at the values of the current inputs, which is valid
+   * for all inputs because it has no branches on values.
+   */
+  void EvaluateAtomic() {
+    if (this->atomic_m == nullptr) {
+      std::vector<double> x(this->inputs.size());
+      for (size_t i = 0; i < x.size(); i++) {
+        x[i] = fims_math::to_double(this->inputs[i]);
+      }
+      this->atomic_m = std::make_shared<TMBad::ADFun<>>(
+          CatchAtAgeYearTape{n_ages, n_fleets, this->outputs.size()}, x);
+      *this->atomic_m = this->atomic_m->atomic();
+    }
+    std::vector<TMBad::ad_aug> y = (*this->atomic_m)(this->inputs);
+    std::copy(y.begin(), y.end(), this->outputs.begin());
+  }
+#endif
+};
+
+}  // namespace fims_popdy
+
+#endif /* FIMS_MODELS_CATCH_AT_AGE_YEAR_HPP */
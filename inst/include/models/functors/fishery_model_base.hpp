@@ -9,9 +9,13 @@
 #ifndef FIMS_MODELS_FISHERY_MODEL_BASE_HPP
 #define FIMS_MODELS_FISHERY_MODEL_BASE_HPP
 
+#include <iomanip>
+#include <sstream>
+
 #include "../../common/model_object.hpp"
 #include "../../common/fims_math.hpp"
 #include "../../common/fims_vector.hpp"
+#include "../../common/timer.hpp"
 #include "../../population_dynamics/population/population.hpp"
 /**
  * @brief The population dynamics of FIMS.
@@ -69,6 +73,96 @@ struct DimensionInfo {
   }
 };
 
+/**
+ * @brief Heap bytes owned by dimension information.
+ */
+inline size_t HeapBytes(const DimensionInfo &x) {
+  return fims::HeapBytes(x.name) + fims::HeapBytes(x.dims) +
+         fims::HeapBytes(x.dim_names) + fims::HeapBytes(x.se_values_m);
+}
+
+/**
+ * @brief Converts a derived quantity and its dimensions to a JSON object
+ * with the name, the dimensionality, and the values, where NaN values are
+ * written as -999.
+ *
+ * @param name The name of the derived quantity.
+ * @param dq The values of the derived quantity.
+ * @param dim_info The dimension information of the derived quantity.
+ * @return std::string
+ */
+inline std::string DerivedQuantityToJson(const std::string &name,
+                                         const fims::Vector<double> &dq,
+                                         const DimensionInfo &dim_info) {
+  std::stringstream ss;
+  ss << "{\n";
+  ss << "\"name\":\"" << name << "\",\n";
+  ss << "\"dimensionality\": {\n";
+  if (dim_info.ndims >= 1 && dim_info.ndims <= 3) {
+    ss << "  \"header\": [";
+    for (int i = 0; i < dim_info.ndims; ++i) {
+      if (i > 0) ss << ", ";
+      ss << "\"" << dim_info.dim_names[i] << "\"";
+    }
+    ss << "],\n";
+    ss << "  \"dimensions\": [";
+    for (size_t i = 0; i < dim_info.dims.size(); ++i) {
+      if (i > 0) ss << ", ";
+      ss << dim_info.dims[i];
+    }
+    ss << "]\n";
+  } else {
+    ss << "  \"header\": [],\n";
+    ss << "  \"dimensions\": []\n";
+  }
+  ss << "},\n";
+  ss << "\"value\":[";
+  ss << std::fixed << std::setprecision(10);
+  for (size_t i = 0; i < dq.size(); i++) {
+    if (i > 0) ss << ", ";
+    if (dq[i] != dq[i]) {  // check for NaN
+      ss << "-999";
+    } else {
+      ss << dq[i];
+    }
+  }
+  ss << "]\n";
+  ss << "}";
+  return ss.str();
+}
+
+/**
+ * @brief Converts the derived quantities of a population or fleet to a
+ * comma-separated list of JSON objects, see DerivedQuantityToJson().
+ *
+ * @details Derived quantities without dimension information are written
+ * with empty dimensions.
+ *
+ * @param dqs The derived quantities by name.
+ * @param dim_info The dimension information by name.
+ * @return std::string
+ */
+inline std::string DerivedQuantitiesToJson(
+    const std::map<std::string, fims::Vector<double>> &dqs,
+    const std::map<std::string, DimensionInfo> &dim_info) {
+  std::stringstream ss;
+  const DimensionInfo none;
+  for (auto it = dqs.begin(); it != dqs.end(); ++it) {
+    if (it != dqs.begin()) ss << ",\n";
+    auto dim_info_it = dim_info.find(it->first);
+    ss << DerivedQuantityToJson(
+        it->first, it->second,
+        dim_info_it != dim_info.end() ? dim_info_it->second : none);
+  }
+  if (!dqs.empty()) ss << "\n";
+  return ss.str();
+}
+
+/**
+ * @brief Types of fishery models, see FisheryModelBase::model_type.
+ */
+enum FisheryModelType { UnknownModelType = 0, CatchAtAgeModelType };
+
 /**
  * @brief FisheryModelBase is a base class for fishery models in FIMS.
  *
@@ -83,12 +177,23 @@ class FisheryModelBase : public fims_model_object::FIMSObject<Type> {
 #ifdef TMB_MODEL
   bool do_reporting =
       true; /*!< flag to control reporting of derived quantities */
+  bool collect_report = true; /*!< true if TMB collects the REPORTed values
+                                 of the current evaluation, set by
+                                 Model::Evaluate() */
+  bool collect_adreport = true; /*!< true if TMB collects the ADREPORTed
+                                   values of the current evaluation, set by
+                                   Model::Evaluate() */
 #endif
   /**
    * @brief A string specifying the model type.
    *
    */
   std::string model_type_m;
+  /**
+   * @brief The model type resolved from model_type_m, so the model type is
+   * checked without comparing strings.
+   */
+  FisheryModelType model_type = UnknownModelType;
   /**
    * @brief Unique identifier for the fishery model.
    *
@@ -172,6 +277,7 @@ class FisheryModelBase : public fims_model_object::FIMSObject<Type> {
    */
   FisheryModelBase(const FisheryModelBase &other)
       : id(other.id),
+        model_type(other.model_type),
         population_ids(other.population_ids),
         populations(other.populations),
         fleet_derived_quantities(other.fleet_derived_quantities),
@@ -185,6 +291,19 @@ class FisheryModelBase : public fims_model_object::FIMSObject<Type> {
    */
   virtual ~FisheryModelBase() {}
 
+  /**
+   * @brief Heap bytes owned by the model, including its derived quantities.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::HeapBytes(model_type_m) + fims::HeapBytes(population_ids) +
+           fims::HeapBytes(populations) + fims::HeapBytes(fleets) +
+           fims::SharedHeapBytes(fleet_derived_quantities) +
+           fims::SharedHeapBytes(population_derived_quantities) +
+           fims::SharedHeapBytes(fleet_dimension_info) +
+           fims::SharedHeapBytes(population_dimension_info);
+  }
+
   /**
    * @brief Get the fleet dimension information.
    *
@@ -0,0 +1,597 @@
+/**
+ * @file projection.hpp
+ * @brief Code to project a catch-at-age model forward in time under a harvest
+ * control rule with stochastic recruitment.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_MODELS_PROJECTION_HPP
+#define FIMS_MODELS_PROJECTION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch_at_age.hpp"
+
+namespace fims_popdy {
+
+/**
+ * @brief Age-specific quantities of the terminal year of a model that are held
+ * constant over the years of a projection.
+ */
+struct ProjectionInputs {
+  size_t n_ages = 0; /**< Number of ages. */
+  std::vector<double> M; /**< Natural mortality at age. */
+  /**
+   * @brief Fishing mortality at age relative to the fully selected age, i.e.,
+   * the combined selectivity of all fleets.
+   */
+  std::vector<double> selectivity;
+  std::vector<double> weight; /**< Weight at age. */
+  /**
+   * @brief Weight at age times proportion female times proportion mature.
+   */
+  std::vector<double> spawning_weight;
+  double phi_0 = 0.0; /**< Unfished spawning biomass per recruit. */
+  /**
+   * @brief Unfished spawning biomass used as the denominator of the spawning
+   * biomass ratio.
+   */
+  double unfished_spawning_biomass = 0.0;
+
+  /**
+   * @brief Calculates landings in weight given numbers at age and the fishing
+   * mortality of the fully selected age using the Baranov catch equation.
+   *
+   * @param numbers_at_age Pointer to the numbers at the first age.
+   * @param stride Distance between the numbers of consecutive ages.
+   * @param F Fishing mortality of the fully selected age.
+   * @param derivative If not NULL, set to the derivative of the landings with
+   * respect to F.
+   * @return double Landings in weight.
+   */
+  double Landings(const double* numbers_at_age, size_t stride, double F,
+                  double* derivative = NULL) const {
+    double landings = 0.0;
+    double d_landings = 0.0;
+    for (size_t a = 0; a < n_ages; a++) {
+      double s = selectivity[a];
+      double Z = M[a] + F * s;
+      double survival = std::exp(-Z);
+      double biomass = weight[a] * numbers_at_age[a * stride];
+      landings += biomass * F * s / Z * (1.0 - survival);
+      d_landings += biomass * s *
+                    (M[a] / (Z * Z) * (1.0 - survival) + F * s / Z * survival);
+    }
+    if (derivative != NULL) {
+      *derivative = d_landings;
+    }
+    return landings;
+  }
+};
+
+/**
+ * @brief Base class for harvest control rules, which set the fishing
+ * mortality of the fully selected age in each year of a projection.
+ *
+ * @details Rules are evaluated concurrently for different replicates, so
+ * evaluate() must not modify the rule.
+ */
+class HarvestControlRuleBase {
+ public:
+  /**
+   * @brief Destroy the Harvest Control Rule Base object.
+   */
+  virtual ~HarvestControlRuleBase() {}
+
+  /**
+   * @brief Calculates the fishing mortality of the fully selected age for one
+   * replicate in one year.
+   *
+   * @param inputs Age-specific quantities of the projection.
+   * @param numbers_at_age Pointer to the numbers at the first age of the
+   * replicate at the start of the year.
+   * @param stride Distance between the numbers of consecutive ages.
+   * @param spawning_biomass_ratio Spawning biomass at the start of the year
+   * divided by unfished spawning biomass.
+   * @return double Fishing mortality of the fully selected age.
+   */
+  virtual double evaluate(const ProjectionInputs& inputs,
+                          const double* numbers_at_age, size_t stride,
+                          double spawning_biomass_ratio) const = 0;
+};
+
+/**
+ * @brief Harvest control rule that applies the same fishing mortality in every
+ * year.
+ */
+class ConstantFishingMortality : public HarvestControlRuleBase {
+ public:
+  double fishing_mortality; /**< Fishing mortality of the fully selected age. */
+
+  /**
+   * @brief Construct a new Constant Fishing Mortality object.
+   *
+   * @param fishing_mortality Fishing mortality of the fully selected age.
+   */
+  explicit ConstantFishingMortality(double fishing_mortality)
+      : fishing_mortality(fishing_mortality) {}
+
+  virtual double evaluate(const ProjectionInputs& inputs,
+                          const double* numbers_at_age, size_t stride,
+                          double spawning_biomass_ratio) const {
+    return this->fishing_mortality;
+  }
+};
+
+/**
+ * @brief Harvest control rule that removes the same landings in weight in every
+ * year.
+ *
+ * @details The fishing mortality that produces the landings is found with a
+ * safeguarded Newton solver on the Baranov catch equation. If the landings
+ * cannot be taken, the fishing mortality is capped at `max_fishing_mortality`.
+ */
+class ConstantLandings : public HarvestControlRuleBase {
+ public:
+  double landings; /**< Landings in weight. */
+  double max_fishing_mortality; /**< Upper bound of the fishing mortality. */
+
+  /**
+   * @brief Construct a new Constant Landings object.
+   *
+   * @param landings Landings in weight.
+   * @param max_fishing_mortality Upper bound of the fishing mortality.
+   */
+  ConstantLandings(double landings, double max_fishing_mortality = 5.0)
+      : landings(landings), max_fishing_mortality(max_fishing_mortality) {}
+
+  virtual double evaluate(const ProjectionInputs& inputs,
+                          const double* numbers_at_age, size_t stride,
+                          double spawning_biomass_ratio) const {
+    if (this->landings <= 0.0) {
+      return 0.0;
+    }
+    double lower = 0.0;
+    double upper = this->max_fishing_mortality;
+    if (inputs.Landings(numbers_at_age, stride, upper) <= this->landings) {
+      return upper;
+    }
+    double F = 0.5 * upper;
+    for (size_t iteration = 0; iteration < 50; iteration++) {
+      double derivative;
+      double difference =
+          inputs.Landings(numbers_at_age, stride, F, &derivative) -
+          this->landings;
+      if (std::fabs(difference) <= 1e-10 * this->landings) {
+        break;
+      }
+      if (difference > 0.0) {
+        upper = F;
+      } else {
+        lower = F;
+      }
+      F -= difference / derivative;
+      // fall back to bisection when Newton leaves the bracket
+      if (!(F > lower && F < upper)) {
+        F = 0.5 * (lower + upper);
+      }
+    }
+    return F;
+  }
+};
+
+/**
+ * @brief Harvest control rule that reduces the fishing mortality linearly when
+ * the spawning biomass ratio falls below a threshold.
+ *
+ * @details The fishing mortality is \f$F_{target}\f$ at or above
+ * `upper_ratio`, zero at or below `lower_ratio`, and
+ * \f$F_{target} \frac{r - r_{lower}}{r_{upper} - r_{lower}}\f$ in between,
+ * where \f$r\f$ is the spawning biomass ratio at the start of the year.
+ */
+class SpawningBiomassRatioRamp : public HarvestControlRuleBase {
+ public:
+  double fishing_mortality; /**< Target fishing mortality. */
+  double lower_ratio; /**< Ratio at or below which there is no fishing. */
+  double upper_ratio; /**< Ratio at or above which the target is applied. */
+
+  /**
+   * @brief Construct a new Spawning Biomass Ratio Ramp object.
+   *
+   * @param fishing_mortality Target fishing mortality.
+   * @param lower_ratio Ratio at or below which there is no fishing.
+   * @param upper_ratio Ratio at or above which the target is applied.
+   */
+  SpawningBiomassRatioRamp(double fishing_mortality, double lower_ratio,
+                           double upper_ratio)
+      : fishing_mortality(fishing_mortality),
+        lower_ratio(lower_ratio),
+        upper_ratio(upper_ratio) {
+    if (!(lower_ratio < upper_ratio)) {
+      throw std::invalid_argument(
+          "SpawningBiomassRatioRamp: lower_ratio must be less than "
+          "upper_ratio.");
+    }
+  }
+
+  virtual double evaluate(const ProjectionInputs& inputs,
+                          const double* numbers_at_age, size_t stride,
+                          double spawning_biomass_ratio) const {
+    if (spawning_biomass_ratio >= this->upper_ratio) {
+      return this->fishing_mortality;
+    }
+    if (spawning_biomass_ratio <= this->lower_ratio) {
+      return 0.0;
+    }
+    return this->fishing_mortality *
+           (spawning_biomass_ratio - this->lower_ratio) /
+           (this->upper_ratio - this->lower_ratio);
+  }
+};
+
+/**
+ * @brief Summary statistics of a projection by year.
+ */
+struct ProjectionSummary {
+  size_t n_years = 0; /**< Number of projected years. */
+  std::vector<double> probabilities; /**< Probabilities of the quantiles. */
+  /**
+   * @brief Mean across replicates of each quantity, indexed by year.
+   */
+  std::map<std::string, std::vector<double>> mean;
+  /**
+   * @brief Quantiles across replicates of each quantity, indexed by
+   * year * probabilities.size() + probability.
+   */
+  std::map<std::string, std::vector<double>> quantiles;
+};
+
+/**
+ * @brief Projects the numbers at age at the end of a catch-at-age model
+ * forward in time under a harvest control rule with lognormal recruitment
+ * deviations.
+ *
+ * @details The state of each replicate is the numbers at age. The states are
+ * stored age by age with the replicates contiguous, so the loops over
+ * replicates within an age vectorize. Each year the replicates are advanced
+ * in one contiguous block per thread and the summary of the year is computed
+ * from the quantities of that year alone, so memory does not grow with the
+ * number of years. The recruitment deviation of a replicate in a year is
+ * drawn from a generator seeded with the seed, the replicate, and the year,
+ * so results do not depend on the number of threads.
+ *
+ * The model has to be evaluated at the parameter values of interest before
+ * Setup() is called. Projections are calculated in double precision and are
+ * intended for the double model, e.g., `CatchAtAge<double>`.
+ */
+template <typename Type>
+class Projection {
+ public:
+  ProjectionInputs inputs; /**< Age-specific quantities of the projection. */
+  /**
+   * @brief Numbers at age at the start of the first projected year.
+   */
+  std::vector<double> initial_numbers_at_age;
+  /**
+   * @brief Recruitment module used for the expected recruitment.
+   */
+  std::shared_ptr<fims_popdy::RecruitmentBase<Type>> recruitment;
+
+  /**
+   * @brief Construct a new Projection object.
+   */
+  Projection() {}
+
+  /**
+   * @brief Copies the terminal state of a population from an evaluated
+   * catch-at-age model.
+   *
+   * @details The numbers at age at the end of the last model year start the
+   * projection. Natural mortality, fishing mortality at age relative to its
+   * maximum, weight, and maturity are taken from the last model year.
+   *
+   * @param model The evaluated catch-at-age model.
+   * @param population_index Index of the population in the model.
+   */
+  void Setup(CatchAtAge<Type>& model, size_t population_index = 0) {
+    if (population_index >= model.populations.size()) {
+      throw std::invalid_argument(
+          "Projection: population " + std::to_string(population_index) +
+          " does not exist in the model.");
+    }
+    std::shared_ptr<fims_popdy::Population<Type>>& population =
+        model.populations[population_index];
+    std::map<std::string, fims::Vector<Type>>& dq_ =
+        model.GetPopulationDerivedQuantities(population->GetId());
+    size_t n_ages = population->n_ages;
+    size_t n_years = population->n_years;
+    if (n_years == 0 || dq_["numbers_at_age"].size() < (n_years + 1) * n_ages) {
+      throw std::invalid_argument(
+          "Projection: the model has to be initialized and evaluated before "
+          "it can be projected.");
+    }
+    size_t last = n_years - 1;
+
+    this->inputs = ProjectionInputs();
+    this->inputs.n_ages = n_ages;
+    this->inputs.M.resize(n_ages);
+    this->inputs.selectivity.resize(n_ages);
+    this->inputs.weight.resize(n_ages);
+    this->inputs.spawning_weight.resize(n_ages);
+    this->initial_numbers_at_age.resize(n_ages);
+
+    double max_F = 0.0;
+    for (size_t a = 0; a < n_ages; a++) {
+      size_t i_age_year = last * n_ages + a;
+      this->inputs.M[a] = fims_math::to_double(population->M[i_age_year]);
+      this->inputs.selectivity[a] =
+          fims_math::to_double(dq_["mortality_F"][i_age_year]);
+      max_F = std::max(max_F, this->inputs.selectivity[a]);
+      this->inputs.weight[a] = fims_math::to_double(
+          population->growth->evaluate(last, population->ages[a]));
+      this->inputs.spawning_weight[a] =
+          this->inputs.weight[a] *
+          fims_math::to_double(
+              population->proportion_female.get_force_scalar(a)) *
+          fims_math::to_double(dq_["proportion_mature_at_age"][i_age_year]);
+      this->initial_numbers_at_age[a] =
+          fims_math::to_double(dq_["numbers_at_age"][n_years * n_ages + a]);
+    }
+    // without fishing in the last year use the summed selectivity of the
+    // fleets instead
+    if (max_F <= 0.0) {
+      for (size_t a = 0; a < n_ages; a++) {
+        this->inputs.selectivity[a] = fims_math::to_double(
+            dq_["sum_selectivity"][last * n_ages + a]);
+        max_F = std::max(max_F, this->inputs.selectivity[a]);
+      }
+    }
+    if (max_F > 0.0) {
+      for (size_t a = 0; a < n_ages; a++) {
+        this->inputs.selectivity[a] /= max_F;
+      }
+    }
+
+    this->inputs.phi_0 = fims_math::to_double(model.CalculateSBPR0(population));
+    this->inputs.unfished_spawning_biomass =
+        fims_math::to_double(dq_["unfished_spawning_biomass"][0]);
+    this->recruitment = population->recruitment;
+  }
+
+  /**
+   * @brief Projects the population forward and summarizes the replicates.
+   *
+   * @details The quantities summarized for each year are
+   * `spawning_biomass` and `spawning_biomass_ratio` at the start of the year,
+   * the fishing mortality of the fully selected age `fishing_mortality`,
+   * `landings_weight`, and `recruitment`, the numbers at the first age at the
+   * start of the year. Recruitment in the following year is the expected
+   * recruitment given spawning biomass times
+   * \f$\exp(\sigma_R \epsilon - \sigma_R^2 / 2)\f$ with a standard normal
+   * \f$\epsilon\f$, so the deviations have a mean of one. Quantiles are
+   * calculated as in the default method of R's `quantile()`.
+   *
+   * @param n_years Number of years to project.
+   * @param n_replicates Number of stochastic replicates.
+   * @param rule Harvest control rule.
+   * @param sigma_recruit Standard deviation of the log recruitment
+   * deviations, where zero gives a deterministic projection.
+   * @param seed Seed of the recruitment deviations.
+   * @param probabilities Probabilities of the quantiles.
+   * @param n_threads Number of threads, where zero uses the number of
+   * hardware threads.
+   * @return ProjectionSummary
+   */
+  ProjectionSummary Run(size_t n_years, size_t n_replicates,
+                        const HarvestControlRuleBase& rule,
+                        double sigma_recruit, uint64_t seed,
+                        const std::vector<double>& probabilities,
+                        size_t n_threads = 0) {
+    if (this->recruitment == nullptr ||
+        this->initial_numbers_at_age.size() != this->inputs.n_ages ||
+        this->inputs.n_ages < 2) {
+      throw std::invalid_argument(
+          "Projection: Setup() has to be called before Run().");
+    }
+    if (n_replicates == 0) {
+      throw std::invalid_argument(
+          "Projection: the number of replicates must be positive.");
+    }
+    for (size_t q = 0; q < probabilities.size(); q++) {
+      if (!(probabilities[q] >= 0.0 && probabilities[q] <= 1.0)) {
+        throw std::invalid_argument(
+            "Projection: probabilities must be between 0 and 1.");
+      }
+    }
+
+    const size_t n_ages = this->inputs.n_ages;
+    const char* names[5] = {"spawning_biomass", "spawning_biomass_ratio",
+                            "fishing_mortality", "landings_weight",
+                            "recruitment"};
+    ProjectionSummary summary;
+    summary.n_years = n_years;
+    summary.probabilities = probabilities;
+    for (size_t k = 0; k < 5; k++) {
+      summary.mean[names[k]].resize(n_years);
+      summary.quantiles[names[k]].resize(n_years * probabilities.size());
+    }
+
+    // numbers_at_age[a * n_replicates + r]
+    std::vector<double> numbers_at_age(n_ages * n_replicates);
+    for (size_t a = 0; a < n_ages; a++) {
+      std::fill(numbers_at_age.begin() + a * n_replicates,
+                numbers_at_age.begin() + (a + 1) * n_replicates,
+                this->initial_numbers_at_age[a]);
+    }
+    // quantities of the current year, values[k][r]
+    std::vector<std::vector<double>> values(
+        5, std::vector<double>(n_replicates));
+
+    if (n_threads == 0) {
+      n_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    n_threads = std::min(n_threads, n_replicates);
+    size_t chunk_size = (n_replicates + n_threads - 1) / n_threads;
+
+    for (size_t year = 0; year < n_years; year++) {
+      auto project_chunk = [&](size_t first, size_t last) {
+        this->ProjectYear(numbers_at_age.data(), n_replicates, first, last,
+                          year, rule, sigma_recruit, seed, values);
+      };
+      if (n_threads == 1) {
+        project_chunk(0, n_replicates);
+      } else {
+        std::vector<std::future<void>> chunks;
+        for (size_t first = 0; first < n_replicates; first += chunk_size) {
+          chunks.push_back(
+              std::async(std::launch::async, project_chunk, first,
+                         std::min(first + chunk_size, n_replicates)));
+        }
+        // get() rethrows any exception thrown on a thread
+        for (size_t i = 0; i < chunks.size(); i++) {
+          chunks[i].get();
+        }
+      }
+
+      for (size_t k = 0; k < 5; k++) {
+        std::vector<double>& x = values[k];
+        double sum = 0.0;
+        for (size_t r = 0; r < n_replicates; r++) {
+          sum += x[r];
+        }
+        summary.mean[names[k]][year] = sum / n_replicates;
+        for (size_t q = 0; q < probabilities.size(); q++) {
+          summary.quantiles[names[k]][year * probabilities.size() + q] =
+              Quantile(x, probabilities[q]);
+        }
+      }
+    }
+    return summary;
+  }
+
+ private:
+  /**
+   * @brief Advances replicates [first, last) by one year and stores the
+   * quantities of the year.
+   */
+  void ProjectYear(double* numbers_at_age, size_t n_replicates, size_t first,
+                   size_t last, size_t year, const HarvestControlRuleBase& rule,
+                   double sigma_recruit, uint64_t seed,
+                   std::vector<std::vector<double>>& values) {
+    const size_t n_ages = this->inputs.n_ages;
+    const ProjectionInputs& in = this->inputs;
+    double* ssb = values[0].data();
+    double* ratio = values[1].data();
+    double* F = values[2].data();
+    double* landings = values[3].data();
+    double* recruits = values[4].data();
+
+    for (size_t r = first; r < last; r++) {
+      ssb[r] = 0.0;
+      landings[r] = 0.0;
+      recruits[r] = numbers_at_age[r];
+    }
+    for (size_t a = 0; a < n_ages; a++) {
+      const double* N = numbers_at_age + a * n_replicates;
+      for (size_t r = first; r < last; r++) {
+        ssb[r] += N[r] * in.spawning_weight[a];
+      }
+    }
+    for (size_t r = first; r < last; r++) {
+      ratio[r] = ssb[r] / in.unfished_spawning_biomass;
+      F[r] = rule.evaluate(in, numbers_at_age + r, n_replicates, ratio[r]);
+    }
+
+    // landings and survival, from the plus group down so that the numbers of
+    // each age are read before they are overwritten by the younger age
+    for (size_t a = n_ages; a-- > 0;) {
+      double* N = numbers_at_age + a * n_replicates;
+      double* N_next = N + n_replicates;
+      for (size_t r = first; r < last; r++) {
+        double Z = in.M[a] + F[r] * in.selectivity[a];
+        double survival = std::exp(-Z);
+        landings[r] += in.weight[a] * N[r] * F[r] * in.selectivity[a] / Z *
+                       (1.0 - survival);
+        if (a == n_ages - 1) {
+          N[r] *= survival;
+        } else if (a == n_ages - 2) {
+          N_next[r] += N[r] * survival;
+        } else {
+          N_next[r] = N[r] * survival;
+        }
+      }
+    }
+
+    for (size_t r = first; r < last; r++) {
+      double expected = fims_math::to_double(this->recruitment->evaluate_mean(
+          static_cast<Type>(ssb[r]), static_cast<Type>(in.phi_0)));
+      double deviation = 1.0;
+      if (sigma_recruit > 0.0) {
+        SplitMix64 generator(seed, r, year);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        deviation = std::exp(sigma_recruit * normal(generator) -
+                             0.5 * sigma_recruit * sigma_recruit);
+      }
+      numbers_at_age[r] = expected * deviation;
+    }
+  }
+
+  /**
+   * @brief A counter-based random number generator, seeded independently for
+   * each replicate and year.
+   */
+  struct SplitMix64 {
+    typedef uint64_t result_type; /**< Type of the generated numbers. */
+    uint64_t state; /**< State of the generator. */
+
+    /**
+     * @brief Construct a new generator for a replicate and year.
+     */
+    SplitMix64(uint64_t seed, uint64_t replicate, uint64_t year)
+        : state(seed) {
+      state = (*this)() ^ replicate;
+      state = (*this)() ^ year;
+    }
+    /** @brief Smallest value generated. */
+    static constexpr result_type min() { return 0; }
+    /** @brief Largest value generated. */
+    static constexpr result_type max() { return UINT64_MAX; }
+    /** @brief Generates the next value. */
+    result_type operator()() {
+      uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+  };
+
+  /**
+   * @brief Calculates a quantile with linear interpolation between order
+   * statistics. Reorders x.
+   */
+  static double Quantile(std::vector<double>& x, double probability) {
+    double h = (x.size() - 1) * probability;
+    size_t lo = static_cast<size_t>(std::floor(h));
+    std::nth_element(x.begin(), x.begin() + lo, x.end());
+    double value = x[lo];
+    if (lo + 1 < x.size() && h > lo) {
+      double next = *std::min_element(x.begin() + lo + 1, x.end());
+      value += (h - lo) * (next - value);
+    }
+    return value;
+  }
+};
+
+}  // namespace fims_popdy
+
+#endif /* FIMS_MODELS_PROJECTION_HPP */
@@ -0,0 +1,485 @@
+/**
+ * @file reference_points.hpp
+ * @brief Code to calculate equilibrium yield and spawning biomass per recruit
+ * and the biological reference points of a catch-at-age model.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_MODELS_REFERENCE_POINTS_HPP
+#define FIMS_MODELS_REFERENCE_POINTS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../common/fims_math.hpp"
+#include "../../population_dynamics/population/population.hpp"
+
+namespace fims_popdy {
+
+/**
+ * @brief A number that carries its first and second derivative with respect
+ * to one variable, i.e., forward-mode automatic differentiation of second
+ * order.
+ *
+ * @details The value and derivatives are of type Type, so derivatives with
+ * respect to fishing mortality are themselves differentiable with respect to
+ * the model parameters when Type is an AD type.
+ */
+template <typename Type>
+struct SecondOrderDual {
+  Type value; /**< Value. */
+  Type d1;    /**< First derivative. */
+  Type d2;    /**< Second derivative. */
+
+  /**
+   * @brief Construct a constant.
+   */
+  SecondOrderDual(const Type &value = Type(0.0))
+      : value(value), d1(Type(0.0)), d2(Type(0.0)) {}
+
+  /**
+   * @brief Construct a number with derivatives.
+   */
+  SecondOrderDual(const Type &value, const Type &d1, const Type &d2)
+      : value(value), d1(d1), d2(d2) {}
+
+  /**
+   * @brief Construct the variable of differentiation.
+   */
+  static SecondOrderDual Variable(const Type &value) {
+    return SecondOrderDual(value, Type(1.0), Type(0.0));
+  }
+
+  /** @brief Addition. */
+  SecondOrderDual operator+(const SecondOrderDual &y) const {
+    return SecondOrderDual(value + y.value, d1 + y.d1, d2 + y.d2);
+  }
+  /** @brief Subtraction. */
+  SecondOrderDual operator-(const SecondOrderDual &y) const {
+    return SecondOrderDual(value - y.value, d1 - y.d1, d2 - y.d2);
+  }
+  /** @brief Negation. */
+  SecondOrderDual operator-() const {
+    return SecondOrderDual(-value, -d1, -d2);
+  }
+  /** @brief Multiplication. */
+  SecondOrderDual operator*(const SecondOrderDual &y) const {
+    return SecondOrderDual(value * y.value, d1 * y.value + value * y.d1,
+                           d2 * y.value + Type(2.0) * d1 * y.d1 +
+                               value * y.d2);
+  }
+  /** @brief Division. */
+  SecondOrderDual operator/(const SecondOrderDual &y) const {
+    Type inverse = Type(1.0) / y.value;
+    SecondOrderDual reciprocal(
+        inverse, -y.d1 * inverse * inverse,
+        (Type(2.0) * y.d1 * y.d1 - y.value * y.d2) * inverse * inverse *
+            inverse);
+    return (*this) * reciprocal;
+  }
+  /** @brief Compound addition. */
+  SecondOrderDual &operator+=(const SecondOrderDual &y) {
+    *this = *this + y;
+    return *this;
+  }
+  /** @brief Compound multiplication. */
+  SecondOrderDual &operator*=(const SecondOrderDual &y) {
+    *this = *this * y;
+    return *this;
+  }
+  /** @brief Compound division. */
+  SecondOrderDual &operator/=(const SecondOrderDual &y) {
+    *this = *this / y;
+    return *this;
+  }
+};
+
+/**
+ * @brief Exponential of a SecondOrderDual.
+ */
+template <typename Type>
+SecondOrderDual<Type> exp(const SecondOrderDual<Type> &x) {
+  Type e = fims_math::exp(x.value);
+  return SecondOrderDual<Type>(e, e * x.d1, e * (x.d2 + x.d1 * x.d1));
+}
+
+/**
+ * @brief Equilibrium quantities over a vector of fishing mortalities.
+ */
+template <typename Type>
+struct EquilibriumGrid {
+  std::vector<double> F; /**< Fishing mortality of the fully selected age. */
+  std::vector<Type> spawning_biomass_per_recruit; /**< SPR. */
+  std::vector<Type> yield_per_recruit; /**< Yield per recruit in weight. */
+  std::vector<Type> recruitment; /**< Equilibrium recruitment. */
+  std::vector<Type> spawning_biomass; /**< Equilibrium spawning biomass. */
+  std::vector<Type> yield; /**< Equilibrium yield in weight. */
+};
+
+/**
+ * @brief Biological reference points of a population.
+ */
+template <typename Type>
+struct ReferencePoints {
+  Type F_msy; /**< Fishing mortality that maximizes equilibrium yield. */
+  Type msy; /**< Maximum sustainable yield. */
+  Type spawning_biomass_msy; /**< Spawning biomass at F_msy, i.e., B_MSY. */
+  /**
+   * @brief Fishing mortality at which spawning biomass per recruit is
+   * spr_target times its unfished value.
+   */
+  Type F_spr;
+  double spr_target; /**< Target ratio of spawning biomass per recruit. */
+};
+
+/**
+ * @brief Equilibrium per-recruit model of a population at the biology and
+ * fishery selectivity of one model year.
+ *
+ * @details For fishing mortality \f$F\f$ of the fully selected age,
+ * \f$Z_a = M_a + F s_a\f$, survivorship is \f$l_0 = 1\f$,
+ * \f$l_a = l_{a-1} \exp(-Z_{a-1})\f$, and \f$l_A\f$ is divided by
+ * \f$1 - \exp(-Z_A)\f$ for the plus group. Then
+ * \f[
+ * SPR(F) = \sum_a l_a w_a p_{female,a} p_{mature,a}, \quad
+ * YPR(F) = \sum_a l_a w_a \frac{F s_a}{Z_a} (1 - \exp(-Z_a)).
+ * \f]
+ *
+ * Unfished spawning biomass per recruit is \f$\phi_0 = SPR(0)\f$ at the
+ * biology of the same year, and it is used both for the target of F_SPR and
+ * for the stock--recruitment relationship. SPR(F) / \f$\phi_0\f$ is then a
+ * ratio at one biology, and the unfished equilibrium recruitment is
+ * \f$R_0\f$. CatchAtAge::CalculateSBPR0(), which the population dynamics
+ * use, is calculated at the biology of the first year, so the two differ
+ * only if natural mortality, weight, or maturity vary by year.
+ *
+ * Equilibrium spawning biomass solves \f$S = SPR(F) g(S)\f$, where \f$g\f$
+ * is RecruitmentBase::evaluate_mean(). The ratio \f$S / g(S)\f$ is linear in
+ * \f$S\f$ for the Beverton--Holt and constant-mean relationships, so it is
+ * found from two evaluations of \f$g\f$ and the solution is exact for both.
+ */
+template <typename Type>
+class Equilibrium {
+ public:
+  std::vector<Type> M; /**< Natural mortality at age. */
+  /**
+   * @brief Fishing mortality at age relative to the fully selected age.
+   */
+  std::vector<Type> selectivity;
+  std::vector<Type> weight; /**< Weight at age. */
+  /**
+   * @brief Weight at age times proportion female times proportion mature.
+   */
+  std::vector<Type> spawning_weight;
+  /**
+   * @brief Unfished spawning biomass per recruit at the biology of the
+   * equilibrium, i.e., the spawning biomass per recruit at F = 0.
+   */
+  Type phi_0 = Type(0.0);
+  /**
+   * @brief Intercept of \f$S / g(S)\f$.
+   */
+  Type alpha = Type(0.0);
+  /**
+   * @brief Slope of \f$S / g(S)\f$.
+   */
+  Type beta = Type(0.0);
+
+  /**
+   * @brief Copies the biology of a model year from an evaluated population.
+   *
+   * @details Weight at age and proportion female are read as resolved by
+   * CatchAtAge::Prepare(), so the population has to be evaluated first.
+   *
+   * @param population The population.
+   * @param derived_quantities The derived quantities of the population.
+   * @param year The model year, usually the last one.
+   */
+  void Setup(std::shared_ptr<fims_popdy::Population<Type>> &population,
+             std::map<std::string, fims::Vector<Type>> &derived_quantities,
+             size_t year) {
+    size_t n_ages = population->n_ages;
+    if (n_ages < 2 || year >= population->n_years) {
+      throw std::invalid_argument(
+          "Equilibrium: the population needs at least two ages and year " +
+          std::to_string(year) + " has to be a model year.");
+    }
+    this->M.resize(n_ages);
+    this->selectivity.resize(n_ages);
+    this->weight.resize(n_ages);
+    this->spawning_weight.resize(n_ages);
+
+    fims::Vector<Type> &F_at_age = derived_quantities["mortality_F"];
+    fims::Vector<Type> &sum_selectivity = derived_quantities["sum_selectivity"];
+    // fishing mortality at age is positive whenever a fleet fishes in the
+    // year, which is fixed by the model structure, so the choice of the
+    // pattern does not depend on parameter values
+    const fims::Vector<Type> *pattern = &F_at_age;
+    double scale = 0.0;
+    for (size_t a = 0; a < n_ages; a++) {
+      scale =
+          std::max(scale, fims_math::to_double(F_at_age[year * n_ages + a]));
+    }
+    if (scale <= 0.0) {
+      pattern = &sum_selectivity;
+      for (size_t a = 0; a < n_ages; a++) {
+        scale = std::max(
+            scale, fims_math::to_double(sum_selectivity[year * n_ages + a]));
+      }
+    }
+    // the fully selected age is the smooth maximum over ages, so it follows
+    // the parameters on an AD tape instead of being fixed when the model is
+    // taped, and the approximation error is relative to the pattern
+    Type C = Type(1e-12 * scale * scale);
+    Type apex = (*pattern)[year * n_ages];
+    for (size_t a = 1; a < n_ages; a++) {
+      apex = fims_math::ad_max(apex, (*pattern)[year * n_ages + a], C);
+    }
+
+    for (size_t a = 0; a < n_ages; a++) {
+      size_t i_age_year = year * n_ages + a;
+      this->M[a] = population->M[i_age_year];
+      this->selectivity[a] = (*pattern)[i_age_year] / apex;
+      this->weight[a] = population->weight_at_age[i_age_year];
+      this->spawning_weight[a] =
+          this->weight[a] * population->proportion_female_view[a] *
+          derived_quantities["proportion_mature_at_age"][i_age_year];
+    }
+
+    Type ypr;
+    this->PerRecruit(Type(0.0), this->phi_0, ypr);
+    Type s_1 = fims_math::exp(population->recruitment->log_rzero[0]) *
+               this->phi_0;
+    Type s_2 = Type(0.5) * s_1;
+    Type k_1 = s_1 / population->recruitment->evaluate_mean(s_1, this->phi_0);
+    Type k_2 = s_2 / population->recruitment->evaluate_mean(s_2, this->phi_0);
+    this->beta = (k_1 - k_2) / (s_1 - s_2);
+    this->alpha = k_1 - this->beta * s_1;
+  }
+
+  /**
+   * @brief Calculates spawning biomass and yield per recruit.
+   *
+   * @tparam T Type or SecondOrderDual<Type>.
+   * @param F Fishing mortality of the fully selected age.
+   * @param spr Spawning biomass per recruit.
+   * @param ypr Yield per recruit in weight.
+   */
+  template <typename T>
+  void PerRecruit(const T &F, T &spr, T &ypr) const {
+    size_t n_ages = this->M.size();
+    T survivorship = T(Type(1.0));
+    spr = T(Type(0.0));
+    ypr = T(Type(0.0));
+    for (size_t a = 0; a < n_ages; a++) {
+      T F_a = F * T(this->selectivity[a]);
+      T Z = T(this->M[a]) + F_a;
+      T survival = Equilibrium::Exp(-Z);
+      if (a == n_ages - 1) {
+        survivorship = survivorship / (T(Type(1.0)) - survival);
+      }
+      spr += survivorship * T(this->spawning_weight[a]);
+      ypr += survivorship * T(this->weight[a]) * F_a / Z *
+             (T(Type(1.0)) - survival);
+      survivorship *= survival;
+    }
+  }
+
+  /**
+   * @brief Calculates equilibrium recruitment given spawning biomass per
+   * recruit.
+   *
+   * @tparam T Type or SecondOrderDual<Type>.
+   * @param spr Spawning biomass per recruit.
+   * @return T Equilibrium recruitment, which is negative when the population
+   * cannot persist.
+   */
+  template <typename T>
+  T Recruitment(const T &spr) const {
+    return (T(Type(1.0)) - T(this->alpha) / spr) / T(this->beta);
+  }
+
+  /**
+   * @brief Calculates equilibrium yield given fishing mortality.
+   *
+   * @tparam T Type or SecondOrderDual<Type>.
+   * @param F Fishing mortality of the fully selected age.
+   * @return T Equilibrium yield in weight.
+   */
+  template <typename T>
+  T Yield(const T &F) const {
+    T spr, ypr;
+    this->PerRecruit(F, spr, ypr);
+    return ypr * this->Recruitment(spr);
+  }
+
+  /**
+   * @brief Evaluates the per-recruit and equilibrium quantities over a grid
+   * of fishing mortalities in one pass over ages.
+   *
+   * @details The loops over the grid are innermost so that they vectorize
+   * when Type is double.
+   *
+   * @param F Fishing mortalities of the fully selected age.
+   * @return EquilibriumGrid<Type>
+   */
+  EquilibriumGrid<Type> Evaluate(const std::vector<double> &F) const {
+    size_t n_ages = this->M.size();
+    size_t n = F.size();
+    EquilibriumGrid<Type> grid;
+    grid.F = F;
+    grid.spawning_biomass_per_recruit.assign(n, Type(0.0));
+    grid.yield_per_recruit.assign(n, Type(0.0));
+    grid.recruitment.resize(n);
+    grid.spawning_biomass.resize(n);
+    grid.yield.resize(n);
+    std::vector<Type> survivorship(n, Type(1.0));
+    for (size_t a = 0; a < n_ages; a++) {
+      for (size_t i = 0; i < n; i++) {
+        Type F_a = Type(F[i]) * this->selectivity[a];
+        Type Z = this->M[a] + F_a;
+        Type survival = fims_math::exp(-Z);
+        if (a == n_ages - 1) {
+          survivorship[i] = survivorship[i] / (Type(1.0) - survival);
+        }
+        grid.spawning_biomass_per_recruit[i] +=
+            survivorship[i] * this->spawning_weight[a];
+        grid.yield_per_recruit[i] +=
+            survivorship[i] * this->weight[a] * F_a / Z *
+            (Type(1.0) - survival);
+        survivorship[i] = survivorship[i] * survival;
+      }
+    }
+    for (size_t i = 0; i < n; i++) {
+      grid.recruitment[i] =
+          this->Recruitment(grid.spawning_biomass_per_recruit[i]);
+      grid.spawning_biomass[i] =
+          grid.recruitment[i] * grid.spawning_biomass_per_recruit[i];
+      grid.yield[i] = grid.recruitment[i] * grid.yield_per_recruit[i];
+    }
+    return grid;
+  }
+
+  /**
+   * @brief Calculates F_MSY, MSY, B_MSY, and F_SPR.
+   *
+   * @details Starting values are the best points of a grid of fishing
+   * mortalities evaluated in double precision. Each is then refined with a
+   * fixed number of Newton iterations, where the first and second derivatives
+   * with respect to fishing mortality come from SecondOrderDual. F_MSY solves
+   * \f$dY/dF = 0\f$ and F_SPR solves \f$SPR(F) / \phi_0 = x\f$. The
+   * iterations are on \f$\log F\f$, which keeps \f$F\f$ positive without a
+   * branch on its value. Because the number of iterations is fixed and there
+   * are no branches, the reference points are smooth functions of the
+   * parameters, an AD tape is valid for all parameter values, and they can be
+   * reported with uncertainty.
+   *
+   * @param spr_target The target ratio \f$x\f$ of spawning biomass per
+   * recruit, e.g., 0.4 for F_40%.
+   * @param max_F Upper bound of the grid of starting values.
+   * @param n_grid Number of points in the grid of starting values.
+   * @param n_newton Number of Newton iterations.
+   * @return ReferencePoints<Type>
+   */
+  ReferencePoints<Type> Solve(double spr_target, double max_F = 3.0,
+                              size_t n_grid = 301, size_t n_newton = 8) const {
+    if (!(spr_target > 0.0 && spr_target < 1.0)) {
+      throw std::invalid_argument(
+          "Equilibrium: spr_target must be between 0 and 1.");
+    }
+    typedef SecondOrderDual<Type> Dual;
+
+    // starting values from a grid evaluated without derivatives
+    Equilibrium<double> approximate;
+    approximate.M = this->ToDouble(this->M);
+    approximate.selectivity = this->ToDouble(this->selectivity);
+    approximate.weight = this->ToDouble(this->weight);
+    approximate.spawning_weight = this->ToDouble(this->spawning_weight);
+    approximate.phi_0 = fims_math::to_double(this->phi_0);
+    approximate.alpha = fims_math::to_double(this->alpha);
+    approximate.beta = fims_math::to_double(this->beta);
+    std::vector<double> F_grid(n_grid);
+    for (size_t i = 0; i < n_grid; i++) {
+      F_grid[i] = max_F * (i + 1) / n_grid;
+    }
+    EquilibriumGrid<double> grid = approximate.Evaluate(F_grid);
+    size_t i_msy = 0;
+    size_t i_spr = 0;
+    for (size_t i = 0; i < n_grid; i++) {
+      if (grid.yield[i] > grid.yield[i_msy]) {
+        i_msy = i;
+      }
+      if (std::fabs(grid.spawning_biomass_per_recruit[i] / approximate.phi_0 -
+                    spr_target) <
+          std::fabs(grid.spawning_biomass_per_recruit[i_spr] /
+                        approximate.phi_0 -
+                    spr_target)) {
+        i_spr = i;
+      }
+    }
+
+    ReferencePoints<Type> out;
+    out.spr_target = spr_target;
+
+    // the derivative of h(F) with respect to log F is F dh/dF
+    Type log_F = fims_math::log(Type(F_grid[i_msy]));
+    Type F = Type(F_grid[i_msy]);
+    for (size_t k = 0; k < n_newton; k++) {
+      Dual yield = this->Yield(Dual::Variable(F));
+      log_F = log_F - yield.d1 / (F * yield.d2);
+      F = fims_math::exp(log_F);
+    }
+    out.F_msy = F;
+    Type spr, ypr;
+    this->PerRecruit(F, spr, ypr);
+    Type recruitment = this->Recruitment(spr);
+    out.msy = ypr * recruitment;
+    out.spawning_biomass_msy = spr * recruitment;
+
+    log_F = fims_math::log(Type(F_grid[i_spr]));
+    F = Type(F_grid[i_spr]);
+    for (size_t k = 0; k < n_newton; k++) {
+      Dual spr_F, ypr_F;
+      this->PerRecruit(Dual::Variable(F), spr_F, ypr_F);
+      log_F = log_F - (spr_F.value - Type(spr_target) * this->phi_0) /
+                          (F * spr_F.d1);
+      F = fims_math::exp(log_F);
+    }
+    out.F_spr = F;
+    return out;
+  }
+
+ private:
+  /**
+   * @brief Exponential of a scalar.
+   */
+  static Type Exp(const Type &x) { return fims_math::exp(x); }
+
+  /**
+   * @brief Exponential of a SecondOrderDual.
+   */
+  static SecondOrderDual<Type> Exp(const SecondOrderDual<Type> &x) {
+    return fims_popdy::exp(x);
+  }
+
+  /**
+   * @brief Converts a vector of Type to double.
+   */
+  static std::vector<double> ToDouble(const std::vector<Type> &x) {
+    std::vector<double> out(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+      out[i] = fims_math::to_double(x[i]);
+    }
+    return out;
+  }
+};
+
+}  // namespace fims_popdy
+
+#endif /* FIMS_MODELS_REFERENCE_POINTS_HPP */
@@ -0,0 +1,250 @@
+/**
+ * @file age_to_length.hpp
+ * @brief Declares the kernel that projects quantities at age to quantities
+ * at length with the age-to-length conversion matrix of a fleet.
+ * @copyright This file is part of the NOAA, National Marine Fisheries Service
+ * Fisheries Integrated Modeling System project. See LICENSE in the source
+ * folder for reuse information.
+ */
+#ifndef FIMS_POPULATION_DYNAMICS_FLEET_AGE_TO_LENGTH_HPP
+#define FIMS_POPULATION_DYNAMICS_FLEET_AGE_TO_LENGTH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../../common/fims_math.hpp"
+#include "../../common/memory.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FIMS_AGE_TO_LENGTH_SSE2
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FIMS_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define FIMS_RESTRICT __restrict
+#else
+#define FIMS_RESTRICT
+#endif
+
+namespace fims_popdy {
+
+/**
+ * @brief Number of right-hand sides of the age-to-length projection, i.e.,
+ * the expected age composition, the landings numbers at age, and the index
+ * numbers at age.
+ */
+const size_t n_age_to_length_rhs = 3;
+
+/**
+ * @brief Number of years in a block of the age-to-length projection. The
+ * rows of a block of the conversion matrix are reused for all years of a
+ * block while they are in cache.
+ */
+const size_t age_to_length_year_block = 8;
+
+/**
+ * @brief Number of length bins in a block of the age-to-length projection,
+ * chosen so a block of the conversion matrix and of the outputs of a year
+ * stay in the level 1 and level 2 caches.
+ */
+const size_t age_to_length_length_block = 64;
+
+/**
+ * @brief Band of length bins with non-negligible probability for each age of
+ * an age-to-length conversion matrix.
+ *
+ * @details For realistic growth, each age only has non-negligible
+ * probability in a narrow band of length bins. The band stores the first
+ * length bin and the number of length bins of each age, so the projection
+ * only reads the entries within the bands. The entries are read in place
+ * from the conversion matrix, so estimated entries stay linked to their
+ * parameters. An empty band projects all length bins of every age.
+ */
+struct AgeToLengthBand {
+  std::vector<size_t> first; /**< first length bin of each age */
+  std::vector<size_t> size;  /**< number of length bins of each age */
+
+  /**
+   * @brief Number of entries of the conversion matrix within the bands.
+   */
+  size_t NonZeros() const {
+    size_t n = 0;
+    for (size_t a = 0; a < size.size(); a++) {
+      n += size[a];
+    }
+    return n;
+  }
+
+  /**
+   * @brief Heap bytes owned by the band.
+   */
+  size_t OwnedBytes() const {
+    return fims::HeapBytes(first) + fims::HeapBytes(size);
+  }
+};
+
+/**
+ * @brief Finds the band of length bins of each age of a conversion matrix.
+ *
+ * @details The leading and trailing entries of each age whose absolute value
+ * is at most the tolerance are pruned, where entries within the band are
+ * kept. A negative tolerance keeps all entries.
+ *
+ * @param conversion The n_ages by n_lengths conversion matrix.
+ * @param n_ages The number of ages.
+ * @param n_lengths The number of length bins.
+ * @param tolerance The largest absolute value of a pruned entry.
+ * @return The band of each age.
+ */
+template <typename Type>
+AgeToLengthBand MakeAgeToLengthBand(const Type *conversion, size_t n_ages,
+                                    size_t n_lengths, double tolerance) {
+  AgeToLengthBand band;
+  band.first.resize(n_ages);
+  band.size.resize(n_ages);
+  for (size_t a = 0; a < n_ages; a++) {
+    const Type *row = conversion + a * n_lengths;
+    size_t first = 0;
+    size_t last = n_lengths;
+    while (first < last &&
+           std::fabs(fims_math::to_double(row[first])) <= tolerance) {
+      first++;
+    }
+    while (last > first &&
+           std::fabs(fims_math::to_double(row[last - 1])) <= tolerance) {
+      last--;
+    }
+    band.first[a] = first;
+    band.size[a] = last - first;
+  }
+  return band;
+}
+
+/**
+ * @brief Accumulates one row of the conversion matrix, scaled by the value
+ * at age of each right-hand side, into the values at length of a year.
+ *
+ * @param row The length bins l0 to l1 of the row of one age.
+ * @param x The value at age of each right-hand side.
+ * @param out The length bins l0 to l1 of each output in the year.
+ * @param n The number of length bins.
+ */
+template <typename Type>
+inline void AccumulateAgeToLengthRow(const Type *row,
+                                     const Type (&x)[n_age_to_length_rhs],
+                                     Type *const (&out)[n_age_to_length_rhs],
+                                     size_t n) {
+  for (size_t l = 0; l < n; l++) {
+    out[0][l] += x[0] * row[l];
+    out[1][l] += x[1] * row[l];
+    out[2][l] += x[2] * row[l];
+  }
+}
+
+/**
+ * @brief Accumulates one row of the conversion matrix for doubles, two
+ * length bins per SSE2 instruction where it is available. The outputs do not
+ * alias the row, so the remaining bins are vectorized by the compiler.
+ *
+ * @param row The length bins l0 to l1 of the row of one age.
+ * @param x The value at age of each right-hand side.
+ * @param out The length bins l0 to l1 of each output in the year.
+ * @param n The number of length bins.
+ */
+template <>
+inline void AccumulateAgeToLengthRow<double>(
+    const double *row, const double (&x)[n_age_to_length_rhs],
+    double *const (&out)[n_age_to_length_rhs], size_t n) {
+  const double *FIMS_RESTRICT r = row;
+  double *FIMS_RESTRICT out0 = out[0];
+  double *FIMS_RESTRICT out1 = out[1];
+  double *FIMS_RESTRICT out2 = out[2];
+  size_t l = 0;
+#ifdef FIMS_AGE_TO_LENGTH_SSE2
+  const __m128d x0 = _mm_set1_pd(x[0]);
+  const __m128d x1 = _mm_set1_pd(x[1]);
+  const __m128d x2 = _mm_set1_pd(x[2]);
+  for (; l + 2 <= n; l += 2) {
+    const __m128d c = _mm_loadu_pd(r + l);
+    _mm_storeu_pd(out0 + l, _mm_add_pd(_mm_loadu_pd(out0 + l),
+                                       _mm_mul_pd(x0, c)));
+    _mm_storeu_pd(out1 + l, _mm_add_pd(_mm_loadu_pd(out1 + l),
+                                       _mm_mul_pd(x1, c)));
+    _mm_storeu_pd(out2 + l, _mm_add_pd(_mm_loadu_pd(out2 + l),
+                                       _mm_mul_pd(x2, c)));
+  }
+#endif
+  for (; l < n; l++) {
+    out0[l] += x[0] * r[l];
+    out1[l] += x[1] * r[l];
+    out2[l] += x[2] * r[l];
+  }
+}
+
+/**
+ * @brief Projects quantities at age to quantities at length for all years.
+ *
+ * @details Computes, for each right-hand side \f$r\f$, year \f$y\f$, and
+ * length bin \f$l\f$,
+ * \f[
+ * Y^r_{y,l} \mathrel{+}= \sum_a X^r_{y,a} \times C_{a,l},
+ * \f]
+ * as one matrix product with three right-hand sides, where \f$C\f$ is the
+ * conversion matrix stored by age with contiguous length bins. Only the
+ * entries within the band of each age are multiplied, so the pruned entries
+ * neither cost time nor add to the AD tape. The products are blocked by
+ * years and length bins, so each block of \f$C\f$ is read once per block of
+ * years rather than once per year and output. For each output, the ages are
+ * summed in the same order as a loop over ages, so the results do not
+ * depend on the blocking.
+ *
+ * @param n_years The number of years.
+ * @param n_ages The number of ages.
+ * @param n_lengths The number of length bins.
+ * @param conversion The n_ages by n_lengths conversion matrix.
+ * @param band The band of length bins of each age, see
+ * MakeAgeToLengthBand(), or an empty band for all length bins.
+ * @param at_age The n_years by n_ages values at age of each right-hand side.
+ * @param at_length The n_years by n_lengths values at length of each
+ * right-hand side, which are accumulated into.
+ */
+template <typename Type>
+void ProjectAgeToLength(size_t n_years, size_t n_ages, size_t n_lengths,
+                        const Type *conversion, const AgeToLengthBand &band,
+                        const Type *const (&at_age)[n_age_to_length_rhs],
+                        Type *const (&at_length)[n_age_to_length_rhs]) {
+  const bool dense = band.first.empty();
+  for (size_t y0 = 0; y0 < n_years; y0 += age_to_length_year_block) {
+    size_t y1 = std::min(y0 + age_to_length_year_block, n_years);
+    for (size_t l0 = 0; l0 < n_lengths; l0 += age_to_length_length_block) {
+      size_t l1 = std::min(l0 + age_to_length_length_block, n_lengths);
+      for (size_t y = y0; y < y1; y++) {
+        for (size_t a = 0; a < n_ages; a++) {
+          size_t first = dense ? l0 : std::max(l0, band.first[a]);
+          size_t last =
+              dense ? l1 : std::min(l1, band.first[a] + band.size[a]);
+          if (first >= last) {
+            continue;
+          }
+          const Type x[n_age_to_length_rhs] = {at_age[0][y * n_ages + a],
+                                               at_age[1][y * n_ages + a],
+                                               at_age[2][y * n_ages + a]};
+          Type *const out[n_age_to_length_rhs] = {
+              at_length[0] + y * n_lengths + first,
+              at_length[1] + y * n_lengths + first,
+              at_length[2] + y * n_lengths + first};
+          AccumulateAgeToLengthRow(conversion + a * n_lengths + first, x, out,
+                                   last - first);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace fims_popdy
+
+#endif /* FIMS_POPULATION_DYNAMICS_FLEET_AGE_TO_LENGTH_HPP */
@@ -14,6 +14,7 @@
 #include "../../common/model_object.hpp"
 #include "../../distributions/distributions.hpp"
 #include "../selectivity/selectivity.hpp"
+#include "age_to_length.hpp"
 
 namespace fims_popdy {
 
@@ -39,6 +40,10 @@ struct Fleet : public fims_model_object::FIMSObject<Type> {
       observed_landings_data; /*!< observed landings data*/
 
   std::string observed_landings_units; /*!< is this fleet landings in weight*/
+  bool landings_in_numbers = false; /*!< true if the landings are in
+    numbers, resolved from observed_landings_units in Initialize() */
+  bool has_landings_data = false; /*!< true if the fleet has landings data,
+    resolved in Initialize() */
 
   // index data
   int fleet_observed_index_data_id_m = -999; /*!< id of index data */
@@ -46,16 +51,22 @@ struct Fleet : public fims_model_object::FIMSObject<Type> {
       observed_index_data; /*!< observed index data*/
 
   std::string observed_index_units; /*!< is this fleet index in weight*/
+  bool index_in_numbers = false; /*!< true if the index is in numbers,
+    resolved from observed_index_units in Initialize() */
 
   // age comp data
   int fleet_observed_agecomp_data_id_m = -999; /*!< id of age comp data */
   std::shared_ptr<fims_data_object::DataObject<Type>>
       observed_agecomp_data; /*!< observed agecomp data*/
+  bool has_agecomp_data = false; /*!< true if the fleet has age comp data,
+    resolved in Initialize() */
 
   // length comp data
   int fleet_observed_lengthcomp_data_id_m = -999; /*!< id of length comp data */
   std::shared_ptr<fims_data_object::DataObject<Type>>
       observed_lengthcomp_data; /*!< observed lengthcomp data*/
+  bool has_lengthcomp_data = false; /*!< true if the fleet has length comp
+    data, resolved in Initialize() */
 
   // Mortality and catchability
   fims::Vector<Type>
@@ -66,9 +77,18 @@ struct Fleet : public fims_model_object::FIMSObject<Type> {
   fims::Vector<Type> Fmort; /*!< transformed parameter: Fishing mortality*/
   fims::Vector<Type>
       q; /*!< transformed parameter: the catchability of the fleet */
+  fims::StridedView<Type> q_view; /*!< catchability by year as a strided
+    view, resolved once per evaluation */
+  fims::Vector<Type> selectivity_at_age; /*!< selectivity at age by year,
+    evaluated once per block of years of the selectivity module */
 
   fims::Vector<Type> age_to_length_conversion; /*!<derived quantity age to
                                                 length conversion matrix*/
+  double age_to_length_tolerance = 0.0; /*!< largest absolute value of an
+    entry of the age to length conversion matrix that is pruned from the
+    projection, where a negative value keeps all entries */
+  AgeToLengthBand age_to_length_band; /*!< band of length bins of each age of
+    the age to length conversion matrix, resolved in Initialize() */
 
   /**
    * @brief Constructor.
@@ -78,11 +98,48 @@ struct Fleet : public fims_model_object::FIMSObject<Type> {
     this->register_self(this->id);
   }
 
+  /**
+   * @brief Heap bytes owned by the fleet.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::HeapBytes(observed_landings_units) +
+           fims::HeapBytes(observed_index_units) + fims::HeapBytes(log_Fmort) +
+           fims::HeapBytes(log_q) + fims::HeapBytes(Fmort) +
+           fims::HeapBytes(q) + fims::HeapBytes(selectivity_at_age) +
+           fims::HeapBytes(age_to_length_conversion) +
+           age_to_length_band.OwnedBytes();
+  }
+
   /**
    * @brief Destructor.
    */
   virtual ~Fleet() {}
 
+  /**
+   * @brief Initialize the fleet module. Called once when the model is
+   * created, and used to resolve the units of the observed data and the ids
+   * of the optional data into booleans, so the evaluation does not compare
+   * strings or sentinel ids. The band of length bins of each age of the age
+   * to length conversion matrix is also found here, so the projection to
+   * length skips the entries that are pruned by age_to_length_tolerance.
+   */
+  void Initialize() {
+    this->landings_in_numbers = this->observed_landings_units == "number";
+    this->index_in_numbers = this->observed_index_units == "number";
+    this->has_landings_data = this->fleet_observed_landings_data_id_m != -999;
+    this->has_agecomp_data = this->fleet_observed_agecomp_data_id_m != -999;
+    this->has_lengthcomp_data =
+        this->fleet_observed_lengthcomp_data_id_m != -999;
+    this->age_to_length_band = AgeToLengthBand();
+    if (this->n_lengths > 0 && this->age_to_length_conversion.size() ==
+                                   this->n_ages * this->n_lengths) {
+      this->age_to_length_band = MakeAgeToLengthBand(
+          this->age_to_length_conversion.data(), this->n_ages,
+          this->n_lengths, this->age_to_length_tolerance);
+    }
+  }
+
   /**
    * @brief Prepare to run the fleet module. Called at each model
    * iteration, and used to exponentiate the natural log of q and Fmort
@@ -35,6 +35,13 @@ struct EWAAGrowth : public GrowthBase<Type> {
 
   virtual ~EWAAGrowth() {}
 
+  /**
+   * @brief Heap bytes owned by the growth module.
+   */
+  virtual size_t OwnedBytes() const {
+    return GrowthBase<Type>::OwnedBytes() + fims::HeapBytes(ewaa);
+  }
+
   /**
    * @brief Returns the weight at age a (in kg) from the input vector.
    *
@@ -44,6 +51,23 @@ struct EWAAGrowth : public GrowthBase<Type> {
   virtual const Type evaluate(int year, const double& a) {
     return this->ewaa[year][a];
   }
+
+  /**
+   * @brief Returns the weight at a vector of ages (in kg) with one lookup
+   * of the year.
+   *
+   * @param ages The ages of the fish, the age vector must start at zero.
+   * @param n The number of ages.
+   * @param year year
+   * @param out The weight at each age, of length n.
+   */
+  virtual void evaluate_ages(const double* ages, size_t n, size_t year,
+                             Type* out) {
+    std::map<double, double>& weights = this->ewaa[static_cast<int>(year)];
+    for (size_t i = 0; i < n; i++) {
+      out[i] = weights[ages[i]];
+    }
+  }
 };
 }  // namespace fims_popdy
 #endif /* POPULATION_DYNAMICS_GROWTH_EWAA_HPP */
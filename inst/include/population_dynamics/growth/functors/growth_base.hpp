@@ -21,7 +21,8 @@ namespace fims_popdy {
  * @tparam Type The type of the growth functor.
  */
 template <typename Type>
-struct GrowthBase : public fims_model_object::FIMSObject<Type> {
+struct GrowthBase : public fims_model_object::FIMSObject<Type>,
+                    public fims_model_object::TimeDependentObject {
   // id_g is the ID of the instance of the  growthBase class.
   // this is like a memory tracker.
   // Assigning each one its own ID is a way to keep track of
@@ -44,6 +45,20 @@ struct GrowthBase : public fims_model_object::FIMSObject<Type> {
    * @param a The age at which to return weight of the fish (in kg).
    */
   virtual const Type evaluate(int year, const double& a) = 0;
+
+  /**
+   * @brief Calculates the growth at a vector of ages in one call.
+   * @param ages The ages.
+   * @param n The number of ages.
+   * @param year The year at which to return weight of the fish (in kg).
+   * @param out The weight of the fish (in kg) at each age, of length n.
+   */
+  virtual void evaluate_ages(const double* ages, size_t n, size_t year,
+                             Type* out) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = this->evaluate(static_cast<int>(year), ages[i]);
+    }
+  }
 };
 
 template <typename Type>
@@ -30,6 +30,25 @@ interest (x); e.g. age at which 50 percent of the fish are mature */
 
   LogisticMaturity() : MaturityBase<Type>() {}
 
+  /**
+   * @brief Heap bytes owned by the maturity module.
+   */
+  virtual size_t OwnedBytes() const {
+    return MaturityBase<Type>::OwnedBytes() +
+           fims::HeapBytes(inflection_point) + fims::HeapBytes(slope);
+  }
+
+  /**
+   * @brief Time invariant if the inflection point and slope are scalars,
+   * otherwise the declared time dependence.
+   */
+  virtual fims_model_object::TimeDependence GetTimeDependence() const {
+    if (inflection_point.size() <= 1 && slope.size() <= 1) {
+      return fims_model_object::TimeInvariant;
+    }
+    return MaturityBase<Type>::GetTimeDependence();
+  }
+
   /**
    * @brief Method of the logistic maturity class that implements the
    * logistic function from FIMS math.
@@ -58,6 +77,24 @@ interest (x); e.g. age at which 50 percent of the fish are mature */
     return fims_math::logistic<Type>(inflection_point.get_force_scalar(pos),
                                      slope.get_force_scalar(pos), x);
   }
+
+  /**
+   * @brief Calculates the maturity at a vector of ages with the parameters
+   * of one year in a tight loop.
+   * @param ages The ages.
+   * @param n The number of ages.
+   * @param year Position index, e.g., which year.
+   * @param out The maturity at each age, of length n.
+   */
+  virtual void evaluate_ages(const double* ages, size_t n, size_t year,
+                             Type* out) {
+    const Type inflection = inflection_point.get_force_scalar(year);
+    const Type s = slope.get_force_scalar(year);
+    for (size_t i = 0; i < n; i++) {
+      out[i] = fims_math::logistic<Type>(inflection, s,
+                                         static_cast<Type>(ages[i]));
+    }
+  }
 };
 
 }  // namespace fims_popdy
@@ -21,7 +21,8 @@ namespace fims_popdy {
  */
 
 template <typename Type>
-struct MaturityBase : public fims_model_object::FIMSObject<Type> {
+struct MaturityBase : public fims_model_object::FIMSObject<Type>,
+                      public fims_model_object::TimeDependentObject {
   // id_g is the ID of the instance of the MaturityBase class.
   // this is like a memory tracker.
   // Assigning each one its own ID is a way to keep track of
@@ -49,6 +50,20 @@ struct MaturityBase : public fims_model_object::FIMSObject<Type> {
    * @param pos Position index, e.g., which year.
    */
   virtual const Type evaluate(const Type& x, size_t pos) = 0;
+
+  /**
+   * @brief Calculates the maturity at a vector of ages in one call.
+   * @param ages The ages.
+   * @param n The number of ages.
+   * @param year Position index, e.g., which year.
+   * @param out The maturity at each age, of length n.
+   */
+  virtual void evaluate_ages(const double* ages, size_t n, size_t year,
+                             Type* out) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = this->evaluate(static_cast<Type>(ages[i]), year);
+    }
+  }
 };
 
 // default id of the singleton maturity class
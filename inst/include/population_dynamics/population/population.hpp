@@ -36,6 +36,8 @@ struct Population : public fims_model_object::FIMSObject<Type> {
       log_M; /*!< estimated parameter: natural log of Natural Mortality*/
   fims::Vector<Type> proportion_female = fims::Vector<Type>(
       1, static_cast<Type>(0.5));            /*!< proportion female by age */
+  fims::StridedView<Type> proportion_female_view; /*!< proportion female by
+    age as a strided view, resolved once per evaluation*/
   fims::Vector<Type> log_f_multiplier;       /*!< estimated parameter: vector of
     annual fishing mortality multipliers to scale total mortality of all fleets*/
   fims::Vector<Type> spawning_biomass_ratio; /*!< estimated parameter: vector of
@@ -45,6 +47,8 @@ annual fishing mortality multipliers to scale total mortality of all fleets*/
   fims::Vector<Type> M; /*!< transformed parameter: natural mortality*/
   fims::Vector<Type> f_multiplier; /*!< transformed parameter: vector of
 annual fishing mortality multipliers to scale total mortality of all fleets*/
+  fims::Vector<Type> weight_at_age; /*!< weight at age by year, evaluated once
+    per block of years of the growth module*/
 
   fims::Vector<double> ages;  /*!< vector of the ages for referencing*/
   fims::Vector<double> years; /*!< vector of years for referencing*/
@@ -76,6 +80,20 @@ annual fishing mortality multipliers to scale total mortality of all fleets*/
     this->id = Population::id_g++;
     this->register_self(this->id);
   }
+
+  /**
+   * @brief Heap bytes owned by the population.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::HeapBytes(log_init_naa) + fims::HeapBytes(log_M) +
+           fims::HeapBytes(proportion_female) +
+           fims::HeapBytes(log_f_multiplier) +
+           fims::HeapBytes(spawning_biomass_ratio) + fims::HeapBytes(M) +
+           fims::HeapBytes(f_multiplier) + fims::HeapBytes(weight_at_age) +
+           fims::HeapBytes(ages) + fims::HeapBytes(years) +
+           fims::HeapBytes(fleet_ids) + fims::HeapBytes(fleets);
+  }
 };
 template <class Type>
 uint32_t Population<Type>::id_g = 0;
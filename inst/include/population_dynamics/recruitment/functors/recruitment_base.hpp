@@ -56,6 +56,15 @@ struct RecruitmentBase : public fims_model_object::FIMSObject<Type> {
 
   virtual ~RecruitmentBase() {}
 
+  /**
+   * @brief Heap bytes owned by the recruitment module.
+   */
+  virtual size_t OwnedBytes() const {
+    return fims_model_object::FIMSObject<Type>::OwnedBytes() +
+           fims::HeapBytes(log_recruit_devs) + fims::HeapBytes(log_rzero) +
+           fims::HeapBytes(log_r) + fims::HeapBytes(log_expected_recruitment);
+  }
+
   /**
    * @brief Prepares the recruitment deviations vector.
    *
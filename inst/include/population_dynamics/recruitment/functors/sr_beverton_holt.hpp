@@ -39,6 +39,13 @@ struct SRBevertonHolt : public RecruitmentBase<Type> {
 
   virtual ~SRBevertonHolt() {}
 
+  /**
+   * @brief Heap bytes owned by the recruitment module.
+   */
+  virtual size_t OwnedBytes() const {
+    return RecruitmentBase<Type>::OwnedBytes() + fims::HeapBytes(logit_steep);
+  }
+
   /**
    * @copydoc RecruitmentBase::evaluate_mean
    *
@@ -38,6 +38,28 @@ struct DoubleLogisticSelectivity : public SelectivityBase<Type> {
 
   virtual ~DoubleLogisticSelectivity() {}
 
+  /**
+   * @brief Heap bytes owned by the selectivity module.
+   */
+  virtual size_t OwnedBytes() const {
+    return SelectivityBase<Type>::OwnedBytes() +
+           fims::HeapBytes(inflection_point_asc) + fims::HeapBytes(slope_asc) +
+           fims::HeapBytes(inflection_point_desc) +
+           fims::HeapBytes(slope_desc);
+  }
+
+  /**
+   * @brief Time invariant if all four parameters are scalars, otherwise the
+   * declared time dependence.
+   */
+  virtual fims_model_object::TimeDependence GetTimeDependence() const {
+    if (inflection_point_asc.size() <= 1 && slope_asc.size() <= 1 &&
+        inflection_point_desc.size() <= 1 && slope_desc.size() <= 1) {
+      return fims_model_object::TimeInvariant;
+    }
+    return SelectivityBase<Type>::GetTimeDependence();
+  }
+
   /**
    * @brief Method of the double logistic selectivity class that implements the
    * double logistic function from FIMS math.
@@ -76,6 +98,27 @@ struct DoubleLogisticSelectivity : public SelectivityBase<Type> {
         inflection_point_desc.get_force_scalar(pos),
         slope_desc.get_force_scalar(pos), x);
   }
+
+  /**
+   * @brief Calculates the selectivity at a vector of ages with the
+   * parameters of one year in a tight loop.
+   * @param ages The ages.
+   * @param n The number of ages.
+   * @param year Position index, e.g., which year.
+   * @param out The selectivity at each age, of length n.
+   */
+  virtual void evaluate_ages(const double* ages, size_t n, size_t year,
+                             Type* out) {
+    const Type inflection_asc = inflection_point_asc.get_force_scalar(year);
+    const Type s_asc = slope_asc.get_force_scalar(year);
+    const Type inflection_desc = inflection_point_desc.get_force_scalar(year);
+    const Type s_desc = slope_desc.get_force_scalar(year);
+    for (size_t i = 0; i < n; i++) {
+      out[i] = fims_math::double_logistic<Type>(inflection_asc, s_asc,
+                                                inflection_desc, s_desc,
+                                                static_cast<Type>(ages[i]));
+    }
+  }
 };
 
 }  // namespace fims_popdy
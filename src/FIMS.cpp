@@ -27,23 +27,54 @@ Type objective_function<Type>::operator()() {
     std::shared_ptr<fims_info::Information<Type>> information =
       fims_info::Information<Type>::GetInstance();
 
-    //update the fixed effects parameter values
-    for(size_t i =0; i < information->fixed_effects_parameters.size(); i++){
-        *information->fixed_effects_parameters[i] = p[i];
+    //update the fixed and random effects parameter values, one block copy
+    //per contiguous run of parameters
+    information->SetFixedEffects(p.data());
+    information->SetRandomEffects(re.data());
+
+    //observations supplied as updatable data, so they can be replaced from R
+    //without re-taping, see set_observed_data_block(). The data objects read
+    //obs in place, so they are released before it goes out of scope
+    if (!Rf_isNull(getListElement(this->data, "obs"))) {
+      DATA_VECTOR(obs);
+      DATA_UPDATE(obs);
+      if (static_cast<size_t>(obs.size()) !=
+          information->GetNumberOfObservations()) {
+        Rf_error("The length of obs does not match the number of observations");
+      }
+      information->SetObservedData(obs.data());
     }
-    //update the random effects parameter values
-    for(size_t i =0; i < information->random_effects_parameters.size(); i++){
-        *information->random_effects_parameters[i] = re[i];
+
+    //per-observation likelihood weights, also updatable, e.g., to mask the
+    //terminal years of a retrospective peel, see get_retrospective_weights().
+    //Only passed for retrospective peels, so other fits are unweighted
+    if (!Rf_isNull(getListElement(this->data, "obs_weights"))) {
+      DATA_VECTOR(obs_weights);
+      DATA_UPDATE(obs_weights);
+      if (static_cast<size_t>(obs_weights.size()) !=
+          information->GetNumberOfObservations()) {
+        Rf_error("The length of obs_weights does not match the number of "
+                 "observations");
+      }
+      information->SetObservationWeights(obs_weights.data());
     }
     model -> of = this;
 
+    //each evaluation with an AD type records a new tape, so the tape
+    //counters start over, see set_tape_counters()
+    if (!isDouble<Type>::value) {
+      fims::FIMSTimer::StartTape();
+    }
+
     Type nll = 0;
     //evaluate the model objective function value
     try{
       nll = model->Evaluate();
     } catch (const std::exception& e) {
+      information->ClearObservedData();
       Rf_error("Error during model evaluation: %s",  std::string(e.what()).c_str());
     }
+    information->ClearObservedData();
 
     return nll;
 
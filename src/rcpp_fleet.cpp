@@ -87,5 +87,7 @@ void register_fleet(Rcpp::Module& m) {
               &FleetInterface::SetObservedLandingsDataID)
       .method("GetObservedLandingsDataID",
               &FleetInterface::GetObservedLandingsDataID)
-      .method("SetSelectivityID", &FleetInterface::SetSelectivityID);
+      .method("SetSelectivityID", &FleetInterface::SetSelectivityID)
+      .method("SetAgeToLengthTolerance",
+              &FleetInterface::SetAgeToLengthTolerance);
 }
\ No newline at end of file
@@ -36,6 +36,62 @@ void register_functions(Rcpp::Module &m) {
       "get_random", &get_random_parameters_vector,
       "See "
       "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_fixed_block", &get_fixed_parameters_block,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "set_fixed_block", &set_fixed_parameters_block,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_random_block", &get_random_parameters_block,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "set_random_block", &set_random_parameters_block,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_observed_data", &get_observed_data,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "set_observed_data_block", &set_observed_data_block,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_retrospective_weights", &get_retrospective_weights,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "simulate_data", &simulate_data,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "set_timers", &set_timers,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_timers", &get_timers,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "clear_timers", &clear_timers,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "set_tape_counters", &set_tape_counters,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_tape_counters", &get_tape_counters,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
+  Rcpp::function(
+      "get_memory_report", &get_memory_report,
+      "See "
+      "https://noaa-fims.github.io/FIMS/doxygen/rcpp__interface_8hpp.html.");
   Rcpp::function(
       "get_parameter_names", &get_parameter_names,
       "See "
@@ -27,5 +27,11 @@ void register_fishery_models(Rcpp::Module& m) {
       .method("get_output", &CatchAtAgeInterface::to_json)
       .method("GetId", &CatchAtAgeInterface::get_id)
       .method("DoReporting", &CatchAtAgeInterface::DoReporting)
-      .method("IsReporting", &CatchAtAgeInterface::IsReporting);
+      .method("IsReporting", &CatchAtAgeInterface::IsReporting)
+      .method("SetReferencePoints", &CatchAtAgeInterface::SetReferencePoints)
+      .method("SetCheckpointYears", &CatchAtAgeInterface::SetCheckpointYears)
+      .method("SetAdreport", &CatchAtAgeInterface::SetAdreport)
+      .method("GetAdreport", &CatchAtAgeInterface::GetAdreport)
+      .method("GetEquilibrium", &CatchAtAgeInterface::GetEquilibrium)
+      .method("Project", &CatchAtAgeInterface::Project);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Time of the double model with the checkpointed one-year update, see
+// CatchAtAge::CalculateCheckpointedYears(), against the loop over years and
+// ages, for 40 ages and 4 fleets with state.range(0) years, where
+// state.range(1) is 1 for the checkpointed update and 0 for the loop.
+//
+// This build has no AD tape, so only the cost of staging the inputs and
+// outputs of the update with doubles is timed. On a single-core Xeon the
+// checkpointed update took 38.7, 79.6, 149, and 287 ms for 25, 50, 100, and
+// 200 years against 34.0, 68.0, 148, and 350 ms for the loop.
+//
+// The size of the tape, which is what the checkpointed update is meant to
+// reduce, is not measured here. In R, call set_tape_counters(TRUE) before
+// TMB::MakeADFun() and get_tape_counters() afterward to get the operations
+// and variables of the population_dynamics phase with
+// initialize_fims(checkpoint_years = TRUE) and FALSE, and time obj$gr() for
+// the cost of replaying the update in the derivative sweeps. The testthat
+// test of initialize_fims() checks that the checkpointed tape has fewer
+// variables and the same objective function and gradient.
+static void BM_CatchAtAge_CheckpointYears(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_ages = 40;
+  dims.n_fleets = 4;
+  dims.n_years = static_cast<size_t>(state.range(0));
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(dims).Generate<double>();
+  model.catch_at_age->checkpoint_years = state.range(1) == 1;
+  fims::FIMSLog::fims_log->clear();
+
+  int64_t n = 0;
+  for (auto _ : state) {
+    double jnll = model.Evaluate();
+    benchmark::DoNotOptimize(jnll);
+    if (++n % 1024 == 0) {
+      state.PauseTiming();
+      fims::FIMSLog::fims_log->clear();
+      state.ResumeTiming();
+    }
+  }
+  fims::FIMSLog::fims_log->clear();
+}
+BENCHMARK(BM_CatchAtAge_CheckpointYears)
+    ->ArgsProduct({{25, 50, 100, 200}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
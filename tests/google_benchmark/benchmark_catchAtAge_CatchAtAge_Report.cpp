@@ -0,0 +1,44 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Benchmark for CatchAtAge::Report after an evaluation of a complete model
+// with state.range(0) years. The copies into TMB vectors and the REPORT and
+// ADREPORT calls only exist when TMB_MODEL is defined, so this build times the
+// part of Report() that is shared by every build. Together with
+// BM_Model_Evaluate_Years it gives the ratio of reporting to evaluating.
+static void BM_CatchAtAge_Report(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_years = static_cast<size_t>(state.range(0));
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(dims).Generate<double>();
+  model.Evaluate();
+  fims::FIMSLog::fims_log->clear();
+
+  for (auto _ : state) {
+    model.catch_at_age->Report();
+    benchmark::ClobberMemory();
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_CatchAtAge_Report)
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->Complexity();
+
+}  // namespace
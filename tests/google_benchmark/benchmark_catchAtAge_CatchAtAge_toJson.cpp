@@ -0,0 +1,56 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Serializes the derived quantities of every population and fleet of an
+// evaluated catch-at-age model with state.range(0) years, i.e., the work of
+// CatchAtAgeInterface::to_json() apart from the Rcpp objects.
+static void BM_CatchAtAge_toJson(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_years = static_cast<size_t>(state.range(0));
+  dims.n_lengths = 40;
+  dims.n_data = 4;
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(dims).Generate<double>();
+  model.Evaluate();
+  fims::FIMSLog::fims_log->clear();
+  fims_popdy::CatchAtAge<double>& caa = *model.catch_at_age;
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    std::string json;
+    for (auto& kv : caa.GetPopulationDerivedQuantities()) {
+      json += fims_popdy::DerivedQuantitiesToJson(
+          kv.second, caa.GetPopulationDimensionInfo(kv.first));
+    }
+    for (auto& kv : caa.GetFleetDerivedQuantities()) {
+      json += fims_popdy::DerivedQuantitiesToJson(
+          kv.second, caa.GetFleetDimensionInfo(kv.first));
+    }
+    bytes = json.size();
+    benchmark::DoNotOptimize(json.data());
+  }
+  state.SetComplexityN(state.range(0));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_CatchAtAge_toJson)
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->Complexity();
+
+}  // namespace
@@ -0,0 +1,97 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Evaluates every data component of the given distribution in a complete
+// catch-at-age model with state.range(0) years. The model is evaluated once
+// first so that the expected values are filled in. The terms of the density
+// are only computed when TMB_MODEL is defined, so this build times the setup
+// and dimension checks of evaluate() that every evaluation pays for.
+template <typename Distribution>
+void RunDensityComponentEvaluate(benchmark::State& state, size_t n_lengths) {
+  SyntheticModelDimensions dims;
+  dims.n_years = static_cast<size_t>(state.range(0));
+  dims.n_lengths = n_lengths;
+  dims.n_data = 4;
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(dims).Generate<double>();
+  model.Evaluate();
+  fims::FIMSLog::fims_log->clear();
+
+  std::vector<std::shared_ptr<Distribution>> components;
+  for (auto& kv : model.info->density_components) {
+    std::shared_ptr<Distribution> d =
+        std::dynamic_pointer_cast<Distribution>(kv.second);
+    if (d != nullptr) {
+      components.push_back(d);
+    }
+  }
+  for (auto _ : state) {
+    double lpdf = 0.0;
+    for (auto& d : components) {
+      lpdf += d->evaluate();
+    }
+    benchmark::DoNotOptimize(lpdf);
+  }
+  state.SetComplexityN(state.range(0));
+  state.counters["components"] = static_cast<double>(components.size());
+}
+
+// Benchmark for LogNormalLPDF::evaluate on landings and index data
+static void BM_LogNormalLPDF_evaluate(benchmark::State& state) {
+  RunDensityComponentEvaluate<fims_distributions::LogNormalLPDF<double>>(state,
+                                                                         0);
+}
+BENCHMARK(BM_LogNormalLPDF_evaluate)
+    ->RangeMultiplier(4)
+    ->Range(8, 512)
+    ->Complexity();
+
+// Benchmark for MultinomialLPMF::evaluate on age and length compositions
+static void BM_MultinomialLPMF_evaluate(benchmark::State& state) {
+  RunDensityComponentEvaluate<fims_distributions::MultinomialLPMF<double>>(
+      state, 40);
+}
+BENCHMARK(BM_MultinomialLPMF_evaluate)
+    ->RangeMultiplier(4)
+    ->Range(8, 512)
+    ->Complexity();
+
+// Benchmark for NormalLPDF::evaluate on a vector of observations
+static void BM_NormalLPDF_evaluate(benchmark::State& state) {
+  size_t n = static_cast<size_t>(state.range(0));
+  fims_distributions::NormalLPDF<double> normal;
+  normal.observed_values.resize(n);
+  normal.expected_values.resize(n);
+  normal.log_sd.resize(1);
+  for (size_t i = 0; i < n; i++) {
+    normal.observed_values[i] = 0.1 * i;
+    normal.expected_values[i] = 0.1 * i + 0.05;
+  }
+  for (auto _ : state) {
+    double lpdf = normal.evaluate();
+    benchmark::DoNotOptimize(lpdf);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_NormalLPDF_evaluate)
+    ->RangeMultiplier(4)
+    ->Range(8, 8192)
+    ->Complexity();
+
+}  // namespace
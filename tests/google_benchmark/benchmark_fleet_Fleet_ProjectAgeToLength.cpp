@@ -0,0 +1,119 @@
+#include "benchmark/benchmark.h"
+
+#include "models/functors/catch_at_age.hpp"
+
+namespace {
+
+// Benchmark for CatchAtAge::evaluate_length_comp() with 60 ages, 120 length
+// bins, and 80 years. The fused and blocked projection is compared to the
+// former loop over years, length bins, and ages, which made one pass per
+// output and looked up each derived quantity in the map for every product.
+// The projection is timed over all entries of the conversion matrix and over
+// the bands of length bins above a tolerance of 1e-6, i.e., about a quarter
+// of the entries.
+struct LengthCompBench {
+  size_t n_years = 80;
+  size_t n_ages = 60;
+  size_t n_lengths = 120;
+  fims_popdy::CatchAtAge<double> caa;
+  std::shared_ptr<fims_popdy::Fleet<double>> fleet;
+
+  explicit LengthCompBench(double tolerance = -1.0) {
+    fleet = std::make_shared<fims_popdy::Fleet<double>>();
+    fleet->n_years = n_years;
+    fleet->n_ages = n_ages;
+    fleet->n_lengths = n_lengths;
+    caa.fleets[fleet->GetId()] = fleet;
+    caa.InitializeFleetDerivedQuantities(fleet->GetId());
+
+    // normal length at age with a standard deviation of 3 length bins
+    fleet->age_to_length_conversion.resize(n_ages * n_lengths);
+    for (size_t a = 0; a < n_ages; a++) {
+      double mean = 2.0 * static_cast<double>(a);
+      for (size_t l = 0; l < n_lengths; l++) {
+        double z = (static_cast<double>(l) - mean) / 3.0;
+        fleet->age_to_length_conversion[a * n_lengths + l] =
+            std::exp(-0.5 * z * z);
+      }
+    }
+    fleet->age_to_length_tolerance = tolerance;
+    fleet->Initialize();
+    std::map<std::string, fims::Vector<double>> &fdq =
+        caa.GetFleetDerivedQuantities(fleet->GetId());
+    for (const char *name : {"agecomp_expected", "landings_numbers_at_age",
+                             "index_numbers_at_age"}) {
+      fdq[name].resize(n_years * n_ages);
+      for (size_t i = 0; i < n_years * n_ages; i++) {
+        fdq[name][i] = 1000.0 / static_cast<double>(i % n_ages + 1);
+      }
+    }
+    for (const char *name : {"lengthcomp_expected", "lengthcomp_proportion",
+                             "landings_numbers_at_length",
+                             "index_numbers_at_length"}) {
+      fdq[name].resize(n_years * n_lengths);
+    }
+  }
+
+  // Resets the accumulated outputs as CatchAtAge::Prepare() does
+  void Reset() {
+    std::map<std::string, fims::Vector<double>> &fdq =
+        caa.GetFleetDerivedQuantities(fleet->GetId());
+    for (const char *name : {"lengthcomp_expected",
+                             "landings_numbers_at_length",
+                             "index_numbers_at_length"}) {
+      std::fill(fdq[name].begin(), fdq[name].end(), 0.0);
+    }
+  }
+
+  // The projection of evaluate_length_comp() before it was fused
+  void ProjectUnfused() {
+    std::map<std::string, fims::Vector<double>> &fdq_ =
+        caa.GetFleetDerivedQuantities(fleet->GetId());
+    for (size_t y = 0; y < fleet->n_years; y++) {
+      for (size_t l = 0; l < fleet->n_lengths; l++) {
+        size_t i_length_year = y * fleet->n_lengths + l;
+        for (size_t a = 0; a < fleet->n_ages; a++) {
+          size_t i_age_year = y * fleet->n_ages + a;
+          size_t i_length_age = a * fleet->n_lengths + l;
+          fdq_["lengthcomp_expected"][i_length_year] +=
+              fdq_["agecomp_expected"][i_age_year] *
+              fleet->age_to_length_conversion[i_length_age];
+          fdq_["landings_numbers_at_length"][i_length_year] +=
+              fdq_["landings_numbers_at_age"][i_age_year] *
+              fleet->age_to_length_conversion[i_length_age];
+          fdq_["index_numbers_at_length"][i_length_year] +=
+              fdq_["index_numbers_at_age"][i_age_year] *
+              fleet->age_to_length_conversion[i_length_age];
+        }
+      }
+    }
+  }
+};
+
+// Benchmark for the projection before it was fused
+static void BM_ProjectAgeToLength_Unfused(benchmark::State &state) {
+  LengthCompBench bench;
+  for (auto _ : state) {
+    bench.Reset();
+    bench.ProjectUnfused();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_ProjectAgeToLength_Unfused);
+
+// Benchmark for CatchAtAge::evaluate_length_comp(), where the argument is 0
+// to project all entries and 1 to project the bands above the tolerance
+static void BM_CatchAtAge_EvaluateLengthComp(benchmark::State &state) {
+  LengthCompBench bench(state.range(0) == 0 ? -1.0 : 1e-6);
+  state.counters["entries"] = static_cast<double>(
+      state.range(0) == 0 ? bench.n_ages * bench.n_lengths
+                          : bench.fleet->age_to_length_band.NonZeros());
+  for (auto _ : state) {
+    bench.Reset();
+    bench.caa.evaluate_length_comp();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CatchAtAge_EvaluateLengthComp)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,124 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Evaluates the objective function of a complete catch-at-age model once per
+// iteration. Model::Evaluate() writes to the log every time it is called, so
+// the log is cleared outside of the timed region to keep memory flat.
+void RunModelEvaluate(benchmark::State& state,
+                      const SyntheticModelDimensions& dims,
+                      int64_t complexity_n) {
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(dims).Generate<double>();
+  fims::FIMSLog::fims_log->clear();
+  int64_t n = 0;
+  for (auto _ : state) {
+    double jnll = model.Evaluate();
+    benchmark::DoNotOptimize(jnll);
+    if (++n % 1024 == 0) {
+      state.PauseTiming();
+      fims::FIMSLog::fims_log->clear();
+      state.ResumeTiming();
+    }
+  }
+  fims::FIMSLog::fims_log->clear();
+  state.SetComplexityN(complexity_n);
+  state.counters["data_components"] =
+      static_cast<double>(model.data.size());
+}
+
+// Benchmark for Model::Evaluate with the number of ages varied
+static void BM_Model_Evaluate_Ages(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_ages = static_cast<size_t>(state.range(0));
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_Ages)
+    ->RangeMultiplier(2)
+    ->Range(4, 64)
+    ->Complexity();
+
+// Benchmark for Model::Evaluate with the number of years varied
+static void BM_Model_Evaluate_Years(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_years = static_cast<size_t>(state.range(0));
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_Years)
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->Complexity();
+
+// Benchmark for Model::Evaluate with the number of fleets varied
+static void BM_Model_Evaluate_Fleets(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_fleets = static_cast<size_t>(state.range(0));
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_Fleets)->DenseRange(1, 8)->Complexity();
+
+// Benchmark for Model::Evaluate with the number of populations varied
+static void BM_Model_Evaluate_Populations(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_populations = static_cast<size_t>(state.range(0));
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_Populations)->DenseRange(1, 4)->Complexity();
+
+// Benchmark for Model::Evaluate with the number of length bins varied, where
+// every fleet also has length-composition data
+static void BM_Model_Evaluate_Lengths(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_lengths = static_cast<size_t>(state.range(0));
+  dims.n_data = 4;
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_Lengths)
+    ->RangeMultiplier(2)
+    ->Range(8, 128)
+    ->Complexity();
+
+// Benchmark for Model::Evaluate with the number of data components per fleet
+// varied from landings only to landings, index, age, and length composition
+static void BM_Model_Evaluate_DataComponents(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_lengths = 40;
+  dims.n_data = static_cast<size_t>(state.range(0));
+  RunModelEvaluate(state, dims, state.range(0));
+}
+BENCHMARK(BM_Model_Evaluate_DataComponents)->DenseRange(1, 4)->Complexity();
+
+// Benchmark for Model::Evaluate at the size of large production models, i.e.,
+// 100 years, 60 ages, and 30 fleets with time-varying selectivity, natural
+// mortality, and growth and a third of the compositions missing
+static void BM_Model_Evaluate_Production(benchmark::State& state) {
+  SyntheticModelDimensions dims;
+  dims.n_years = 100;
+  dims.n_ages = 60;
+  dims.n_fleets = 30;
+  dims.n_lengths = 40;
+  dims.n_data = 4;
+  dims.comp_sparsity = 1.0 / 3.0;
+  dims.time_varying_selectivity = true;
+  dims.time_varying_mortality = true;
+  dims.time_varying_growth = true;
+  RunModelEvaluate(state, dims, 1);
+}
+BENCHMARK(BM_Model_Evaluate_Production)->Unit(benchmark::kMillisecond);
+
+}  // namespace
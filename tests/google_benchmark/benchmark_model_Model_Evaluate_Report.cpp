@@ -0,0 +1,69 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_google_benchmark_template().
+// Use this simple template when you can benchmark production code directly
+// without a gtest fixture.
+//
+// See `?FIMS:::use_google_benchmark_template` for more information. Run the
+// benchmark executable (e.g. build then
+// ./build/tests/google_benchmark/benchmark_<name>) to measure; do not run
+// benchmarks as part of the regular test suite.
+// Google Benchmark user guide:
+// https://google.github.io/benchmark/user_guide.html
+
+#include "benchmark/benchmark.h"
+
+#include "../gtest/test_stubs.hpp"
+#include "../gtest/test_synthetic_model_generator.hpp"
+
+namespace {
+
+// Dimensions of a large model, with more years, ages, and fleets than the
+// defaults of the generator.
+SyntheticModelDimensions LargeDimensions() {
+  SyntheticModelDimensions dims;
+  dims.n_years = 60;
+  dims.n_ages = 30;
+  dims.n_fleets = 6;
+  return dims;
+}
+
+// Evaluates the objective function of a large model once per iteration. If
+// state.range(0) is 1, Report() is called after every evaluation, as it was
+// before Model::Evaluate() skipped it for the double model evaluated without
+// a TMB objective function, i.e., with Model::of equal to nullptr. The
+// optimizer replays the tape and never runs Report(), so this is not a
+// saving per evaluation of the optimizer. Under TMB, every taped evaluation
+// still runs Report() and the saving there is that only the quantities
+// selected for ADREPORT are copied, which this benchmark does not measure.
+// Without TMB_MODEL the copies into TMB vectors do not exist and only the
+// part of Report() that is shared by every build is timed: on a single-core
+// Xeon the median of three repetitions was 85 ms without and 93 ms with
+// Report(), with a coefficient of variation of 5 to 6 percent.
+static void BM_Model_Evaluate_Report(benchmark::State& state) {
+  bool report = state.range(0) == 1;
+  SyntheticModel<double> model =
+      SyntheticModelGenerator(LargeDimensions()).Generate<double>();
+  fims::FIMSLog::fims_log->clear();
+  int64_t n = 0;
+  for (auto _ : state) {
+    double jnll = model.Evaluate();
+    benchmark::DoNotOptimize(jnll);
+    if (report) {
+      model.catch_at_age->Report();
+    }
+    benchmark::ClobberMemory();
+    if (++n % 1024 == 0) {
+      state.PauseTiming();
+      fims::FIMSLog::fims_log->clear();
+      state.ResumeTiming();
+    }
+  }
+  fims::FIMSLog::fims_log->clear();
+}
+BENCHMARK(BM_Model_Evaluate_Report)
+    ->ArgName("report")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
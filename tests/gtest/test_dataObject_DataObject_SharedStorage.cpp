@@ -0,0 +1,61 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "data_object.hpp"
+
+namespace
+{
+  // DataObject_SharedStorage
+  // IO correctness
+  // Test that a data object created from another data object reads the same
+  // observations without copying them
+  TEST(DataObject_SharedStorage, HandlesCorrectInput)
+  {
+    fims_data_object::DataObject<double> observed(2, 3);
+    for (size_t i = 0; i < observed.size(); i++)
+    {
+      observed.set(i, static_cast<double>(i) + 0.5);
+    }
+
+    fims_data_object::DataObject<float> shared(observed);
+    EXPECT_EQ(shared.data.get(), observed.data.get());
+    EXPECT_EQ(shared.uncertainty.get(), observed.uncertainty.get());
+    EXPECT_EQ(shared.get_dimensions(), 2);
+    EXPECT_EQ(shared.get_imax(), 2);
+    EXPECT_EQ(shared.get_jmax(), 3);
+    EXPECT_EQ(shared.at(1, 2), 5.5f);
+    EXPECT_EQ(shared(0, 1), 1.5f);
+
+    // updates to the owning object are seen by the sharing object
+    observed.set(0, 10.0);
+    EXPECT_EQ(shared.at(0), 10.0f);
+  }
+
+  // Edge handling
+  // Test that the storage outlives the data object that created it
+  TEST(DataObject_SharedStorage, HandlesEdgeCases)
+  {
+    std::shared_ptr<fims_data_object::DataObject<double>> observed =
+      std::make_shared<fims_data_object::DataObject<double>>(1);
+    observed->set(0, 3.0);
+    fims_data_object::DataObject<double> shared(*observed);
+    observed.reset();
+    EXPECT_EQ(shared.at(0), 3.0);
+  }
+
+  // Error handling
+  // Test that out of bounds access throws
+  TEST(DataObject_SharedStorage, HandlesErrorCases)
+  {
+    fims_data_object::DataObject<double> observed(2);
+    EXPECT_THROW(observed.at(2), std::overflow_error);
+    EXPECT_THROW(observed.set(2, 1.0), std::overflow_error);
+  }
+}
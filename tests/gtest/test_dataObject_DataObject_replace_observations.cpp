@@ -0,0 +1,66 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "data_object.hpp"
+
+namespace
+{
+  // DataObject_replace_observations
+  // IO correctness
+  // Test that the observations are replaced in the shared storage, so the
+  // data object of the other type reads the new values
+  TEST(DataObject_replace_observations, HandlesCorrectInput)
+  {
+    fims_data_object::DataObject<double> observed(3);
+    observed.set(0, 1.0);
+    observed.set(1, -999.0);
+    observed.set(2, 3.0);
+    fims_data_object::DataObject<float> shared(observed);
+
+    std::vector<double> values = {10.0, -999.0, 30.0};
+    observed.replace_observations(values.data());
+    EXPECT_EQ(observed.at(0), 10.0);
+    EXPECT_EQ(observed.at(1), -999.0);
+    EXPECT_EQ(shared.at(2), 30.0f);
+  }
+
+  // Edge handling
+  // Test that a data object without missing values and an empty data object
+  // accept any replacement without missing values
+  TEST(DataObject_replace_observations, HandlesEdgeCases)
+  {
+    fims_data_object::DataObject<double> observed(2);
+    std::vector<double> values = {0.0, 5.0};
+    EXPECT_NO_THROW(observed.replace_observations(values.data()));
+    EXPECT_EQ(observed.at(1), 5.0);
+
+    fims_data_object::DataObject<double> empty(0);
+    EXPECT_NO_THROW(empty.replace_observations(values.data()));
+  }
+
+  // Error handling
+  // Test that a replacement that adds or removes a missing value throws and
+  // leaves the observations unchanged
+  TEST(DataObject_replace_observations, HandlesErrorCases)
+  {
+    fims_data_object::DataObject<double> observed(2);
+    observed.set(0, 1.0);
+    observed.set(1, -999.0);
+
+    std::vector<double> added = {-999.0, -999.0};
+    EXPECT_THROW(observed.replace_observations(added.data()),
+                 std::invalid_argument);
+    std::vector<double> removed = {2.0, 4.0};
+    EXPECT_THROW(observed.replace_observations(removed.data()),
+                 std::invalid_argument);
+    EXPECT_EQ(observed.at(0), 1.0);
+    EXPECT_EQ(observed.at(1), -999.0);
+  }
+}
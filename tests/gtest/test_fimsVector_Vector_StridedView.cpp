@@ -0,0 +1,140 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include <random>
+
+#include "gtest/gtest.h"
+#include "population/population.hpp"
+#include "../../tests/gtest/test_population_test_fixture.hpp"
+
+namespace
+{
+  // Vector_StridedView
+  // IO correctness
+  // Test that a strided view returns the same values as get_force_scalar()
+  // for a scalar and for a vector, and that it refers to the values of the
+  // vector rather than to a copy
+  TEST(Vector_StridedView, HandlesCorrectInput)
+  {
+    size_t n = 5;
+    fims::Vector<double> scalar(1, 0.3);
+    fims::Vector<double> vector = {0.1, 0.2, 0.3, 0.4, 0.5};
+
+    fims::StridedView<double> scalar_view = scalar.strided_view(n);
+    fims::StridedView<double> vector_view = vector.strided_view(n);
+    EXPECT_EQ(scalar_view.stride, 0);
+    EXPECT_EQ(vector_view.stride, 1);
+    for (size_t i = 0; i < n; i++)
+    {
+      EXPECT_EQ(scalar_view[i], scalar.get_force_scalar(i));
+      EXPECT_EQ(vector_view[i], vector.get_force_scalar(i));
+    }
+
+    vector_view[2] = 0.7;
+    EXPECT_EQ(vector[2], 0.7);
+  }
+
+  // IO correctness
+  // Test that the kernels of the catch-at-age model give identical results
+  // with the strided view of a scalar proportion female and with the view
+  // of a vector that repeats the scalar for each age
+  TEST_F(CAAEvaluateTestFixture, HandlesCorrectInput_Vector_StridedView_CatchAtAge)
+  {
+    double prop_female = population->proportion_female[0];
+    size_t year = 3;
+    std::map<std::string, fims::Vector<double>> &dq =
+      catch_at_age_model->GetPopulationDerivedQuantities(population->GetId());
+
+    for (size_t age = 0; age < population->n_ages; age++)
+    {
+      size_t i_age_year = year * population->n_ages + age;
+      catch_at_age_model->CalculateSpawningBiomass(population, i_age_year,
+                                                   year, age);
+    }
+    double vector_sb = dq["spawning_biomass"][year];
+    double vector_phi_0 = catch_at_age_model->CalculateSBPR0(population);
+
+    population->proportion_female = fims::Vector<double>(1, prop_female);
+    population->proportion_female_view =
+      population->proportion_female.strided_view(population->n_ages);
+    EXPECT_EQ(population->proportion_female_view.stride, 0);
+    dq["spawning_biomass"][year] = 0.0;
+    for (size_t age = 0; age < population->n_ages; age++)
+    {
+      size_t i_age_year = year * population->n_ages + age;
+      catch_at_age_model->CalculateSpawningBiomass(population, i_age_year,
+                                                   year, age);
+    }
+    EXPECT_EQ(dq["spawning_biomass"][year], vector_sb);
+    EXPECT_EQ(catch_at_age_model->CalculateSBPR0(population), vector_phi_0);
+  }
+
+  // IO correctness
+  // Test that the normal distribution draws identical replicates with a
+  // scalar log_sd and with a vector that repeats the scalar for each
+  // observation
+  TEST(Vector_StridedView, HandlesCorrectInput_NormalLPDF)
+  {
+    size_t n = 4;
+    std::shared_ptr<fims_data_object::DataObject<double>> data =
+      std::make_shared<fims_data_object::DataObject<double>>(n);
+    fims::Vector<double> expected(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      data->set(i, 1.0);
+      expected[i] = static_cast<double>(i + 1);
+    }
+    fims_distributions::NormalLPDF<double> normal;
+    normal.input_type = "data";
+    normal.data_observed_values = data;
+    normal.data_expected_values = &expected;
+
+    normal.log_sd = fims::Vector<double>(1, std::log(0.2));
+    std::vector<double> scalar_draws(n);
+    std::mt19937_64 scalar_rng(42);
+    normal.simulate_replicate(scalar_rng, scalar_draws.data());
+
+    normal.log_sd = fims::Vector<double>(n, std::log(0.2));
+    std::vector<double> vector_draws(n);
+    std::mt19937_64 vector_rng(42);
+    normal.simulate_replicate(vector_rng, vector_draws.data());
+
+    EXPECT_EQ(scalar_draws, vector_draws);
+  }
+
+  // Edge handling
+  // Test that a scalar is broadcast without instances, that an empty vector
+  // gives a view without instances, and that a vector longer than the
+  // number of instances is read with a stride of one
+  TEST(Vector_StridedView, HandlesEdgeCases)
+  {
+    fims::Vector<double> scalar(1, 0.3);
+    EXPECT_EQ(scalar.strided_view(0).stride, 0);
+
+    fims::Vector<double> empty;
+    EXPECT_NO_THROW(empty.strided_view(0));
+
+    fims::Vector<double> longer = {0.1, 0.2, 0.3};
+    fims::StridedView<double> view = longer.strided_view(2);
+    EXPECT_EQ(view.stride, 1);
+    EXPECT_EQ(view[1], 0.2);
+  }
+
+  // Error handling
+  // Test that a vector with more than one value but fewer values than
+  // instances, or without values, throws an invalid_argument exception
+  TEST(Vector_StridedView, HandlesErrors)
+  {
+    fims::Vector<double> shorter = {0.1, 0.2};
+    EXPECT_THROW(shorter.strided_view(3), std::invalid_argument);
+
+    fims::Vector<double> empty;
+    EXPECT_THROW(empty.strided_view(1), std::invalid_argument);
+  }
+}
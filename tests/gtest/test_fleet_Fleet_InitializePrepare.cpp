@@ -98,4 +98,38 @@ namespace
 
         }
     }
+
+    // IO correctness
+    // Test that Fleet::Initialize() resolves the units of the observed data
+    // and the ids of the optional data into booleans
+    TEST(Fleet_Initialize, HandlesCorrectInput_Fleet_ResolveDataFlags)
+    {
+        fims_popdy::Fleet<double> fleet;
+        fleet.observed_landings_units = "number";
+        fleet.observed_index_units = "weight";
+        fleet.fleet_observed_landings_data_id_m = 1;
+        fleet.fleet_observed_agecomp_data_id_m = 2;
+        fleet.Initialize();
+
+        EXPECT_TRUE(fleet.landings_in_numbers);
+        EXPECT_FALSE(fleet.index_in_numbers);
+        EXPECT_TRUE(fleet.has_landings_data);
+        EXPECT_TRUE(fleet.has_agecomp_data);
+        EXPECT_FALSE(fleet.has_lengthcomp_data);
+    }
+
+    // Edge handling
+    // Test that a fleet without units and without data ids is treated as a
+    // fleet with data in weight and without optional data
+    TEST(Fleet_Initialize, HandlesEdgeCases_Fleet_ResolveDataFlags)
+    {
+        fims_popdy::Fleet<double> fleet;
+        fleet.Initialize();
+
+        EXPECT_FALSE(fleet.landings_in_numbers);
+        EXPECT_FALSE(fleet.index_in_numbers);
+        EXPECT_FALSE(fleet.has_landings_data);
+        EXPECT_FALSE(fleet.has_agecomp_data);
+        EXPECT_FALSE(fleet.has_lengthcomp_data);
+    }
 } // namespace
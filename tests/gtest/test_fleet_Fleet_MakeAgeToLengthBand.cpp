@@ -0,0 +1,180 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "models/functors/catch_at_age.hpp"
+
+namespace
+{
+  // Normal length at age, where the mean length bin increases by two bins per
+  // age and the standard deviation is sd length bins
+  std::vector<double> NormalConversion(size_t n_ages, size_t n_lengths,
+                                       double sd)
+  {
+    std::vector<double> conversion(n_ages * n_lengths);
+    for (size_t a = 0; a < n_ages; a++)
+    {
+      for (size_t l = 0; l < n_lengths; l++)
+      {
+        double z = (static_cast<double>(l) - 2.0 * a) / sd;
+        conversion[a * n_lengths + l] = std::exp(-0.5 * z * z);
+      }
+    }
+    return conversion;
+  }
+
+  // Fleet_MakeAgeToLengthBand
+  // IO correctness
+  // Test that the band of each age starts at the first and ends at the last
+  // entry above the tolerance, and that entries within the band are kept
+  TEST(Fleet_MakeAgeToLengthBand, HandlesCorrectInput)
+  {
+    std::vector<double> conversion = {0.0, 0.5, 0.0, 0.5, 0.0,
+                                      1e-9, 0.0, 0.2, 0.8, 1e-9};
+    fims_popdy::AgeToLengthBand exact =
+      fims_popdy::MakeAgeToLengthBand(conversion.data(), 2, 5, 0.0);
+    EXPECT_EQ(exact.first, std::vector<size_t>({1, 0}));
+    EXPECT_EQ(exact.size, std::vector<size_t>({3, 5}));
+    EXPECT_EQ(exact.NonZeros(), 8);
+
+    fims_popdy::AgeToLengthBand pruned =
+      fims_popdy::MakeAgeToLengthBand(conversion.data(), 2, 5, 1e-6);
+    EXPECT_EQ(pruned.first, std::vector<size_t>({1, 2}));
+    EXPECT_EQ(pruned.size, std::vector<size_t>({3, 2}));
+  }
+
+  // IO correctness
+  // Test that the projection over the bands of a realistic conversion matrix
+  // equals the dense projection, both with the entries that are exactly zero
+  // pruned and with a tolerance that prunes most of the matrix, and that
+  // Fleet::Initialize() resolves the band with the tolerance of the fleet
+  TEST(Fleet_MakeAgeToLengthBand, HandlesCorrectInput_ProjectAgeToLength)
+  {
+    size_t n_years = 10;
+    size_t n_ages = 30;
+    size_t n_lengths = 100;
+    std::vector<double> conversion = NormalConversion(n_ages, n_lengths, 3.0);
+    std::vector<std::vector<double>> at_age(
+      3, std::vector<double>(n_years * n_ages));
+    for (size_t r = 0; r < 3; r++)
+    {
+      for (size_t i = 0; i < n_years * n_ages; i++)
+      {
+        at_age[r][i] = static_cast<double>((r + 1) * (i % n_ages + 1));
+      }
+    }
+    const double *const inputs[3] = {at_age[0].data(), at_age[1].data(),
+                                     at_age[2].data()};
+
+    std::vector<std::vector<double>> dense(
+      3, std::vector<double>(n_years * n_lengths, 0.0));
+    double *const dense_outputs[3] = {dense[0].data(), dense[1].data(),
+                                      dense[2].data()};
+    fims_popdy::ProjectAgeToLength(n_years, n_ages, n_lengths,
+                                   conversion.data(),
+                                   fims_popdy::AgeToLengthBand(), inputs,
+                                   dense_outputs);
+
+    fims_popdy::Fleet<double> fleet;
+    fleet.n_years = n_years;
+    fleet.n_ages = n_ages;
+    fleet.n_lengths = n_lengths;
+    fleet.age_to_length_conversion = fims::Vector<double>(conversion);
+    fleet.age_to_length_tolerance = 1e-6;
+    fleet.Initialize();
+    EXPECT_LT(fleet.age_to_length_band.NonZeros(), n_ages * n_lengths / 2);
+
+    std::vector<std::vector<double>> banded(
+      3, std::vector<double>(n_years * n_lengths, 0.0));
+    double *const banded_outputs[3] = {banded[0].data(), banded[1].data(),
+                                       banded[2].data()};
+    fims_popdy::ProjectAgeToLength(n_years, n_ages, n_lengths,
+                                   conversion.data(),
+                                   fleet.age_to_length_band, inputs,
+                                   banded_outputs);
+    // each pruned entry changes an output by at most the tolerance times the
+    // value at age, so the difference is bounded by the sum over ages
+    for (size_t r = 0; r < 3; r++)
+    {
+      for (size_t y = 0; y < n_years; y++)
+      {
+        double bound = 0.0;
+        for (size_t a = 0; a < n_ages; a++)
+        {
+          bound += 1e-6 * at_age[r][y * n_ages + a];
+        }
+        for (size_t l = 0; l < n_lengths; l++)
+        {
+          size_t i = y * n_lengths + l;
+          EXPECT_NEAR(banded[r][i], dense[r][i], bound);
+        }
+      }
+    }
+
+    // with the entries below the tolerance set to zero, pruning the zeros
+    // gives the dense projection exactly
+    for (double &c : conversion)
+    {
+      c = c <= 1e-6 ? 0.0 : c;
+    }
+    std::vector<std::vector<double>> zeros(
+      3, std::vector<double>(n_years * n_lengths, 0.0));
+    double *const zero_outputs[3] = {zeros[0].data(), zeros[1].data(),
+                                     zeros[2].data()};
+    fims_popdy::ProjectAgeToLength(n_years, n_ages, n_lengths,
+                                   conversion.data(),
+                                   fims_popdy::AgeToLengthBand(), inputs,
+                                   zero_outputs);
+    for (size_t r = 0; r < 3; r++)
+    {
+      std::fill(banded[r].begin(), banded[r].end(), 0.0);
+    }
+    fims_popdy::ProjectAgeToLength(
+      n_years, n_ages, n_lengths, conversion.data(),
+      fims_popdy::MakeAgeToLengthBand(conversion.data(), n_ages, n_lengths,
+                                      0.0),
+      inputs, banded_outputs);
+    EXPECT_EQ(banded, zeros);
+  }
+
+  // Edge handling
+  // Test that a negative tolerance keeps all entries, that an age without
+  // entries above the tolerance has an empty band, and that a fleet without
+  // length bins has no band
+  TEST(Fleet_MakeAgeToLengthBand, HandlesEdgeCases)
+  {
+    std::vector<double> conversion = {0.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+    fims_popdy::AgeToLengthBand all =
+      fims_popdy::MakeAgeToLengthBand(conversion.data(), 2, 3, -1.0);
+    EXPECT_EQ(all.first, std::vector<size_t>({0, 0}));
+    EXPECT_EQ(all.size, std::vector<size_t>({3, 3}));
+
+    fims_popdy::AgeToLengthBand empty =
+      fims_popdy::MakeAgeToLengthBand(conversion.data(), 2, 3, 0.0);
+    EXPECT_EQ(empty.size, std::vector<size_t>({0, 1}));
+    EXPECT_EQ(empty.first[1], 1);
+
+    std::vector<double> at_age = {2.0, 3.0};
+    std::vector<double> a(3, 0.0), b(3, 0.0), c(3, 0.0);
+    const double *const inputs[3] = {at_age.data(), at_age.data(),
+                                     at_age.data()};
+    double *const outputs[3] = {a.data(), b.data(), c.data()};
+    fims_popdy::ProjectAgeToLength(1, 2, 3, conversion.data(), empty, inputs,
+                                   outputs);
+    EXPECT_EQ(a, std::vector<double>({0.0, 3.0, 0.0}));
+
+    fims_popdy::Fleet<double> fleet;
+    fleet.n_ages = 2;
+    fleet.n_lengths = 0;
+    fleet.Initialize();
+    EXPECT_TRUE(fleet.age_to_length_band.first.empty());
+  }
+}
@@ -0,0 +1,198 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include <random>
+
+#include "gtest/gtest.h"
+#include "models/functors/catch_at_age.hpp"
+
+namespace
+{
+  // Project values at age to length with a loop over years, length bins,
+  // and ages, i.e., without blocking
+  std::vector<double> ProjectUnblocked(size_t n_years, size_t n_ages,
+                                       size_t n_lengths,
+                                       const std::vector<double> &conversion,
+                                       const std::vector<double> &at_age)
+  {
+    std::vector<double> at_length(n_years * n_lengths, 0.0);
+    for (size_t y = 0; y < n_years; y++)
+    {
+      for (size_t l = 0; l < n_lengths; l++)
+      {
+        for (size_t a = 0; a < n_ages; a++)
+        {
+          at_length[y * n_lengths + l] +=
+            at_age[y * n_ages + a] * conversion[a * n_lengths + l];
+        }
+      }
+    }
+    return at_length;
+  }
+
+  // Fleet_ProjectAgeToLength
+  // IO correctness
+  // Test that the blocked projection of three right-hand sides gives the same
+  // values as an unblocked loop for dimensions that are not multiples of the
+  // block sizes or of the SIMD width
+  TEST(Fleet_ProjectAgeToLength, HandlesCorrectInput)
+  {
+    size_t n_years = 13;
+    size_t n_ages = 11;
+    size_t n_lengths = 71;
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    std::vector<double> conversion(n_ages * n_lengths);
+    for (double &c : conversion)
+    {
+      c = uniform(generator);
+    }
+    std::vector<std::vector<double>> at_age(
+      3, std::vector<double>(n_years * n_ages));
+    std::vector<std::vector<double>> at_length(
+      3, std::vector<double>(n_years * n_lengths, 0.0));
+    for (size_t r = 0; r < 3; r++)
+    {
+      for (double &x : at_age[r])
+      {
+        x = 1000.0 * uniform(generator);
+      }
+    }
+
+    const double *const inputs[3] = {at_age[0].data(), at_age[1].data(),
+                                     at_age[2].data()};
+    double *const outputs[3] = {at_length[0].data(), at_length[1].data(),
+                                at_length[2].data()};
+    fims_popdy::ProjectAgeToLength(n_years, n_ages, n_lengths,
+                                   conversion.data(),
+                                   fims_popdy::AgeToLengthBand(), inputs,
+                                   outputs);
+
+    for (size_t r = 0; r < 3; r++)
+    {
+      std::vector<double> expected =
+        ProjectUnblocked(n_years, n_ages, n_lengths, conversion, at_age[r]);
+      for (size_t i = 0; i < expected.size(); i++)
+      {
+        EXPECT_EQ(at_length[r][i], expected[i]);
+      }
+    }
+  }
+
+  // IO correctness
+  // Test that CatchAtAge::evaluate_length_comp() projects the expected age
+  // composition and the landings and index numbers at age to length and
+  // rescales the expected length composition to the observed total
+  TEST(Fleet_ProjectAgeToLength, HandlesCorrectInput_CatchAtAge)
+  {
+    size_t n_years = 5;
+    size_t n_ages = 4;
+    size_t n_lengths = 9;
+    fims_popdy::CatchAtAge<double> caa;
+    std::shared_ptr<fims_popdy::Fleet<double>> fleet =
+      std::make_shared<fims_popdy::Fleet<double>>();
+    fleet->n_years = n_years;
+    fleet->n_ages = n_ages;
+    fleet->n_lengths = n_lengths;
+    fleet->fleet_observed_lengthcomp_data_id_m = 0;
+    fleet->observed_lengthcomp_data =
+      std::make_shared<fims_data_object::DataObject<double>>(n_years,
+                                                             n_lengths);
+    caa.fleets[fleet->GetId()] = fleet;
+    caa.InitializeFleetDerivedQuantities(fleet->GetId());
+    std::map<std::string, fims::Vector<double>> &fdq =
+      caa.GetFleetDerivedQuantities(fleet->GetId());
+
+    std::vector<double> conversion(n_ages * n_lengths);
+    std::vector<double> agecomp(n_years * n_ages);
+    std::vector<double> landings(n_years * n_ages);
+    std::vector<double> index(n_years * n_ages);
+    for (size_t i = 0; i < conversion.size(); i++)
+    {
+      conversion[i] = 0.1 * static_cast<double>(i % 7 + 1);
+    }
+    for (size_t i = 0; i < agecomp.size(); i++)
+    {
+      agecomp[i] = static_cast<double>(i + 1);
+      landings[i] = 2.0 * static_cast<double>(i + 1);
+      index[i] = 3.0 * static_cast<double>(i + 1);
+    }
+    for (size_t i = 0; i < n_years * n_lengths; i++)
+    {
+      fleet->observed_lengthcomp_data->set(i, 2.0);
+    }
+    fleet->age_to_length_conversion = fims::Vector<double>(conversion);
+    fleet->Initialize();
+    fdq["agecomp_expected"] = fims::Vector<double>(agecomp);
+    fdq["landings_numbers_at_age"] = fims::Vector<double>(landings);
+    fdq["index_numbers_at_age"] = fims::Vector<double>(index);
+    for (const char *name : {"lengthcomp_expected", "lengthcomp_proportion",
+                             "landings_numbers_at_length",
+                             "index_numbers_at_length"})
+    {
+      fdq[name] = fims::Vector<double>(n_years * n_lengths, 0.0);
+    }
+
+    caa.evaluate_length_comp();
+
+    std::vector<double> expected_lengthcomp =
+      ProjectUnblocked(n_years, n_ages, n_lengths, conversion, agecomp);
+    std::vector<double> expected_landings =
+      ProjectUnblocked(n_years, n_ages, n_lengths, conversion, landings);
+    std::vector<double> expected_index =
+      ProjectUnblocked(n_years, n_ages, n_lengths, conversion, index);
+    for (size_t y = 0; y < n_years; y++)
+    {
+      double sum = 0.0;
+      for (size_t l = 0; l < n_lengths; l++)
+      {
+        sum += expected_lengthcomp[y * n_lengths + l];
+      }
+      for (size_t l = 0; l < n_lengths; l++)
+      {
+        size_t i = y * n_lengths + l;
+        double proportion = expected_lengthcomp[i] / sum;
+        EXPECT_EQ(fdq["landings_numbers_at_length"][i], expected_landings[i]);
+        EXPECT_EQ(fdq["index_numbers_at_length"][i], expected_index[i]);
+        EXPECT_EQ(fdq["lengthcomp_proportion"][i], proportion);
+        EXPECT_DOUBLE_EQ(fdq["lengthcomp_expected"][i],
+                         proportion * 2.0 * n_lengths);
+      }
+    }
+  }
+
+  // Edge handling
+  // Test that the projection leaves the outputs unchanged without years or
+  // without ages and accumulates into the outputs rather than overwriting
+  // them
+  TEST(Fleet_ProjectAgeToLength, HandlesEdgeCases)
+  {
+    std::vector<double> conversion = {0.25, 0.75};
+    std::vector<double> at_age = {4.0};
+    std::vector<double> at_length = {1.0, 1.0};
+    const double *const inputs[3] = {at_age.data(), at_age.data(),
+                                     at_age.data()};
+    fims_popdy::AgeToLengthBand band;
+    std::vector<double> other_a(2, 1.0);
+    std::vector<double> other_b(2, 1.0);
+    double *const separate[3] = {at_length.data(), other_a.data(),
+                                 other_b.data()};
+    fims_popdy::ProjectAgeToLength(0, 1, 2, conversion.data(), band, inputs,
+                                   separate);
+    fims_popdy::ProjectAgeToLength(1, 0, 2, conversion.data(), band, inputs,
+                                   separate);
+    EXPECT_EQ(at_length, std::vector<double>({1.0, 1.0}));
+
+    fims_popdy::ProjectAgeToLength(1, 1, 2, conversion.data(), band, inputs,
+                                   separate);
+    EXPECT_EQ(at_length, std::vector<double>({2.0, 4.0}));
+    EXPECT_EQ(other_a, std::vector<double>({2.0, 4.0}));
+  }
+}
@@ -0,0 +1,122 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "information.hpp"
+#include "test_stubs.hpp"
+namespace
+{
+  // Information_GetParameterBlockRange
+  // IO correctness
+  // Test that a block is found by its name and that the range addresses the
+  // registered parameter pointers of that block
+  TEST(Information_GetParameterBlockRange, HandlesCorrectInput)
+  {
+    fims_info::Information<double> info;
+    std::vector<double> log_M = {-1.0, -1.1, -1.2};
+    std::vector<double> log_Fmort = {-2.0, -2.1};
+
+    info.RegisterParameterName("Population.1.log_M.10");
+    info.RegisterParameter(log_M[0]);
+    info.RegisterParameterName("Population.1.log_M.11");
+    info.RegisterParameter(log_M[1]);
+    info.RegisterParameterName("Population.1.log_M.12");
+    info.RegisterParameter(log_M[2]);
+    info.RegisterParameterName("Fleet.2.log_Fmort.13");
+    info.RegisterParameter(log_Fmort[0]);
+    info.RegisterParameterName("Fleet.2.log_Fmort.14");
+    info.RegisterParameter(log_Fmort[1]);
+
+    std::pair<size_t, size_t> range =
+      info.GetParameterBlockRange(info.parameter_names, "Population.1.log_M");
+    EXPECT_EQ(range.first, 0);
+    EXPECT_EQ(range.second, 3);
+
+    range = info.GetParameterBlockRange(info.parameter_names, "Fleet.2.log_Fmort");
+    EXPECT_EQ(range.first, 3);
+    EXPECT_EQ(range.second, 2);
+    for (size_t i = 0; i < range.second; i++)
+    {
+      EXPECT_EQ(*info.fixed_effects_parameters[range.first + i], log_Fmort[i]);
+    }
+
+    // Test that the range of a block is read and written through the
+    // parameter storage without touching the other blocks
+    std::vector<double> values(range.second);
+    info.GetFixedEffectsRange(range.first, range.second, values.data());
+    EXPECT_EQ(values, log_Fmort);
+    std::vector<double> new_values = {-3.0, -3.1};
+    info.SetFixedEffectsRange(range.first, range.second, new_values.data());
+    EXPECT_EQ(log_Fmort, new_values);
+    EXPECT_EQ(log_M, std::vector<double>({-1.0, -1.1, -1.2}));
+  }
+
+  // Edge handling
+  // Test that a block name is not matched against the prefix of a longer
+  // module id, e.g., "Fleet.1" must not match "Fleet.10"
+  TEST(Information_GetParameterBlockRange, HandlesEdgeCases)
+  {
+    fims_info::Information<double> info;
+    info.RegisterParameterName("Fleet.10.log_q.1");
+    info.RegisterParameterName("Fleet.1.log_q.2");
+
+    std::pair<size_t, size_t> range =
+      info.GetParameterBlockRange(info.parameter_names, "Fleet.1.log_q");
+    EXPECT_EQ(range.first, 1);
+    EXPECT_EQ(range.second, 1);
+
+    // Test that a range spanning two runs of parameter storage and starting
+    // part way into the first run is copied correctly
+    fims_info::Information<double> info2;
+    std::vector<double> log_M = {-1.0, -1.1, -1.2};
+    std::vector<double> log_Fmort = {-2.0, -2.1};
+    for (size_t i = 0; i < log_M.size(); i++)
+    {
+      info2.RegisterParameter(log_M[i]);
+    }
+    for (size_t i = 0; i < log_Fmort.size(); i++)
+    {
+      info2.RegisterParameter(log_Fmort[i]);
+    }
+    std::vector<double> values(3);
+    info2.GetFixedEffectsRange(1, 3, values.data());
+    EXPECT_EQ(values, std::vector<double>({-1.1, -1.2, -2.0}));
+    std::vector<double> new_values = {1.1, 1.2, 2.0};
+    info2.SetFixedEffectsRange(1, 3, new_values.data());
+    EXPECT_EQ(log_M, std::vector<double>({-1.0, 1.1, 1.2}));
+    EXPECT_EQ(log_Fmort, std::vector<double>({2.0, -2.1}));
+  }
+
+  // Error handling
+  // Test that unknown and non-contiguous blocks throw
+  TEST(Information_GetParameterBlockRange, HandlesErrorCases)
+  {
+    fims_info::Information<double> info;
+    info.RegisterParameterName("Fleet.1.log_q.1");
+    info.RegisterParameterName("Fleet.2.log_q.2");
+    info.RegisterParameterName("Fleet.1.log_q.3");
+
+    EXPECT_THROW(
+      info.GetParameterBlockRange(info.parameter_names, "Fleet.3.log_q"),
+      std::invalid_argument);
+    EXPECT_THROW(
+      info.GetParameterBlockRange(info.parameter_names, "Fleet.1.log_q"),
+      std::invalid_argument);
+
+    // Test that a range past the end of the registered parameters throws
+    std::vector<double> q = {0.1, 0.2};
+    info.RegisterParameter(q[0]);
+    info.RegisterParameter(q[1]);
+    std::vector<double> values(2);
+    EXPECT_THROW(info.GetFixedEffectsRange(1, 2, values.data()),
+                 std::invalid_argument);
+    EXPECT_THROW(info.SetRandomEffectsRange(0, 1, values.data()),
+                 std::invalid_argument);
+  }
+}
@@ -0,0 +1,77 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "information.hpp"
+#include "test_stubs.hpp"
+namespace
+{
+  // Information_GetRetrospectiveWeights
+  // IO correctness
+  // Test that the terminal years of peeled data objects get a weight of zero,
+  // including every column of a two-dimensional data object, and that data
+  // objects that are not peeled keep all years
+  TEST(Information_GetRetrospectiveWeights, HandlesCorrectInput)
+  {
+    fims_info::Information<double> info;
+    std::shared_ptr<fims_data_object::DataObject<double>> landings =
+      std::make_shared<fims_data_object::DataObject<double>>(3);
+    landings->retrospective_peel = false;
+    std::shared_ptr<fims_data_object::DataObject<double>> age_comp =
+      std::make_shared<fims_data_object::DataObject<double>>(3, 2);
+    info.data_objects[landings->id] = landings;
+    info.data_objects[age_comp->id] = age_comp;
+
+    std::vector<double> weights = info.GetRetrospectiveWeights(1);
+    std::vector<double> expected = {1, 1, 1, 1, 1, 1, 1, 0, 0};
+    EXPECT_EQ(weights, expected);
+
+    // the weights reduce the likelihood contribution of the masked years and
+    // data objects that are not peeled are left unweighted
+    info.SetObservationWeights(weights.data());
+    EXPECT_FALSE(landings->has_weights());
+    EXPECT_EQ(landings->weight(2), 1.0);
+    EXPECT_TRUE(age_comp->has_weights());
+    EXPECT_EQ(age_comp->weight(3), 1.0);
+    EXPECT_EQ(age_comp->weight(4), 0.0);
+
+    // the weights are read in place and released with the observations
+    weights[3 + 3] = 0.0;
+    EXPECT_EQ(age_comp->weight(3), 0.0);
+    info.ClearObservedData();
+    EXPECT_FALSE(age_comp->has_weights());
+    EXPECT_EQ(age_comp->weight(4), 1.0);
+  }
+
+  // Edge handling
+  // Test that removing zero years keeps every observation and that removing
+  // more years than the data object has masks all of its observations
+  TEST(Information_GetRetrospectiveWeights, HandlesEdgeCases)
+  {
+    fims_info::Information<double> info;
+    std::shared_ptr<fims_data_object::DataObject<double>> index =
+      std::make_shared<fims_data_object::DataObject<double>>(2);
+    info.data_objects[index->id] = index;
+
+    EXPECT_EQ(info.GetRetrospectiveWeights(0), std::vector<double>(2, 1.0));
+    EXPECT_EQ(info.GetRetrospectiveWeights(5), std::vector<double>(2, 0.0));
+
+    // without weights every observation has a weight of one
+    EXPECT_FALSE(index->has_weights());
+    EXPECT_EQ(index->weight(1), 1.0);
+  }
+
+  // Error handling
+  // Test that a model without data objects returns no weights
+  TEST(Information_GetRetrospectiveWeights, HandlesErrorCases)
+  {
+    fims_info::Information<double> info;
+    EXPECT_TRUE(info.GetRetrospectiveWeights(1).empty());
+  }
+}
@@ -0,0 +1,91 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "information.hpp"
+#include "test_stubs.hpp"
+namespace
+{
+  // Information_ParameterSnapshot
+  // IO correctness
+  // Test that consecutive elements of a vector are grouped into one block
+  // and that block copies update the module storage in registration order
+  TEST(Information_ParameterSnapshot, HandlesCorrectInput)
+  {
+    fims_info::Information<double> info;
+    fims::Vector<double> log_M(3, 0.0);
+    fims::Vector<double> log_q(1, 0.0);
+    fims::Vector<double> log_devs(2, 0.0);
+
+    for (size_t i = 0; i < log_M.size(); i++)
+    {
+      info.RegisterParameter(log_M[i]);
+    }
+    info.RegisterParameter(log_q[0]);
+    for (size_t i = 0; i < log_devs.size(); i++)
+    {
+      info.RegisterRandomEffect(log_devs[i]);
+    }
+
+    EXPECT_EQ(info.fixed_effects_blocks.size(), 2);
+    EXPECT_EQ(info.fixed_effects_blocks[0].size, 3);
+    EXPECT_EQ(info.fixed_effects_blocks[1].offset, 3);
+    EXPECT_EQ(info.random_effects_blocks.size(), 1);
+
+    std::vector<double> p = {-0.1, -0.2, -0.3, 1.5};
+    std::vector<double> re = {0.25, -0.25};
+    info.SetFixedEffects(p.data());
+    info.SetRandomEffects(re.data());
+    EXPECT_EQ(log_M[0], -0.1);
+    EXPECT_EQ(log_M[2], -0.3);
+    EXPECT_EQ(log_q[0], 1.5);
+    EXPECT_EQ(log_devs[1], -0.25);
+
+    std::vector<double> out(4);
+    info.GetFixedEffects(out.data());
+    EXPECT_EQ(out, p);
+
+    std::vector<double> snapshot = info.GetParameterSnapshot();
+    EXPECT_EQ(snapshot.size(), 6);
+    log_M[1] = 10.0;
+    log_devs[0] = 10.0;
+    info.RestoreParameterSnapshot(snapshot);
+    EXPECT_EQ(log_M[1], -0.2);
+    EXPECT_EQ(log_devs[0], 0.25);
+  }
+
+  // Edge handling
+  // Test that an empty model produces an empty snapshot and that the
+  // registration of a non-adjacent element starts a new block
+  TEST(Information_ParameterSnapshot, HandlesEdgeCases)
+  {
+    fims_info::Information<double> info;
+    EXPECT_EQ(info.GetParameterSnapshot().size(), 0);
+
+    fims::Vector<double> x(3, 0.0);
+    info.RegisterParameter(x[0]);
+    info.RegisterParameter(x[2]);
+    EXPECT_EQ(info.fixed_effects_blocks.size(), 2);
+
+    info.Clear();
+    EXPECT_EQ(info.fixed_effects_blocks.size(), 0);
+  }
+
+  // Error handling
+  // Test that restoring a snapshot of the wrong size throws
+  TEST(Information_ParameterSnapshot, HandlesErrorCases)
+  {
+    fims_info::Information<double> info;
+    fims::Vector<double> x(2, 0.0);
+    info.RegisterParameter(x[0]);
+    info.RegisterParameter(x[1]);
+    EXPECT_THROW(info.RestoreParameterSnapshot(std::vector<double>(1, 0.0)),
+                 std::invalid_argument);
+  }
+}
@@ -0,0 +1,81 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "information.hpp"
+#include "test_stubs.hpp"
+namespace
+{
+  // Information_SetObservedData
+  // IO correctness
+  // Test that the observations are split across data objects in id order and
+  // that reads return the supplied values instead of the stored observations
+  TEST(Information_SetObservedData, HandlesCorrectInput)
+  {
+    fims_info::Information<double> info;
+    std::shared_ptr<fims_data_object::DataObject<double>> landings =
+      std::make_shared<fims_data_object::DataObject<double>>(2);
+    std::shared_ptr<fims_data_object::DataObject<double>> index =
+      std::make_shared<fims_data_object::DataObject<double>>(3);
+    landings->set(0, 1.0);
+    landings->set(1, 2.0);
+    info.data_objects[landings->id] = landings;
+    info.data_objects[index->id] = index;
+
+    EXPECT_EQ(info.GetNumberOfObservations(), 5);
+
+    std::vector<double> obs = {10.0, 20.0, 30.0, 40.0, 50.0};
+    info.SetObservedData(obs.data());
+    EXPECT_EQ(landings->at(0), 10.0);
+    EXPECT_EQ(landings->at(1), 20.0);
+    EXPECT_EQ(index->at(0), 30.0);
+    EXPECT_EQ(index->at(2), 50.0);
+    // the stored observations are unchanged
+    EXPECT_EQ((*landings->data)[0], 1.0);
+
+    // the values are read in place, so a change is seen without a copy
+    obs[1] = -999.0;
+    EXPECT_EQ(landings->at(1), -999.0);
+
+    // once cleared, reads return the stored observations again
+    info.ClearObservedData();
+    EXPECT_EQ(landings->at(1), 2.0);
+    EXPECT_EQ(index->tape_values, nullptr);
+  }
+
+  // Edge handling
+  // Test that a model without data objects has no observations and that
+  // simulated values are written through to the supplied values
+  TEST(Information_SetObservedData, HandlesEdgeCases)
+  {
+    fims_info::Information<double> info;
+    EXPECT_EQ(info.GetNumberOfObservations(), 0);
+    std::vector<double> obs;
+    EXPECT_NO_THROW(info.SetObservedData(obs.data()));
+
+    fims_data_object::DataObject<double> observed(2);
+    std::vector<double> values = {1.0, 2.0};
+    observed.set_tape_values(values.data());
+    observed.set_simulated(1, 5.0);
+    EXPECT_EQ(observed.at(1), 5.0);
+    EXPECT_EQ(values[1], 5.0);
+    EXPECT_EQ((*observed.data)[1], 5.0);
+  }
+
+  // Error handling
+  // Test that reads outside of the data object still throw once values are
+  // supplied
+  TEST(Information_SetObservedData, HandlesErrorCases)
+  {
+    fims_data_object::DataObject<double> observed(2);
+    std::vector<double> values = {1.0, 2.0};
+    observed.set_tape_values(values.data());
+    EXPECT_THROW(observed.at(2), std::overflow_error);
+  }
+}
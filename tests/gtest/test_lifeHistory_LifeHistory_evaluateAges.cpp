@@ -0,0 +1,100 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "growth/functors/ewaa.hpp"
+#include "population_dynamics/maturity/functors/logistic.hpp"
+#include "selectivity/functors/double_logistic.hpp"
+#include "selectivity/functors/logistic.hpp"
+
+namespace
+{
+  // LifeHistory_evaluateAges
+  // IO correctness
+  // Test that the batched evaluation of each life-history module matches
+  // the scalar evaluation at every age, including time-varying parameters
+  TEST(LifeHistory_evaluateAges, HandlesCorrectInput)
+  {
+    std::vector<double> ages = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    size_t n = ages.size();
+    std::vector<double> out(n);
+
+    fims_popdy::LogisticSelectivity<double> selectivity;
+    selectivity.inflection_point = fims::Vector<double>({3.0, 4.0});
+    selectivity.slope = fims::Vector<double>({1.5, 0.5});
+    for (size_t year = 0; year < 2; year++)
+    {
+      selectivity.evaluate_ages(ages.data(), n, year, out.data());
+      for (size_t i = 0; i < n; i++)
+      {
+        EXPECT_DOUBLE_EQ(out[i], selectivity.evaluate(ages[i], year));
+      }
+    }
+
+    fims_popdy::DoubleLogisticSelectivity<double> double_logistic;
+    double_logistic.inflection_point_asc = fims::Vector<double>({2.0});
+    double_logistic.slope_asc = fims::Vector<double>({1.0});
+    double_logistic.inflection_point_desc = fims::Vector<double>({6.0});
+    double_logistic.slope_desc = fims::Vector<double>({0.8});
+    double_logistic.evaluate_ages(ages.data(), n, 3, out.data());
+    for (size_t i = 0; i < n; i++)
+    {
+      EXPECT_DOUBLE_EQ(out[i], double_logistic.evaluate(ages[i], 3));
+    }
+
+    fims_popdy::LogisticMaturity<double> maturity;
+    maturity.inflection_point = fims::Vector<double>({2.5});
+    maturity.slope = fims::Vector<double>({2.0});
+    maturity.evaluate_ages(ages.data(), n, 0, out.data());
+    for (size_t i = 0; i < n; i++)
+    {
+      EXPECT_DOUBLE_EQ(out[i], maturity.evaluate(ages[i]));
+    }
+
+    fims_popdy::EWAAGrowth<double> growth;
+    for (int year = 0; year < 3; year++)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        growth.ewaa[year][ages[i]] = 0.1 * (year + 1) * ages[i];
+      }
+    }
+    growth.evaluate_ages(ages.data(), n, 2, out.data());
+    for (size_t i = 0; i < n; i++)
+    {
+      EXPECT_DOUBLE_EQ(out[i], growth.evaluate(2, ages[i]));
+    }
+  }
+
+  // Edge handling
+  // Test that an empty vector of ages writes nothing
+  TEST(LifeHistory_evaluateAges, HandlesEdgeCases)
+  {
+    fims_popdy::LogisticSelectivity<double> selectivity;
+    selectivity.inflection_point = fims::Vector<double>({3.0});
+    selectivity.slope = fims::Vector<double>({1.5});
+    double out = -1.0;
+    selectivity.evaluate_ages(nullptr, 0, 0, &out);
+    EXPECT_EQ(out, -1.0);
+  }
+
+  // Error handling
+  // Test that a year beyond time-varying parameters throws like the scalar
+  // evaluation
+  TEST(LifeHistory_evaluateAges, HandlesErrors)
+  {
+    std::vector<double> ages = {1.0, 2.0};
+    std::vector<double> out(2);
+    fims_popdy::LogisticSelectivity<double> selectivity;
+    selectivity.inflection_point = fims::Vector<double>({3.0, 4.0});
+    selectivity.slope = fims::Vector<double>({1.5, 0.5});
+    EXPECT_THROW(selectivity.evaluate_ages(ages.data(), 2, 2, out.data()),
+                 std::invalid_argument);
+  }
+}
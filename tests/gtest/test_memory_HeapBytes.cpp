@@ -0,0 +1,99 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/common/memory.hpp"
+#include "../../inst/include/common/information.hpp"
+#include "../../inst/include/population_dynamics/population/population.hpp"
+
+namespace
+{
+  // HeapBytes
+  // IO correctness
+  // Test that the bytes of containers follow their capacities and elements
+  TEST(HeapBytes, HandlesCorrectInput)
+  {
+    std::vector<double> x(10);
+    EXPECT_EQ(fims::HeapBytes(x), x.capacity() * sizeof(double));
+
+    fims::Vector<double> y(5);
+    EXPECT_EQ(fims::HeapBytes(y), y.capacity() * sizeof(double));
+
+    std::vector<std::vector<double>> z(2, std::vector<double>(3));
+    EXPECT_EQ(fims::HeapBytes(z),
+              z.capacity() * sizeof(std::vector<double>) +
+                  fims::HeapBytes(z[0]) + fims::HeapBytes(z[1]));
+
+    std::map<uint32_t, std::vector<double>> m;
+    m[1] = std::vector<double>(4);
+    EXPECT_EQ(fims::HeapBytes(m),
+              sizeof(std::pair<const uint32_t, std::vector<double>>) +
+                  fims::NodeOverheadBytes() + fims::HeapBytes(m[1]));
+
+    std::string s(1000, 'a');
+    EXPECT_GE(fims::HeapBytes(s), 1000);
+  }
+
+  // Test that shared storage is split evenly among its owners
+  TEST(SharedHeapBytes, HandlesCorrectInput)
+  {
+    std::shared_ptr<std::vector<double>> a =
+        std::make_shared<std::vector<double>>(100);
+    size_t alone = fims::SharedHeapBytes(a);
+    std::shared_ptr<std::vector<double>> b = a;
+    EXPECT_EQ(fims::SharedHeapBytes(a), alone / 2);
+    EXPECT_EQ(fims::SharedHeapBytes(a) + fims::SharedHeapBytes(b),
+              2 * (alone / 2));
+  }
+
+  // Test that the bytes of a population and of the Information report grow
+  // with the size of its vectors
+  TEST(OwnedBytes, HandlesCorrectInput)
+  {
+    std::shared_ptr<fims_info::Information<double>> info =
+        fims_info::Information<double>::GetInstance();
+    info->Clear();
+    std::shared_ptr<fims_popdy::Population<double>> population =
+        std::make_shared<fims_popdy::Population<double>>();
+    size_t empty = population->OwnedBytes();
+    population->log_M.resize(1000);
+    EXPECT_GE(population->OwnedBytes(), empty + 1000 * sizeof(double));
+
+    info->populations[population->GetId()] = population;
+    std::map<std::string, fims_model_object::MemoryUsage> usage =
+        info->GetMemoryUsage();
+    EXPECT_EQ(usage["populations"].objects, 1);
+    EXPECT_EQ(usage["populations"].bytes, population->OwnedBytes());
+    EXPECT_EQ(usage["fleets"].objects, 0);
+    EXPECT_EQ(usage["information"].objects, 1);
+    info->Clear();
+  }
+
+  // Edge handling
+  // Test that empty and null values own no heap bytes
+  TEST(HeapBytes, HandlesEdgeCases)
+  {
+    EXPECT_EQ(fims::HeapBytes(3.0), 0);
+    EXPECT_EQ(fims::HeapBytes(std::string()), 0);
+    EXPECT_EQ(fims::HeapBytes(std::map<int, double>()), 0);
+    std::shared_ptr<std::vector<double>> null_ptr;
+    EXPECT_EQ(fims::SharedHeapBytes(null_ptr), 0);
+  }
+
+  // Test that the peak only increases
+  TEST(UpdatePeakBytes, HandlesEdgeCases)
+  {
+    fims_model_object::FIMSMemoryTracker::peak_bytes = 0;
+    fims_model_object::FIMSMemoryTracker::UpdatePeakBytes(100);
+    fims_model_object::FIMSMemoryTracker::UpdatePeakBytes(50);
+    EXPECT_EQ(fims_model_object::FIMSMemoryTracker::peak_bytes, 100);
+    fims_model_object::FIMSMemoryTracker::UpdatePeakBytes(200);
+    EXPECT_EQ(fims_model_object::FIMSMemoryTracker::peak_bytes, 200);
+  }
+}
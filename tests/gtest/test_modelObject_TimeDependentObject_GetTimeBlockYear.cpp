@@ -0,0 +1,85 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "population/population.hpp"
+#include "../../tests/gtest/test_population_test_fixture.hpp"
+
+namespace
+{
+  // TimeDependentObject_GetTimeBlockYear
+  // IO correctness
+  // Test the block year of each year for the three kinds of time dependence
+  // and that logistic modules with scalar parameters are time invariant
+  TEST(TimeDependentObject_GetTimeBlockYear, HandlesCorrectInput)
+  {
+    fims_popdy::LogisticSelectivity<double> selectivity;
+    selectivity.inflection_point.resize(1);
+    selectivity.slope.resize(1);
+    EXPECT_EQ(selectivity.GetTimeDependence(),
+              fims_model_object::TimeInvariant);
+    EXPECT_EQ(selectivity.GetTimeBlockYear(7), 0);
+
+    selectivity.inflection_point.resize(10);
+    EXPECT_EQ(selectivity.GetTimeDependence(), fims_model_object::PerYear);
+    EXPECT_EQ(selectivity.GetTimeBlockYear(7), 7);
+
+    selectivity.time_dependence = fims_model_object::BlockVarying;
+    selectivity.block_start_years = {2, 5};
+    std::vector<size_t> expected = {0, 0, 2, 2, 2, 5, 5, 5, 5, 5};
+    for (size_t year = 0; year < expected.size(); year++)
+    {
+      EXPECT_EQ(selectivity.GetTimeBlockYear(year), expected[year]);
+    }
+
+    fims_popdy::LogisticMaturity<double> maturity;
+    maturity.inflection_point.resize(1);
+    maturity.slope.resize(1);
+    EXPECT_EQ(maturity.GetTimeDependence(), fims_model_object::TimeInvariant);
+
+    fims_popdy::EWAAGrowth<double> growth;
+    EXPECT_EQ(growth.GetTimeDependence(), fims_model_object::PerYear);
+    EXPECT_EQ(growth.GetTimeBlockYear(3), 3);
+  }
+
+  // Edge handling
+  // Test that Prepare() evaluates selectivity and weight at age once per
+  // block of years and copies the values to the other years of the block
+  TEST_F(CAAEvaluateTestFixture, HandlesEdgeCases_TimeDependentObject_GetTimeBlockYear)
+  {
+    population->growth->time_dependence = fims_model_object::BlockVarying;
+    population->growth->block_start_years = {3};
+    catch_at_age_model->Prepare();
+
+    for (size_t year = 0; year <= population->n_years; year++)
+    {
+      size_t block_year = year < 3 ? 0 : 3;
+      for (size_t age = 0; age < population->n_ages; age++)
+      {
+        EXPECT_EQ(population->weight_at_age[year * population->n_ages + age],
+                  population->growth->evaluate(block_year,
+                                               population->ages[age]));
+      }
+    }
+
+    for (size_t f = 0; f < population->fleets.size(); f++)
+    {
+      std::shared_ptr<fims_popdy::Fleet<double>> &fleet =
+        population->fleets[f];
+      for (size_t year = 0; year < population->n_years; year++)
+      {
+        for (size_t age = 0; age < population->n_ages; age++)
+        {
+          EXPECT_EQ(fleet->selectivity_at_age[year * population->n_ages + age],
+                    fleet->selectivity->evaluate(population->ages[age]));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,99 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "model.hpp"
+#include "test_stubs.hpp"
+#include "test_synthetic_model_generator.hpp"
+namespace
+{
+  // Fishery model that counts how often it is evaluated and reported
+  class CountingFisheryModel : public fims_popdy::FisheryModelBase<double>
+  {
+  public:
+    size_t n_prepare = 0;
+    size_t n_evaluate = 0;
+    size_t n_report = 0;
+
+    virtual void Prepare() { n_prepare += 1; }
+    virtual void Evaluate() { n_evaluate += 1; }
+    virtual void Report() { n_report += 1; }
+  };
+
+  // Model_Evaluate
+  // IO correctness
+  // Test that every evaluation prepares and evaluates the fishery models and
+  // that Report() is skipped because no TMB objective function collects the
+  // reported values
+  TEST(Model_Evaluate, HandlesCorrectInput)
+  {
+    std::shared_ptr<fims_info::Information<double>> info =
+      std::make_shared<fims_info::Information<double>>();
+    fims_model::Model<double> model;
+    model.fims_information = info;
+    std::shared_ptr<CountingFisheryModel> fishery_model =
+      std::make_shared<CountingFisheryModel>();
+    info->models_map[fishery_model->GetId()] = fishery_model;
+
+    EXPECT_FALSE(model.IsCollectingReport());
+    EXPECT_FALSE(model.IsCollectingAdreport());
+    for (size_t i = 0; i < 3; i++)
+    {
+      EXPECT_EQ(model.Evaluate(), 0.0);
+    }
+    EXPECT_EQ(fishery_model->n_prepare, 3);
+    EXPECT_EQ(fishery_model->n_evaluate, 3);
+    EXPECT_EQ(fishery_model->n_report, 0);
+    fims::FIMSLog::fims_log->clear();
+  }
+
+  // IO correctness
+  // Test that a catch-at-age model is prepared once per evaluation, i.e.,
+  // that CatchAtAge::Evaluate() does not repeat Model::Evaluate()
+  TEST(Model_Evaluate, HandlesCorrectInput_Prepare)
+  {
+    SyntheticModelDimensions dims;
+    SyntheticModel<double> model =
+      SyntheticModelGenerator(dims, 3).Generate<double>();
+    fims::FIMSTimer::Clear();
+    fims::FIMSTimer::enabled = true;
+    model.Evaluate();
+    model.Evaluate();
+    fims::FIMSTimer::enabled = false;
+    EXPECT_EQ(fims::FIMSTimer::statistics[fims::FIMSTimer::Key(
+                "CatchAtAge", model.catch_at_age->GetId(), "double",
+                "Prepare")].calls,
+              2);
+    fims::FIMSTimer::Clear();
+    fims::FIMSLog::fims_log->clear();
+  }
+
+  // Edge handling
+  // Test that a model without fishery models evaluates to zero
+  TEST(Model_Evaluate, HandlesEdgeCases)
+  {
+    fims_model::Model<double> model;
+    model.fims_information =
+      std::make_shared<fims_info::Information<double>>();
+    EXPECT_EQ(model.Evaluate(), 0.0);
+    fims::FIMSLog::fims_log->clear();
+  }
+
+  // Error handling
+  // Test that a model without information returns zero and logs an error
+  TEST(Model_Evaluate, HandlesErrors)
+  {
+    fims::FIMSLog::fims_log->clear();
+    fims_model::Model<double> model;
+    EXPECT_EQ(model.Evaluate(), 0.0);
+    EXPECT_EQ(fims::FIMSLog::fims_log->get_error_count(), 1);
+    fims::FIMSLog::fims_log->clear();
+  }
+
+} // namespace
@@ -0,0 +1,153 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "model.hpp"
+#include "test_stubs.hpp"
+namespace
+{
+  // Add a data likelihood to info with observations and expected values
+  template <class Distribution>
+  std::shared_ptr<Distribution> AddDataComponent(
+      fims_info::Information<double>& info,
+      std::shared_ptr<fims_data_object::DataObject<double>> data,
+      fims::Vector<double>& expected)
+  {
+    std::shared_ptr<Distribution> component =
+      std::make_shared<Distribution>();
+    component->input_type = "data";
+    component->data_observed_values = data;
+    component->data_expected_values = &expected;
+    component->observed_data_id_m = data->id;
+    info.data_objects[data->id] = data;
+    info.density_components[component->id] = component;
+    return component;
+  }
+
+  // Model_SimulateData
+  // IO correctness
+  // Test that each data object gets n_replicates values in flattened order,
+  // that the draws are centered on the expected values, and that the results
+  // do not depend on the number of threads
+  TEST(Model_SimulateData, HandlesCorrectInput)
+  {
+    std::shared_ptr<fims_info::Information<double>> info =
+      std::make_shared<fims_info::Information<double>>();
+    fims_model::Model<double> model;
+    model.fims_information = info;
+
+    std::shared_ptr<fims_data_object::DataObject<double>> index =
+      std::make_shared<fims_data_object::DataObject<double>>(3);
+    fims::Vector<double> expected_index(3);
+    for (size_t i = 0; i < 3; i++)
+    {
+      index->set(i, 1.0);
+      expected_index[i] = 10.0 * (i + 1);
+    }
+    std::shared_ptr<fims_distributions::NormalLPDF<double>> normal =
+      AddDataComponent<fims_distributions::NormalLPDF<double>>(
+        *info, index, expected_index);
+    normal->log_sd.resize(1);
+    normal->log_sd[0] = std::log(0.1);
+
+    std::shared_ptr<fims_data_object::DataObject<double>> agecomp =
+      std::make_shared<fims_data_object::DataObject<double>>(2, 3);
+    fims::Vector<double> expected_agecomp(6);
+    for (size_t i = 0; i < 6; i++)
+    {
+      agecomp->set(i, 10.0);
+      expected_agecomp[i] = static_cast<double>(i % 3 + 1);
+    }
+    AddDataComponent<fims_distributions::MultinomialLPMF<double>>(
+      *info, agecomp, expected_agecomp);
+
+    size_t n_replicates = 200;
+    std::map<uint32_t, std::vector<double>> one_thread =
+      model.SimulateData(n_replicates, 42, 1);
+    ASSERT_EQ(one_thread.size(), 2);
+    ASSERT_EQ(one_thread[index->id].size(), n_replicates * 3);
+    ASSERT_EQ(one_thread[agecomp->id].size(), n_replicates * 6);
+
+    std::vector<double> mean(3, 0.0);
+    for (size_t r = 0; r < n_replicates; r++)
+    {
+      for (size_t i = 0; i < 3; i++)
+      {
+        mean[i] += one_thread[index->id][r * 3 + i] / n_replicates;
+      }
+      for (size_t i = 0; i < 2; i++)
+      {
+        double row_sum = 0.0;
+        for (size_t j = 0; j < 3; j++)
+        {
+          row_sum += one_thread[agecomp->id][r * 6 + i * 3 + j];
+        }
+        EXPECT_EQ(row_sum, 30.0);
+      }
+    }
+    for (size_t i = 0; i < 3; i++)
+    {
+      EXPECT_NEAR(mean[i], expected_index[i], 0.1);
+    }
+
+    std::map<uint32_t, std::vector<double>> four_threads =
+      model.SimulateData(n_replicates, 42, 4);
+    EXPECT_EQ(one_thread, four_threads);
+    std::map<uint32_t, std::vector<double>> other_seed =
+      model.SimulateData(n_replicates, 43, 4);
+    EXPECT_NE(one_thread[index->id], other_seed[index->id]);
+  }
+
+  // Edge handling
+  // Test that missing values stay missing, that zero replicates return empty
+  // replicates, and that a model without data likelihoods returns nothing
+  TEST(Model_SimulateData, HandlesEdgeCases)
+  {
+    std::shared_ptr<fims_info::Information<double>> info =
+      std::make_shared<fims_info::Information<double>>();
+    fims_model::Model<double> model;
+    model.fims_information = info;
+    EXPECT_TRUE(model.SimulateData(5, 1, 2).empty());
+
+    std::shared_ptr<fims_data_object::DataObject<double>> landings =
+      std::make_shared<fims_data_object::DataObject<double>>(2);
+    landings->set(0, 100.0);
+    landings->set(1, -999.0);
+    // the lognormal expected values are on the log scale
+    fims::Vector<double> expected_landings(2, std::log(100.0));
+    std::shared_ptr<fims_distributions::LogNormalLPDF<double>> lognormal =
+      AddDataComponent<fims_distributions::LogNormalLPDF<double>>(
+        *info, landings, expected_landings);
+    lognormal->log_sd.resize(1);
+    lognormal->log_sd[0] = std::log(0.01);
+
+    std::map<uint32_t, std::vector<double>> simulated =
+      model.SimulateData(3, 1, 2);
+    for (size_t r = 0; r < 3; r++)
+    {
+      EXPECT_NEAR(simulated[landings->id][r * 2], 100.0, 10.0);
+      EXPECT_EQ(simulated[landings->id][r * 2 + 1], -999.0);
+    }
+    EXPECT_TRUE(model.SimulateData(0, 1, 2)[landings->id].empty());
+  }
+
+  // Error handling
+  // Test that a distribution without a simulator throws
+  TEST(Model_SimulateData, HandlesErrorCases)
+  {
+    fims_distributions::DensityComponentBase<double>* base =
+      new fims_distributions::NormalLPDF<double>();
+    std::mt19937_64 rng(1);
+    double out[1];
+    EXPECT_THROW(
+      base->DensityComponentBase<double>::simulate_replicate(rng, out),
+      std::invalid_argument);
+    delete base;
+  }
+}
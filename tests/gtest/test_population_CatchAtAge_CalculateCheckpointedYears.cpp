@@ -0,0 +1,140 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "test_stubs.hpp"
+#include "test_synthetic_model_generator.hpp"
+
+namespace
+{
+  typedef std::map<uint32_t, std::map<std::string, std::vector<double>>>
+      DerivedQuantitiesCopy;
+
+  // Copy the derived quantities of all populations or fleets
+  DerivedQuantitiesCopy CopyDerivedQuantities(
+      std::map<uint32_t, std::map<std::string, fims::Vector<double>>> &dq)
+  {
+    DerivedQuantitiesCopy copy;
+    for (auto &id : dq)
+    {
+      for (auto &kv : id.second)
+      {
+        copy[id.first][kv.first] =
+            std::vector<double>(kv.second.begin(), kv.second.end());
+      }
+    }
+    return copy;
+  }
+
+  // CatchAtAge_CalculateCheckpointedYears
+  // IO correctness
+  // Test that the one-year update gives the mortality, numbers, plus group,
+  // and landings of the equations for two ages and two fleets
+  TEST(CatchAtAge_CalculateCheckpointedYears, HandlesCorrectInput)
+  {
+    fims_popdy::CatchAtAgeYear<double> update;
+    update.Resize(3, 2);
+    EXPECT_EQ(update.inputs.size(), 2 * 3 + 2 + 2 * 3);
+    EXPECT_EQ(update.outputs.size(), 3 * 3 - 1 + 2 * 3);
+    std::vector<double> N = {100.0, 50.0, 20.0};
+    std::vector<double> M = {0.2, 0.2, 0.3};
+    std::vector<double> fleet_F = {0.1, 0.4};
+    std::vector<double> S = {0.5, 1.0, 1.0, 0.0, 0.5, 1.0};
+    for (size_t a = 0; a < 3; a++)
+    {
+      update.inputs[a] = N[a];
+      update.inputs[update.MIndex() + a] = M[a];
+    }
+    for (size_t f = 0; f < 2; f++)
+    {
+      update.inputs[update.FleetFIndex() + f] = fleet_F[f];
+      for (size_t a = 0; a < 3; a++)
+      {
+        update.inputs[update.SelectivityIndex(f) + a] = S[f * 3 + a];
+      }
+    }
+    update.Evaluate();
+
+    std::vector<double> Z(3);
+    for (size_t a = 0; a < 3; a++)
+    {
+      double F = 0.1 * S[a] + 0.4 * S[3 + a];
+      Z[a] = M[a] + F;
+      EXPECT_DOUBLE_EQ(update.outputs[a], F);
+      EXPECT_DOUBLE_EQ(update.outputs[update.ZIndex() + a], Z[a]);
+      for (size_t f = 0; f < 2; f++)
+      {
+        EXPECT_DOUBLE_EQ(update.outputs[update.LandingsIndex(f) + a],
+                         fleet_F[f] * S[f * 3 + a] / Z[a] * N[a] *
+                             (1.0 - std::exp(-Z[a])));
+      }
+    }
+    EXPECT_DOUBLE_EQ(update.outputs[update.NumbersIndex()],
+                     N[0] * std::exp(-Z[0]));
+    EXPECT_DOUBLE_EQ(update.outputs[update.NumbersIndex() + 1],
+                     N[1] * std::exp(-Z[1]) + N[2] * std::exp(-Z[2]));
+  }
+
+  // IO correctness
+  // Test that the checkpointed years give exactly the derived quantities and
+  // objective function of the loop over years and ages for a model with
+  // several fleets and time-varying selectivity and mortality
+  TEST(CatchAtAge_CalculateCheckpointedYears, HandlesCorrectInput_Evaluate)
+  {
+    SyntheticModelDimensions dims;
+    dims.n_fleets = 3;
+    dims.n_ages = 10;
+    dims.n_years = 25;
+    dims.n_lengths = 12;
+    dims.n_data = 4;
+    dims.time_varying_selectivity = true;
+    dims.time_varying_mortality = true;
+    SyntheticModel<double> model =
+        SyntheticModelGenerator(dims, 7).Generate<double>();
+
+    double unrolled_jnll = model.Evaluate();
+    DerivedQuantitiesCopy population_dq = CopyDerivedQuantities(
+        model.catch_at_age->GetPopulationDerivedQuantities());
+    DerivedQuantitiesCopy fleet_dq =
+        CopyDerivedQuantities(model.catch_at_age->GetFleetDerivedQuantities());
+
+    model.catch_at_age->checkpoint_years = true;
+    double checkpointed_jnll = model.Evaluate();
+    EXPECT_EQ(model.catch_at_age->year_updates.size(), 1);
+    EXPECT_EQ(checkpointed_jnll, unrolled_jnll);
+    EXPECT_EQ(CopyDerivedQuantities(
+                  model.catch_at_age->GetPopulationDerivedQuantities()),
+              population_dq);
+    EXPECT_EQ(
+        CopyDerivedQuantities(model.catch_at_age->GetFleetDerivedQuantities()),
+        fleet_dq);
+  }
+
+  // Edge handling
+  // Test that a single age is not carried into a plus group, that a
+  // population without fleets only has natural mortality, and that the
+  // update keeps its size until the number of ages or fleets changes
+  TEST(CatchAtAge_CalculateCheckpointedYears, HandlesEdgeCases)
+  {
+    fims_popdy::CatchAtAgeYear<double> single;
+    single.Resize(1, 0);
+    EXPECT_EQ(single.outputs.size(), 2);
+    single.inputs = {10.0, 0.5};
+    single.Evaluate();
+    EXPECT_EQ(single.outputs, std::vector<double>({0.0, 0.5}));
+
+    fims_popdy::CatchAtAgeYear<double> empty;
+    empty.Resize(0, 2);
+    EXPECT_TRUE(empty.outputs.empty());
+    EXPECT_NO_THROW(empty.Evaluate());
+    empty.Resize(4, 2);
+    EXPECT_EQ(empty.inputs.size(), 2 * 4 + 2 + 2 * 4);
+    EXPECT_EQ(empty.LandingsIndex(1), 3 * 4 - 1 + 4);
+  }
+}
@@ -0,0 +1,197 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "population/population.hpp"
+#include "../../tests/gtest/test_population_test_fixture.hpp"
+
+namespace
+{
+
+    // Expected unfished numbers at age from the recursion with natural
+    // mortality
+    std::vector<double> ExpectedUnfishedNumbersAA(
+        std::shared_ptr<fims_popdy::Population<double>> &population)
+    {
+        size_t n_ages = population->n_ages;
+        size_t n_years = population->n_years;
+        std::vector<double> expected((n_years + 1) * n_ages, 0.0);
+        for (size_t year = 0; year <= n_years; year++)
+        {
+            for (size_t age = 0; age < n_ages; age++)
+            {
+                size_t i_age_year = year * n_ages + age;
+                if (age == 0)
+                {
+                    expected[i_age_year] =
+                        fims_math::exp(population->recruitment->log_rzero[0]);
+                    continue;
+                }
+                size_t i_agem1_yearm1 =
+                    year == 0 ? age - 1 : (year - 1) * n_ages + (age - 1);
+                expected[i_age_year] = expected[i_agem1_yearm1] *
+                                       fims_math::exp(-population->M[i_agem1_yearm1]);
+                if (age == n_ages - 1)
+                {
+                    expected[i_age_year] +=
+                        expected[i_agem1_yearm1 + 1] *
+                        fims_math::exp(-population->M[i_agem1_yearm1 + 1]);
+                }
+            }
+        }
+        return expected;
+    }
+
+    // CatchAtAge_CalculateUnfishedTrajectory
+    // IO correctness
+    // Test that the unfished numbers at age, biomass, and spawning biomass
+    // match the recursion with natural mortality, and that maturity at age
+    // is calculated for every year
+    TEST_F(CAAEvaluateTestFixture, HandlesCorrectInput_CatchAtAge_CalculateUnfishedTrajectory)
+    {
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        auto &dq = catch_at_age_model->GetPopulationDerivedQuantities(
+            population->GetId());
+        std::vector<double> expected = ExpectedUnfishedNumbersAA(population);
+
+        for (size_t year = 0; year <= population->n_years; year++)
+        {
+            double biomass = 0.0;
+            double spawning_biomass = 0.0;
+            for (size_t age = 0; age < population->n_ages; age++)
+            {
+                size_t i_age_year = year * population->n_ages + age;
+                double weight =
+                    population->growth->evaluate(year, population->ages[age]);
+                double maturity =
+                    population->maturity->evaluate(population->ages[age]);
+                EXPECT_EQ(dq["proportion_mature_at_age"][i_age_year], maturity);
+                EXPECT_NEAR(dq["unfished_numbers_at_age"][i_age_year],
+                            expected[i_age_year], 1e-7 * expected[i_age_year]);
+                biomass += expected[i_age_year] * weight;
+                spawning_biomass += population->proportion_female[age] *
+                                    expected[i_age_year] * maturity * weight;
+            }
+            EXPECT_NEAR(dq["unfished_biomass"][year], biomass, 1e-7 * biomass);
+            EXPECT_NEAR(dq["unfished_spawning_biomass"][year], spawning_biomass,
+                        1e-7 * spawning_biomass);
+        }
+    }
+
+    // Edge handling
+    // Test that the trajectory is restored after the derived quantities are
+    // reset and that it follows changes of unexploited recruitment, natural
+    // mortality, proportion female, and maturity
+    TEST_F(CAAEvaluateTestFixture, HandlesEdgeCases_CatchAtAge_CalculateUnfishedTrajectory)
+    {
+        auto &dq = catch_at_age_model->GetPopulationDerivedQuantities(
+            population->GetId());
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        std::vector<double> first(dq["unfished_numbers_at_age"].begin(),
+                                  dq["unfished_numbers_at_age"].end());
+        double first_biomass = dq["unfished_biomass"][0];
+
+        // the same trajectory after Prepare() resets the derived quantities
+        catch_at_age_model->Prepare();
+        EXPECT_EQ(dq["unfished_biomass"][0], 0.0);
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        for (size_t i = 0; i < first.size(); i++)
+        {
+            EXPECT_EQ(dq["unfished_numbers_at_age"][i], first[i]);
+        }
+        EXPECT_EQ(dq["unfished_biomass"][0], first_biomass);
+
+        // doubling unexploited recruitment doubles the trajectory
+        population->recruitment->log_rzero[0] += fims_math::log(2.0);
+        catch_at_age_model->Prepare();
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        for (size_t i = 0; i < first.size(); i++)
+        {
+            EXPECT_NEAR(dq["unfished_numbers_at_age"][i], 2.0 * first[i],
+                        1e-7 * first[i]);
+        }
+        EXPECT_NEAR(dq["unfished_biomass"][0], 2.0 * first_biomass,
+                    1e-7 * first_biomass);
+
+        // and a change of natural mortality
+        for (size_t i = 0; i < population->log_M.size(); i++)
+        {
+            population->log_M[i] += 0.1;
+        }
+        catch_at_age_model->Prepare();
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        std::vector<double> expected = ExpectedUnfishedNumbersAA(population);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_NEAR(dq["unfished_numbers_at_age"][i], expected[i],
+                        1e-7 * expected[i]);
+        }
+
+        // and a change of proportion female, which only changes the
+        // spawning biomass
+        std::vector<double> spawning_biomass(
+            dq["unfished_spawning_biomass"].begin(),
+            dq["unfished_spawning_biomass"].end());
+        for (size_t i = 0; i < population->proportion_female.size(); i++)
+        {
+            population->proportion_female[i] *= 0.5;
+        }
+        catch_at_age_model->Prepare();
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        for (size_t i = 0; i < spawning_biomass.size(); i++)
+        {
+            EXPECT_NEAR(dq["unfished_spawning_biomass"][i],
+                        0.5 * spawning_biomass[i], 1e-7 * spawning_biomass[i]);
+        }
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_NEAR(dq["unfished_numbers_at_age"][i], expected[i],
+                        1e-7 * expected[i]);
+        }
+
+        // maturity that varies by year is evaluated for each year, and the
+        // year after the last year uses the values of the last year
+        auto maturity =
+            std::dynamic_pointer_cast<fims_popdy::LogisticMaturity<double>>(
+                population->maturity);
+        maturity->inflection_point.resize(population->n_years);
+        for (size_t year = 0; year < population->n_years; year++)
+        {
+            maturity->inflection_point[year] = 4.0 + 0.1 * year;
+        }
+        maturity->time_dependence = fims_model_object::PerYear;
+        catch_at_age_model->Prepare();
+        catch_at_age_model->CalculateUnfishedTrajectory(population);
+        for (size_t year = 0; year <= population->n_years; year++)
+        {
+            size_t maturity_year = std::min(year, population->n_years - 1);
+            for (size_t age = 0; age < population->n_ages; age++)
+            {
+                EXPECT_EQ(dq["proportion_mature_at_age"]
+                            [year * population->n_ages + age],
+                          maturity->evaluate(population->ages[age],
+                                             maturity_year));
+            }
+        }
+        // the spawning biomass follows the new maturity
+        for (size_t year = 0; year <= population->n_years; year++)
+        {
+            double sb = 0.0;
+            for (size_t age = 0; age < population->n_ages; age++)
+            {
+                size_t i_age_year = year * population->n_ages + age;
+                sb += population->proportion_female_view[age] *
+                      dq["unfished_numbers_at_age"][i_age_year] *
+                      dq["proportion_mature_at_age"][i_age_year] *
+                      population->weight_at_age[i_age_year];
+            }
+            EXPECT_NEAR(dq["unfished_spawning_biomass"][year], sb, 1e-7 * sb);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/models/functors/catch_at_age.hpp"
+
+namespace
+{
+  // CatchAtAge_SetAdreport
+  // IO correctness
+  // Test that the default ADREPORT is the lean set and that a selection
+  // replaces it
+  TEST(CatchAtAge_SetAdreport, HandlesCorrectInput)
+  {
+    fims_popdy::CatchAtAge<double> caa;
+    EXPECT_TRUE(caa.IsAdreported("spawning_biomass"));
+    EXPECT_TRUE(caa.IsAdreported("biomass"));
+    EXPECT_TRUE(caa.IsAdreported("expected_recruitment"));
+    EXPECT_TRUE(caa.IsAdreported("mortality_F"));
+    EXPECT_TRUE(caa.IsAdreported("F_msy"));
+    EXPECT_FALSE(caa.IsAdreported("numbers_at_age"));
+    EXPECT_FALSE(caa.IsAdreported("landings_numbers_at_length"));
+    EXPECT_TRUE(caa.IsAdreportedPopulation(3));
+    EXPECT_TRUE(caa.IsAdreportedFleet(5));
+
+    caa.SetAdreport({"numbers_at_age", "landings_expected"}, {3}, {5, 6});
+    EXPECT_EQ(caa.adreport_names.size(), 2);
+    EXPECT_TRUE(caa.IsAdreported("numbers_at_age"));
+    EXPECT_TRUE(caa.IsAdreported("landings_expected"));
+    EXPECT_FALSE(caa.IsAdreported("spawning_biomass"));
+    EXPECT_TRUE(caa.IsAdreportedPopulation(3));
+    EXPECT_FALSE(caa.IsAdreportedPopulation(4));
+    EXPECT_TRUE(caa.IsAdreportedFleet(6));
+    EXPECT_FALSE(caa.IsAdreportedFleet(7));
+
+    // the selection is kept by the copy constructor
+    fims_popdy::CatchAtAge<double> copy(caa);
+    EXPECT_EQ(copy.adreport_names, caa.adreport_names);
+    EXPECT_EQ(copy.adreport_fleet_ids, caa.adreport_fleet_ids);
+  }
+
+  // Edge handling
+  // Test that "all" selects every derived quantity in the report and that an
+  // empty selection ADREPORTs nothing
+  TEST(CatchAtAge_SetAdreport, HandlesEdgeCases)
+  {
+    fims_popdy::CatchAtAge<double> caa;
+    caa.SetAdreport({"all"}, {}, {});
+    EXPECT_EQ(caa.adreport_names.size(),
+              fims_popdy::CatchAtAge<double>::PopulationReportNames().size() +
+                  fims_popdy::CatchAtAge<
+                      double>::ReferencePointReportNames().size() +
+                  fims_popdy::CatchAtAge<double>::FleetReportNames().size());
+    for (const std::string &name :
+         fims_popdy::CatchAtAge<double>::FleetReportNames())
+    {
+      EXPECT_TRUE(caa.IsAdreported(name));
+    }
+
+    caa.SetAdreport({}, {}, {});
+    EXPECT_TRUE(caa.adreport_names.empty());
+    EXPECT_FALSE(caa.IsAdreported("spawning_biomass"));
+  }
+
+  // Error handling
+  // Test that an unknown name throws an error and keeps the selection
+  TEST(CatchAtAge_SetAdreport, HandlesErrors)
+  {
+    fims_popdy::CatchAtAge<double> caa;
+    EXPECT_THROW(caa.SetAdreport({"biomass", "ssb"}, {}, {}),
+                 std::invalid_argument);
+    EXPECT_EQ(caa.adreport_names,
+              fims_popdy::CatchAtAge<double>::DefaultAdreportNames());
+  }
+
+} // namespace
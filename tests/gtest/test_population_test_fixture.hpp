@@ -324,9 +324,6 @@ class CAAEvaluateTestFixture : public testing::Test {
           static_cast<double>(0.0);
     }
 
-    // Set initialized values for derived quantities
-    catch_at_age_model->Prepare();
-
     // log_naa
     double log_init_naa_min = 10.0;
     double log_init_naa_max = 12.0;
@@ -348,6 +345,10 @@ class CAAEvaluateTestFixture : public testing::Test {
       catch_at_age_model->populations[0]->proportion_female[i] = prop_female;
     }
 
+    // Set initialized values for derived quantities after the parameters,
+    // so the strided views of the parameters are resolved from their values
+    catch_at_age_model->Prepare();
+
     // numbers_at_age
     double numbers_at_age_min = fims_math::exp(10.0);
     double numbers_at_age_max = fims_math::exp(12.0);
@@ -0,0 +1,166 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/models/functors/projection.hpp"
+#include "population_dynamics/recruitment/recruitment.hpp"
+
+namespace
+{
+  // Set up a projection of n_ages ages with constant M and weight and a
+  // Beverton--Holt stock--recruitment relationship
+  fims_popdy::Projection<double> MakeProjection(size_t n_ages)
+  {
+    fims_popdy::Projection<double> projection;
+    fims_popdy::ProjectionInputs &in = projection.inputs;
+    in.n_ages = n_ages;
+    in.M.assign(n_ages, 0.2);
+    in.selectivity.resize(n_ages);
+    in.weight.resize(n_ages);
+    in.spawning_weight.resize(n_ages);
+    projection.initial_numbers_at_age.resize(n_ages);
+    for (size_t a = 0; a < n_ages; a++)
+    {
+      in.selectivity[a] = 1.0 / (1.0 + std::exp(-(a - 3.0)));
+      in.weight[a] = 0.1 * (a + 1);
+      in.spawning_weight[a] = 0.5 * in.weight[a] * (a >= 3 ? 1.0 : 0.0);
+      projection.initial_numbers_at_age[a] = 1000.0 * std::exp(-0.3 * a);
+    }
+    double max_selectivity = in.selectivity[n_ages - 1];
+    for (size_t a = 0; a < n_ages; a++)
+    {
+      in.selectivity[a] /= max_selectivity;
+    }
+    in.phi_0 = 1.0;
+    in.unfished_spawning_biomass = 1000.0;
+
+    std::shared_ptr<fims_popdy::SRBevertonHolt<double>> recruitment =
+      std::make_shared<fims_popdy::SRBevertonHolt<double>>();
+    recruitment->logit_steep.resize(1);
+    recruitment->logit_steep[0] = fims_math::logit(0.2, 1.0, 0.75);
+    recruitment->log_rzero.resize(1);
+    recruitment->log_rzero[0] = std::log(1000.0);
+    projection.recruitment = recruitment;
+    return projection;
+  }
+
+  // Projection_Run
+  // IO correctness
+  // Test that a deterministic projection with constant F matches the
+  // Baranov catch equation, that constant landings are taken, and that the
+  // results do not depend on the number of threads
+  TEST(Projection_Run, HandlesCorrectInput)
+  {
+    fims_popdy::Projection<double> projection = MakeProjection(8);
+    std::vector<double> probabilities = {0.05, 0.5, 0.95};
+    fims_popdy::ConstantFishingMortality constant_F(0.3);
+    fims_popdy::ProjectionSummary deterministic =
+      projection.Run(5, 10, constant_F, 0.0, 1, probabilities, 2);
+
+    const std::vector<double> &N = projection.initial_numbers_at_age;
+    double ssb = 0.0;
+    for (size_t a = 0; a < N.size(); a++)
+    {
+      ssb += N[a] * projection.inputs.spawning_weight[a];
+    }
+    EXPECT_NEAR(deterministic.mean["spawning_biomass"][0], ssb, 1e-8);
+    EXPECT_NEAR(deterministic.mean["spawning_biomass_ratio"][0],
+                ssb / 1000.0, 1e-10);
+    EXPECT_NEAR(deterministic.mean["landings_weight"][0],
+                projection.inputs.Landings(N.data(), 1, 0.3), 1e-8);
+    EXPECT_EQ(deterministic.mean["recruitment"][0], N[0]);
+    EXPECT_NEAR(deterministic.mean["recruitment"][1],
+                projection.recruitment->evaluate_mean(ssb, 1.0), 1e-8);
+    for (size_t y = 0; y < 5; y++)
+    {
+      EXPECT_DOUBLE_EQ(deterministic.mean["fishing_mortality"][y], 0.3);
+      for (size_t q = 0; q < probabilities.size(); q++)
+      {
+        EXPECT_NEAR(deterministic.quantiles["spawning_biomass"][y * 3 + q],
+                    deterministic.mean["spawning_biomass"][y], 1e-8);
+      }
+    }
+
+    fims_popdy::ConstantLandings constant_landings(50.0);
+    fims_popdy::ProjectionSummary landings =
+      projection.Run(5, 10, constant_landings, 0.5, 1, probabilities, 2);
+    for (size_t y = 0; y < 5; y++)
+    {
+      EXPECT_NEAR(landings.quantiles["landings_weight"][y * 3], 50.0, 1e-6);
+      EXPECT_NEAR(landings.quantiles["landings_weight"][y * 3 + 2], 50.0,
+                  1e-6);
+    }
+
+    fims_popdy::ProjectionSummary one_thread =
+      projection.Run(10, 101, constant_F, 0.6, 7, probabilities, 1);
+    fims_popdy::ProjectionSummary four_threads =
+      projection.Run(10, 101, constant_F, 0.6, 7, probabilities, 4);
+    EXPECT_EQ(one_thread.mean, four_threads.mean);
+    EXPECT_EQ(one_thread.quantiles, four_threads.quantiles);
+    for (size_t y = 1; y < 10; y++)
+    {
+      EXPECT_LT(one_thread.quantiles["recruitment"][y * 3],
+                one_thread.quantiles["recruitment"][y * 3 + 1]);
+      EXPECT_LT(one_thread.quantiles["recruitment"][y * 3 + 1],
+                one_thread.quantiles["recruitment"][y * 3 + 2]);
+    }
+  }
+
+  // Edge handling
+  // Test that the ramp closes the fishery below the lower ratio, that
+  // landings that cannot be taken cap F, and that zero years are allowed
+  TEST(Projection_Run, HandlesEdgeCases)
+  {
+    fims_popdy::Projection<double> projection = MakeProjection(6);
+    std::vector<double> probabilities = {0.5};
+
+    fims_popdy::SpawningBiomassRatioRamp closed(0.4, 0.9, 1.0);
+    fims_popdy::ProjectionSummary summary =
+      projection.Run(3, 5, closed, 0.0, 1, probabilities, 1);
+    EXPECT_LT(summary.mean["spawning_biomass_ratio"][0], 0.9);
+    EXPECT_EQ(summary.mean["fishing_mortality"][0], 0.0);
+    EXPECT_EQ(summary.mean["landings_weight"][0], 0.0);
+
+    fims_popdy::SpawningBiomassRatioRamp ramp(0.4, 0.0, 1.0);
+    summary = projection.Run(1, 5, ramp, 0.0, 1, probabilities, 1);
+    EXPECT_NEAR(summary.mean["fishing_mortality"][0],
+                0.4 * summary.mean["spawning_biomass_ratio"][0], 1e-12);
+
+    fims_popdy::ConstantLandings too_much(1e9, 2.0);
+    summary = projection.Run(1, 5, too_much, 0.0, 1, probabilities, 1);
+    EXPECT_EQ(summary.mean["fishing_mortality"][0], 2.0);
+
+    summary = projection.Run(0, 5, ramp, 0.0, 1, probabilities, 0);
+    EXPECT_EQ(summary.n_years, 0);
+    EXPECT_TRUE(summary.mean["spawning_biomass"].empty());
+  }
+
+  // Error handling
+  // Test that invalid inputs throw
+  TEST(Projection_Run, HandlesErrorCases)
+  {
+    std::vector<double> probabilities = {0.5};
+    fims_popdy::ConstantFishingMortality constant_F(0.3);
+    fims_popdy::Projection<double> empty;
+    EXPECT_THROW(empty.Run(1, 1, constant_F, 0.0, 1, probabilities, 1),
+                 std::invalid_argument);
+
+    fims_popdy::Projection<double> projection = MakeProjection(6);
+    EXPECT_THROW(projection.Run(1, 0, constant_F, 0.0, 1, probabilities, 1),
+                 std::invalid_argument);
+    std::vector<double> invalid = {1.5};
+    EXPECT_THROW(projection.Run(1, 1, constant_F, 0.0, 1, invalid, 1),
+                 std::invalid_argument);
+    EXPECT_THROW(fims_popdy::SpawningBiomassRatioRamp(0.3, 0.4, 0.1),
+                 std::invalid_argument);
+
+    fims_popdy::CatchAtAge<double> model;
+    EXPECT_THROW(projection.Setup(model), std::invalid_argument);
+  }
+}
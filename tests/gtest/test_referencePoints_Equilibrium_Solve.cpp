@@ -0,0 +1,253 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/models/functors/reference_points.hpp"
+#include "population_dynamics/recruitment/recruitment.hpp"
+#include "test_stubs.hpp"
+#include "test_synthetic_model_generator.hpp"
+
+namespace
+{
+  // Set up an equilibrium of n_ages ages with constant M and a
+  // Beverton--Holt stock--recruitment relationship with steepness 0.75 and
+  // unfished recruitment 1000
+  fims_popdy::Equilibrium<double> MakeEquilibrium(
+    size_t n_ages, fims_popdy::SRBevertonHolt<double> &recruitment)
+  {
+    fims_popdy::Equilibrium<double> equilibrium;
+    equilibrium.M.assign(n_ages, 0.2);
+    equilibrium.selectivity.resize(n_ages);
+    equilibrium.weight.resize(n_ages);
+    equilibrium.spawning_weight.resize(n_ages);
+    for (size_t a = 0; a < n_ages; a++)
+    {
+      equilibrium.selectivity[a] = 1.0 / (1.0 + std::exp(-(a - 3.0)));
+      equilibrium.weight[a] = 0.1 * (a + 1);
+      equilibrium.spawning_weight[a] =
+        0.5 * equilibrium.weight[a] / (1.0 + std::exp(-(a - 2.5)));
+    }
+    double max_selectivity = equilibrium.selectivity[n_ages - 1];
+    for (size_t a = 0; a < n_ages; a++)
+    {
+      equilibrium.selectivity[a] /= max_selectivity;
+    }
+
+    recruitment.logit_steep.resize(1);
+    recruitment.logit_steep[0] = fims_math::logit(0.2, 1.0, 0.75);
+    recruitment.log_rzero.resize(1);
+    recruitment.log_rzero[0] = std::log(1000.0);
+
+    // same linearization of S / g(S) as Equilibrium::Setup()
+    double ypr;
+    equilibrium.PerRecruit(0.0, equilibrium.phi_0, ypr);
+    double s_1 = 1000.0 * equilibrium.phi_0;
+    double s_2 = 0.5 * s_1;
+    double k_1 = s_1 / recruitment.evaluate_mean(s_1, equilibrium.phi_0);
+    double k_2 = s_2 / recruitment.evaluate_mean(s_2, equilibrium.phi_0);
+    equilibrium.beta = (k_1 - k_2) / (s_1 - s_2);
+    equilibrium.alpha = k_1 - equilibrium.beta * s_1;
+    return equilibrium;
+  }
+
+  // Equilibrium_Solve
+  // IO correctness
+  // Test that the grid matches the per-recruit calculations, that equilibrium
+  // recruitment satisfies the stock--recruitment relationship, and that the
+  // reference points solve their defining equations
+  TEST(Equilibrium_Solve, HandlesCorrectInput)
+  {
+    fims_popdy::SRBevertonHolt<double> recruitment;
+    fims_popdy::Equilibrium<double> equilibrium =
+      MakeEquilibrium(12, recruitment);
+
+    std::vector<double> F = {0.0, 0.1, 0.25, 0.5, 1.0, 2.0};
+    fims_popdy::EquilibriumGrid<double> grid = equilibrium.Evaluate(F);
+    ASSERT_EQ(grid.yield.size(), F.size());
+    // Unfished spawning biomass per recruit and recruitment
+    EXPECT_NEAR(grid.spawning_biomass_per_recruit[0], equilibrium.phi_0,
+                1e-12);
+    EXPECT_NEAR(grid.recruitment[0], 1000.0, 1e-8);
+    EXPECT_NEAR(grid.yield[0], 0.0, 1e-12);
+    for (size_t i = 0; i < F.size(); i++)
+    {
+      double spr, ypr;
+      equilibrium.PerRecruit(F[i], spr, ypr);
+      EXPECT_NEAR(grid.spawning_biomass_per_recruit[i], spr, 1e-12);
+      EXPECT_NEAR(grid.yield_per_recruit[i], ypr, 1e-12);
+      EXPECT_NEAR(grid.yield[i], equilibrium.Yield(F[i]), 1e-9);
+      // R = g(S) at equilibrium
+      EXPECT_NEAR(grid.recruitment[i],
+                  recruitment.evaluate_mean(grid.spawning_biomass[i],
+                                            equilibrium.phi_0),
+                  1e-8);
+    }
+
+    // The derivatives of the dual match finite differences
+    double h = 1e-4;
+    fims_popdy::SecondOrderDual<double> yield = equilibrium.Yield(
+      fims_popdy::SecondOrderDual<double>::Variable(0.3));
+    double y_minus = equilibrium.Yield(0.3 - h);
+    double y_plus = equilibrium.Yield(0.3 + h);
+    EXPECT_NEAR(yield.d1, (y_plus - y_minus) / (2.0 * h),
+                1e-5 * std::fabs(yield.d1));
+    EXPECT_NEAR(yield.d2, (y_plus - 2.0 * yield.value + y_minus) / (h * h),
+                1e-3 * std::fabs(yield.d2));
+
+    fims_popdy::ReferencePoints<double> rp = equilibrium.Solve(0.4);
+    // F_msy is a stationary point and is the maximum of a fine grid
+    fims_popdy::SecondOrderDual<double> at_msy = equilibrium.Yield(
+      fims_popdy::SecondOrderDual<double>::Variable(rp.F_msy));
+    EXPECT_NEAR(at_msy.d1, 0.0, 1e-8);
+    EXPECT_LT(at_msy.d2, 0.0);
+    EXPECT_NEAR(rp.msy, at_msy.value, 1e-10);
+    std::vector<double> fine(3000);
+    for (size_t i = 0; i < fine.size(); i++)
+    {
+      fine[i] = 0.001 * (i + 1);
+    }
+    fims_popdy::EquilibriumGrid<double> fine_grid = equilibrium.Evaluate(fine);
+    double max_yield = 0.0;
+    for (size_t i = 0; i < fine.size(); i++)
+    {
+      max_yield = std::max(max_yield, fine_grid.yield[i]);
+      EXPECT_LE(fine_grid.yield[i], rp.msy + 1e-10);
+    }
+    EXPECT_NEAR(max_yield, rp.msy, 1e-4 * rp.msy);
+    double spr_msy, ypr_msy;
+    equilibrium.PerRecruit(rp.F_msy, spr_msy, ypr_msy);
+    EXPECT_NEAR(rp.spawning_biomass_msy,
+                spr_msy * equilibrium.Recruitment(spr_msy), 1e-8);
+
+    // F_40% gives 40% of unfished spawning biomass per recruit
+    double spr, ypr;
+    equilibrium.PerRecruit(rp.F_spr, spr, ypr);
+    EXPECT_NEAR(spr / equilibrium.phi_0, 0.4, 1e-10);
+    EXPECT_DOUBLE_EQ(rp.spr_target, 0.4);
+  }
+
+  // IO correctness
+  // Test that Setup() takes the unfished spawning biomass per recruit from
+  // the per-recruit model of the same year, so unfished equilibrium
+  // recruitment is that of the stock--recruitment relationship, and that the
+  // fully selected age has a relative selectivity of one
+  TEST(Equilibrium_Solve, HandlesCorrectInput_Setup)
+  {
+    SyntheticModelDimensions dims;
+    SyntheticModel<double> model =
+      SyntheticModelGenerator(dims, 11).Generate<double>();
+    model.Evaluate();
+    std::shared_ptr<fims_popdy::Population<double>> &population =
+      model.catch_at_age->populations[0];
+
+    fims_popdy::Equilibrium<double> equilibrium;
+    equilibrium.Setup(population,
+                      model.catch_at_age->GetPopulationDerivedQuantities(
+                        population->GetId()),
+                      dims.n_years - 1);
+    EXPECT_NEAR(*std::max_element(equilibrium.selectivity.begin(),
+                                  equilibrium.selectivity.end()),
+                1.0, 1e-5);
+    for (size_t a = 0; a < dims.n_ages; a++)
+    {
+      EXPECT_EQ(equilibrium.weight[a],
+                population->weight_at_age[(dims.n_years - 1) * dims.n_ages +
+                                          a]);
+    }
+
+    // M, weight, and maturity do not vary by year, so phi_0 is also that of
+    // the population dynamics
+    double phi_0 = model.catch_at_age->CalculateSBPR0(population);
+    EXPECT_NEAR(equilibrium.phi_0, phi_0, 1e-10 * phi_0);
+    fims_popdy::EquilibriumGrid<double> grid =
+      equilibrium.Evaluate(std::vector<double>(1, 0.0));
+    EXPECT_EQ(grid.spawning_biomass_per_recruit[0], equilibrium.phi_0);
+    double r_zero = std::exp(population->recruitment->log_rzero[0]);
+    EXPECT_NEAR(grid.recruitment[0], r_zero, 1e-8 * r_zero);
+
+    fims_popdy::ReferencePoints<double> rp = equilibrium.Solve(0.4);
+    EXPECT_GT(rp.F_msy, 0.0);
+    double spr, ypr;
+    equilibrium.PerRecruit(rp.F_spr, spr, ypr);
+    EXPECT_NEAR(spr / equilibrium.phi_0, 0.4, 1e-10);
+  }
+
+  // IO correctness
+  // Test that with natural mortality that varies by year, phi_0 is that of
+  // the biology of the equilibrium year rather than of the first year, so
+  // unfished equilibrium recruitment is still unfished recruitment
+  TEST(Equilibrium_Solve, HandlesCorrectInput_SetupTimeVarying)
+  {
+    SyntheticModelDimensions dims;
+    dims.time_varying_mortality = true;
+    SyntheticModel<double> model =
+      SyntheticModelGenerator(dims, 11).Generate<double>();
+    model.Evaluate();
+    std::shared_ptr<fims_popdy::Population<double>> &population =
+      model.catch_at_age->populations[0];
+
+    fims_popdy::Equilibrium<double> equilibrium;
+    equilibrium.Setup(population,
+                      model.catch_at_age->GetPopulationDerivedQuantities(
+                        population->GetId()),
+                      dims.n_years - 1);
+    double phi_0 = model.catch_at_age->CalculateSBPR0(population);
+    EXPECT_GT(std::fabs(equilibrium.phi_0 - phi_0), 1e-6 * phi_0);
+    double spr, ypr;
+    equilibrium.PerRecruit(0.0, spr, ypr);
+    EXPECT_EQ(spr, equilibrium.phi_0);
+    EXPECT_EQ(ypr, 0.0);
+    double r_zero = std::exp(population->recruitment->log_rzero[0]);
+    EXPECT_NEAR(equilibrium.Recruitment(spr), r_zero, 1e-8 * r_zero);
+  }
+
+  // Edge handling
+  // Test that a lower spr_target gives a higher F_spr and that F_spr is
+  // positive for targets close to one
+  TEST(Equilibrium_Solve, HandlesEdgeCases)
+  {
+    fims_popdy::SRBevertonHolt<double> recruitment;
+    fims_popdy::Equilibrium<double> equilibrium =
+      MakeEquilibrium(12, recruitment);
+
+    fims_popdy::ReferencePoints<double> rp_30 = equilibrium.Solve(0.3);
+    fims_popdy::ReferencePoints<double> rp_40 = equilibrium.Solve(0.4);
+    EXPECT_GT(rp_30.F_spr, rp_40.F_spr);
+
+    fims_popdy::ReferencePoints<double> rp_99 = equilibrium.Solve(0.99);
+    EXPECT_GT(rp_99.F_spr, 0.0);
+    double spr, ypr;
+    equilibrium.PerRecruit(rp_99.F_spr, spr, ypr);
+    EXPECT_NEAR(spr / equilibrium.phi_0, 0.99, 1e-10);
+
+    // An empty grid
+    fims_popdy::EquilibriumGrid<double> grid =
+      equilibrium.Evaluate(std::vector<double>());
+    EXPECT_EQ(grid.yield.size(), 0);
+  }
+
+  // Error handling
+  // Test that invalid targets and populations throw
+  TEST(Equilibrium_Solve, HandlesErrorCases)
+  {
+    fims_popdy::SRBevertonHolt<double> recruitment;
+    fims_popdy::Equilibrium<double> equilibrium =
+      MakeEquilibrium(12, recruitment);
+    EXPECT_THROW(equilibrium.Solve(0.0), std::invalid_argument);
+    EXPECT_THROW(equilibrium.Solve(1.0), std::invalid_argument);
+
+    std::shared_ptr<fims_popdy::Population<double>> population =
+      std::make_shared<fims_popdy::Population<double>>();
+    population->n_ages = 1;
+    population->n_years = 10;
+    std::map<std::string, fims::Vector<double>> derived_quantities;
+    EXPECT_THROW(equilibrium.Setup(population, derived_quantities, 0),
+                 std::invalid_argument);
+  }
+}
@@ -0,0 +1,161 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "test_stubs.hpp"
+#include "test_synthetic_model_generator.hpp"
+
+namespace
+{
+  // Generate
+  // IO correctness
+  // Test that the generated model has the requested modules and data and
+  // that an evaluation gives finite, positive population quantities
+  TEST(SyntheticModelGenerator, HandlesCorrectInput)
+  {
+    SyntheticModelDimensions dims;
+    dims.n_populations = 2;
+    dims.n_fleets = 3;
+    dims.n_ages = 8;
+    dims.n_years = 20;
+    dims.n_lengths = 10;
+    dims.n_data = 4;
+    SyntheticModel<double> model =
+        SyntheticModelGenerator(dims, 42).Generate<double>();
+
+    EXPECT_EQ(model.info->populations.size(), 2);
+    EXPECT_EQ(model.info->fleets.size(), 6);
+    EXPECT_EQ(model.info->density_components.size(), 24);
+    EXPECT_EQ(model.data.size(), 24);
+    // log_rzero and log_init_naa per population and log_q, log_Fmort, and
+    // the two selectivity parameters per fleet
+    EXPECT_EQ(model.info->fixed_effects_parameters.size(),
+              2 * (1 + 8) + 6 * (1 + 20 + 2));
+    EXPECT_EQ(model.info->random_effects_parameters.size(), 2 * 20);
+
+    model.Evaluate();
+    for (uint32_t id : model.catch_at_age->GetPopulationIds())
+    {
+      fims::Vector<double> &ssb =
+          model.catch_at_age->GetPopulationDerivedQuantities(
+              id)["spawning_biomass"];
+      for (size_t y = 0; y < ssb.size(); y++)
+      {
+        EXPECT_TRUE(std::isfinite(ssb[y]));
+        EXPECT_GT(ssb[y], 0.0);
+      }
+    }
+
+    for (size_t i = 0; i < model.data.size(); i++)
+    {
+      if (model.data_kind[i] < 2)
+      {
+        for (size_t y = 0; y < model.data[i]->size(); y++)
+        {
+          EXPECT_GT(model.data[i]->at(y), 0.0);
+        }
+      }
+      else
+      {
+        size_t n_bins = model.data[i]->get_jmax();
+        for (size_t y = 0; y < dims.n_years; y++)
+        {
+          double sum = 0.0;
+          for (size_t b = 0; b < n_bins; b++)
+          {
+            sum += model.data[i]->at(y * n_bins + b);
+          }
+          EXPECT_DOUBLE_EQ(sum, static_cast<double>(dims.comp_sample_size));
+        }
+      }
+    }
+  }
+
+  // Test that the same seed gives the same model and another seed does not
+  TEST(SyntheticModelGenerator, IsReproducible)
+  {
+    SyntheticModelDimensions dims;
+    SyntheticModel<double> a =
+        SyntheticModelGenerator(dims, 7).Generate<double>();
+    SyntheticModel<double> b =
+        SyntheticModelGenerator(dims, 7).Generate<double>();
+    SyntheticModel<double> c =
+        SyntheticModelGenerator(dims, 8).Generate<double>();
+
+    ASSERT_EQ(a.data.size(), b.data.size());
+    bool differs = false;
+    for (size_t i = 0; i < a.data.size(); i++)
+    {
+      for (size_t j = 0; j < a.data[i]->size(); j++)
+      {
+        EXPECT_EQ(a.data[i]->at(j), b.data[i]->at(j));
+        differs = differs || a.data[i]->at(j) != c.data[i]->at(j);
+      }
+    }
+    EXPECT_TRUE(differs);
+    for (size_t i = 0; i < a.info->fixed_effects_parameters.size(); i++)
+    {
+      EXPECT_EQ(*a.info->fixed_effects_parameters[i],
+                *b.info->fixed_effects_parameters[i]);
+    }
+  }
+
+  // Edge handling
+  // Test that fully sparse compositions are missing in every year and that
+  // the time-varying flags give parameters that vary by year
+  TEST(SyntheticModelGenerator, HandlesEdgeCases)
+  {
+    SyntheticModelDimensions dims;
+    dims.n_fleets = 1;
+    dims.comp_sparsity = 1.0;
+    dims.time_varying_selectivity = true;
+    dims.time_varying_mortality = true;
+    SyntheticModel<double> model =
+        SyntheticModelGenerator(dims).Generate<double>();
+
+    for (size_t i = 0; i < model.data.size(); i++)
+    {
+      if (model.data_kind[i] == 2)
+      {
+        for (size_t j = 0; j < model.data[i]->size(); j++)
+        {
+          EXPECT_EQ(model.data[i]->at(j), -999.0);
+        }
+      }
+    }
+
+    std::shared_ptr<fims_popdy::SelectivityBase<double>> selectivity =
+        model.info->selectivity_models.begin()->second;
+    std::shared_ptr<fims_popdy::LogisticSelectivity<double>> logistic =
+        std::dynamic_pointer_cast<fims_popdy::LogisticSelectivity<double>>(
+            selectivity);
+    ASSERT_NE(logistic, nullptr);
+    EXPECT_EQ(logistic->inflection_point.size(), dims.n_years);
+    EXPECT_NE(logistic->evaluate(3.0, 0), logistic->evaluate(3.0, 1));
+
+    std::shared_ptr<fims_popdy::Population<double>> population =
+        model.info->populations.begin()->second;
+    EXPECT_NE(population->log_M[0], population->log_M[1]);
+  }
+
+  // Error handling
+  // Test that too small dimensions throw an error
+  TEST(SyntheticModelGenerator, HandlesErrors)
+  {
+    SyntheticModelDimensions dims;
+    dims.n_ages = 1;
+    EXPECT_THROW(SyntheticModelGenerator(dims).Generate<double>(),
+                 std::invalid_argument);
+    dims.n_ages = 12;
+    dims.n_fleets = 0;
+    EXPECT_THROW(SyntheticModelGenerator(dims).Build<double>(),
+                 std::invalid_argument);
+  }
+
+} // namespace
@@ -0,0 +1,491 @@
+#ifndef TEST_SYNTHETIC_MODEL_GENERATOR_HPP
+#define TEST_SYNTHETIC_MODEL_GENERATOR_HPP
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../inst/include/common/model.hpp"
+#include "../../inst/include/models/fisheries_models.hpp"
+
+namespace {
+
+// Dimensions and options of a synthetic catch-at-age model. Each population
+// has its own n_fleets fleets. Each fleet has up to n_data data components,
+// taken in the order landings, index, age composition, and length
+// composition, where the last is only used if n_lengths > 0.
+struct SyntheticModelDimensions {
+  size_t n_populations = 1;
+  size_t n_fleets = 2;
+  size_t n_ages = 12;
+  size_t n_years = 30;
+  size_t n_lengths = 0;
+  size_t n_data = 3;
+  // Probability that the composition data of a fleet are missing, i.e., -999,
+  // in a given year.
+  double comp_sparsity = 0.0;
+  // Number of fish sampled for the composition data in each year.
+  size_t comp_sample_size = 200;
+  // If true, the selectivity parameters vary by year.
+  bool time_varying_selectivity = false;
+  // If true, natural mortality varies by year.
+  bool time_varying_mortality = false;
+  // If true, the weight at age varies by year.
+  bool time_varying_growth = false;
+};
+
+// A synthetic catch-at-age model. The data objects are listed in the order
+// they were created together with the kind of data, i.e., 0 for landings,
+// 1 for index, 2 for age composition, and 3 for length composition, and the
+// id of their fleet.
+template <typename Type>
+struct SyntheticModel {
+  std::shared_ptr<fims_info::Information<Type>> info;
+  std::shared_ptr<fims_model::Model<Type>> model;
+  std::shared_ptr<fims_popdy::CatchAtAge<Type>> catch_at_age;
+  std::vector<std::shared_ptr<fims_data_object::DataObject<Type>>> data;
+  std::vector<size_t> data_kind;
+  std::vector<uint32_t> data_fleet_id;
+
+  // Evaluates the objective function.
+  Type Evaluate() { return this->model->Evaluate(); }
+};
+
+// Generates fully wired catch-at-age models of any size for benchmarks,
+// memory tests, and scaling tests. The modules are added to an Information
+// object by id the same way that CreateTMBModel() adds the modules made in R,
+// and Information::CreateModel() links them. The parameters are drawn from
+// plausible ranges with a seeded random number generator. The data are
+// simulated from a model with the same parameters, so the data and the
+// parameters are consistent and the same seed always gives the same model.
+class SyntheticModelGenerator {
+ public:
+  SyntheticModelDimensions dims;
+  uint64_t seed;
+
+  SyntheticModelGenerator(const SyntheticModelDimensions &dims,
+                          uint64_t seed = 1)
+      : dims(dims), seed(seed) {}
+
+  // Generates a model with simulated data.
+  template <typename Type>
+  SyntheticModel<Type> Generate() const {
+    std::vector<std::vector<double>> observations = SimulateObservations();
+    return this->Build<Type>(&observations);
+  }
+
+  // Generates a model whose data are placeholders, i.e., the expected values
+  // are not known yet. Simulated data are added by Generate().
+  template <typename Type>
+  SyntheticModel<Type> Build(
+      const std::vector<std::vector<double>> *observations = nullptr) const {
+    if (dims.n_populations == 0 || dims.n_fleets == 0 || dims.n_ages < 2 ||
+        dims.n_years < 2) {
+      throw std::invalid_argument(
+          "SyntheticModelGenerator: a model needs at least one population, "
+          "one fleet, two ages, and two years.");
+    }
+    Builder<Type> builder(this->dims, this->seed, observations);
+    return builder.model;
+  }
+
+ private:
+  template <typename Type>
+  class Builder {
+   public:
+    SyntheticModel<Type> model;
+
+    Builder(const SyntheticModelDimensions &dims, uint64_t seed,
+            const std::vector<std::vector<double>> *observations)
+        : dims(dims), rng(seed), observations(observations) {
+      model.info = std::make_shared<fims_info::Information<Type>>();
+      model.model = std::make_shared<fims_model::Model<Type>>();
+      model.model->fims_information = model.info;
+      model.catch_at_age = std::make_shared<fims_popdy::CatchAtAge<Type>>();
+      model.info->models_map[model.catch_at_age->GetId()] =
+          model.catch_at_age;
+      for (size_t p = 0; p < dims.n_populations; p++) {
+        AddPopulation();
+      }
+      if (!model.info->CreateModel()) {
+        throw std::runtime_error("SyntheticModelGenerator: invalid model.");
+      }
+    }
+
+   private:
+    const SyntheticModelDimensions &dims;
+    std::mt19937_64 rng;
+    const std::vector<std::vector<double>> *observations;
+    uint32_t next_key = 1;
+
+    double Normal(double mean, double sd) {
+      return std::normal_distribution<double>(mean, sd)(rng);
+    }
+
+    double Uniform(double min, double max) {
+      return std::uniform_real_distribution<double>(min, max)(rng);
+    }
+
+    void RegisterParameters(fims::Vector<Type> &x, const std::string &module,
+                            uint32_t id, const std::string &name,
+                            bool random_effect = false) {
+      for (size_t i = 0; i < x.size(); i++) {
+        std::stringstream ss;
+        ss << module << "." << id << "." << name << "." << i;
+        if (random_effect) {
+          model.info->RegisterRandomEffect(x[i]);
+          model.info->RegisterRandomEffectName(ss.str());
+        } else {
+          model.info->RegisterParameter(x[i]);
+          model.info->RegisterParameterName(ss.str());
+        }
+      }
+    }
+
+    uint32_t AddDerivedQuantity(
+        std::map<std::string, fims::Vector<Type>> &dqs,
+        std::map<std::string, fims_popdy::DimensionInfo> &dim_info,
+        const std::string &name, const fims::Vector<int> &dq_dims,
+        const fims::Vector<std::string> &dim_names) {
+      size_t n = 1;
+      for (size_t i = 0; i < dq_dims.size(); i++) {
+        n *= static_cast<size_t>(dq_dims[i]);
+      }
+      dqs[name] = fims::Vector<Type>(n);
+      dim_info[name] = fims_popdy::DimensionInfo(name, dq_dims, dim_names);
+      model.info->variable_map[next_key] = &dqs[name];
+      return next_key++;
+    }
+
+    // Adds a data object and the density component of its likelihood.
+    std::shared_ptr<fims_data_object::DataObject<Type>> AddData(
+        size_t kind, uint32_t fleet_id, size_t n_bins, uint32_t key) {
+      std::shared_ptr<fims_data_object::DataObject<Type>> data =
+          n_bins == 0
+              ? std::make_shared<fims_data_object::DataObject<Type>>(
+                    dims.n_years)
+              : std::make_shared<fims_data_object::DataObject<Type>>(
+                    dims.n_years, n_bins);
+      size_t slot = model.data.size();
+      for (size_t i = 0; i < data->size(); i++) {
+        double value = kind == 0 ? 1000.0 : kind == 1 ? 1.0 : 10.0;
+        if (observations != nullptr) {
+          value = (*observations)[slot][i];
+        }
+        data->set(i, value);
+      }
+      model.data.push_back(data);
+      model.data_kind.push_back(kind);
+      model.data_fleet_id.push_back(fleet_id);
+      model.info->data_objects[data->id] = data;
+
+      std::shared_ptr<fims_distributions::DensityComponentBase<Type>>
+          component;
+      if (kind < 2) {
+        std::shared_ptr<fims_distributions::LogNormalLPDF<Type>> lognormal =
+            std::make_shared<fims_distributions::LogNormalLPDF<Type>>();
+        lognormal->log_sd.resize(1);
+        lognormal->log_sd[0] = static_cast<Type>(std::log(0.1));
+        component = lognormal;
+      } else {
+        component =
+            std::make_shared<fims_distributions::MultinomialLPMF<Type>>();
+      }
+      component->input_type = "data";
+      component->observed_data_id_m = data->id;
+      component->key.push_back(key);
+      model.info->density_components[component->GetId()] = component;
+      return data;
+    }
+
+    void AddPopulation() {
+      int n_years = static_cast<int>(dims.n_years);
+      int n_ages = static_cast<int>(dims.n_ages);
+      int n_lengths = static_cast<int>(dims.n_lengths);
+      std::shared_ptr<fims_info::Information<Type>> &info = model.info;
+
+      std::shared_ptr<fims_popdy::Population<Type>> population =
+          std::make_shared<fims_popdy::Population<Type>>();
+      uint32_t pid = population->GetId();
+      population->n_years = dims.n_years;
+      population->n_ages = dims.n_ages;
+      population->n_fleets = dims.n_fleets;
+      population->ages.resize(dims.n_ages);
+      for (size_t a = 0; a < dims.n_ages; a++) {
+        population->ages[a] = static_cast<double>(a + 1);
+      }
+      double M = Uniform(0.1, 0.3);
+      population->log_M.resize(dims.n_years * dims.n_ages);
+      for (size_t y = 0; y < dims.n_years; y++) {
+        double log_M = std::log(M);
+        if (dims.time_varying_mortality) {
+          log_M += Normal(0.0, 0.1);
+        }
+        for (size_t a = 0; a < dims.n_ages; a++) {
+          population->log_M[a * dims.n_years + y] = static_cast<Type>(log_M);
+        }
+      }
+      population->log_f_multiplier.resize(dims.n_years);
+      info->populations[pid] = population;
+
+      std::shared_ptr<fims_popdy::SRBevertonHolt<Type>> recruitment =
+          std::make_shared<fims_popdy::SRBevertonHolt<Type>>();
+      double log_rzero = std::log(1.0e4) + Normal(0.0, 0.5);
+      double steepness = Uniform(0.6, 0.9);
+      recruitment->logit_steep.resize(1);
+      recruitment->logit_steep[0] =
+          static_cast<Type>(std::log((steepness - 0.2) / (1.0 - steepness)));
+      recruitment->log_rzero.resize(1);
+      recruitment->log_rzero[0] = static_cast<Type>(log_rzero);
+      recruitment->log_recruit_devs.resize(dims.n_years);
+      for (size_t y = 0; y < dims.n_years; y++) {
+        recruitment->log_recruit_devs[y] = static_cast<Type>(Normal(0.0, 0.3));
+      }
+      recruitment->log_expected_recruitment.resize(dims.n_years);
+      RegisterParameters(recruitment->log_rzero, "Recruitment",
+                         recruitment->GetId(), "log_rzero");
+      RegisterParameters(recruitment->log_recruit_devs, "Recruitment",
+                         recruitment->GetId(), "log_recruit_devs", true);
+      std::shared_ptr<fims_popdy::LogDevs<Type>> process =
+          std::make_shared<fims_popdy::LogDevs<Type>>();
+      recruitment->process_id = process->GetId();
+      info->recruitment_models[recruitment->GetId()] = recruitment;
+      info->recruitment_process_models[process->GetId()] = process;
+      population->recruitment_id = recruitment->GetId();
+
+      population->log_init_naa.resize(dims.n_ages);
+      for (size_t a = 0; a < dims.n_ages; a++) {
+        population->log_init_naa[a] =
+            static_cast<Type>(log_rzero - M * a + Normal(0.0, 0.2));
+      }
+      RegisterParameters(population->log_init_naa, "Population", pid,
+                         "log_init_naa");
+
+      std::shared_ptr<fims_popdy::EWAAGrowth<Type>> growth =
+          std::make_shared<fims_popdy::EWAAGrowth<Type>>();
+      double w_inf = Uniform(5.0, 15.0);
+      double k = Uniform(0.2, 0.4);
+      double effect = 0.0;
+      for (size_t y = 0; y <= dims.n_years; y++) {
+        if (dims.time_varying_growth) {
+          effect = Normal(0.0, 0.05);
+        }
+        for (size_t a = 0; a < dims.n_ages; a++) {
+          growth->ewaa[y][population->ages[a]] =
+              w_inf * std::pow(1.0 - std::exp(-k * (a + 0.5)), 3.0) *
+              std::exp(effect);
+        }
+      }
+      if (!dims.time_varying_growth) {
+        growth->time_dependence = fims_model_object::TimeInvariant;
+      }
+      info->growth_models[growth->GetId()] = growth;
+      population->growth_id = growth->GetId();
+
+      std::shared_ptr<fims_popdy::LogisticMaturity<Type>> maturity =
+          std::make_shared<fims_popdy::LogisticMaturity<Type>>();
+      maturity->inflection_point.resize(1);
+      maturity->inflection_point[0] =
+          static_cast<Type>(Uniform(0.2, 0.4) * dims.n_ages);
+      maturity->slope.resize(1);
+      maturity->slope[0] = static_cast<Type>(Uniform(1.0, 2.0));
+      info->maturity_models[maturity->GetId()] = maturity;
+      population->maturity_id = maturity->GetId();
+
+      fims_popdy::CatchAtAge<Type> &caa = *model.catch_at_age;
+      caa.AddPopulation(pid);
+      caa.InitializePopulationDerivedQuantities(pid);
+      std::map<std::string, fims::Vector<Type>> &pdq =
+          caa.GetPopulationDerivedQuantities(pid);
+      std::map<std::string, fims_popdy::DimensionInfo> &pdim =
+          caa.GetPopulationDimensionInfo(pid);
+      for (const char *name :
+           {"total_landings_weight", "total_landings_numbers"}) {
+        AddDerivedQuantity(pdq, pdim, name, {n_years}, {"n_years"});
+      }
+      for (const char *name : {"mortality_F", "mortality_M", "mortality_Z",
+                               "sum_selectivity"}) {
+        AddDerivedQuantity(pdq, pdim, name, {n_years, n_ages},
+                           {"n_years", "n_ages"});
+      }
+      for (const char *name : {"numbers_at_age", "unfished_numbers_at_age",
+                               "proportion_mature_at_age"}) {
+        AddDerivedQuantity(pdq, pdim, name, {n_years + 1, n_ages},
+                           {"n_years+1", "n_ages"});
+      }
+      for (const char *name :
+           {"biomass", "spawning_biomass", "unfished_biomass",
+            "unfished_spawning_biomass", "expected_recruitment"}) {
+        AddDerivedQuantity(pdq, pdim, name, {n_years + 1}, {"n_years+1"});
+      }
+
+      // The fishing mortality is shared among the fleets so that the total
+      // does not grow with the number of fleets.
+      double F = Uniform(0.1, 0.4) / dims.n_fleets;
+      for (size_t f = 0; f < dims.n_fleets; f++) {
+        std::shared_ptr<fims_popdy::Fleet<Type>> fleet =
+            std::make_shared<fims_popdy::Fleet<Type>>();
+        uint32_t fid = fleet->GetId();
+        fleet->n_years = dims.n_years;
+        fleet->n_ages = dims.n_ages;
+        fleet->n_lengths = dims.n_lengths;
+        fleet->observed_landings_units = "weight";
+        fleet->observed_index_units = "weight";
+        fleet->log_q.resize(1);
+        fleet->log_q[0] = static_cast<Type>(std::log(1.0e-4) + Normal(0, 0.5));
+        fleet->log_Fmort.resize(dims.n_years);
+        double log_F = std::log(F);
+        for (size_t y = 0; y < dims.n_years; y++) {
+          log_F += Normal(0.0, 0.1);
+          fleet->log_Fmort[y] = static_cast<Type>(log_F);
+        }
+        RegisterParameters(fleet->log_q, "Fleet", fid, "log_q");
+        RegisterParameters(fleet->log_Fmort, "Fleet", fid, "log_Fmort");
+        fleet->age_to_length_conversion.resize(dims.n_ages * dims.n_lengths);
+        for (size_t a = 0; a < dims.n_ages; a++) {
+          double mean = (a + 0.5) * dims.n_lengths / dims.n_ages;
+          double sd = 1.0 + 0.1 * mean;
+          double sum = 0.0;
+          for (size_t l = 0; l < dims.n_lengths; l++) {
+            double z = (l + 0.5 - mean) / sd;
+            sum += std::exp(-0.5 * z * z);
+          }
+          for (size_t l = 0; l < dims.n_lengths; l++) {
+            double z = (l + 0.5 - mean) / sd;
+            fleet->age_to_length_conversion[a * dims.n_lengths + l] =
+                static_cast<Type>(std::exp(-0.5 * z * z) / sum);
+          }
+        }
+
+        std::shared_ptr<fims_popdy::LogisticSelectivity<Type>> selectivity =
+            std::make_shared<fims_popdy::LogisticSelectivity<Type>>();
+        double inflection = Uniform(0.1, 0.4) * dims.n_ages + 1.0;
+        double slope = Uniform(0.8, 2.0);
+        size_t n_selectivity = dims.time_varying_selectivity ? dims.n_years : 1;
+        selectivity->inflection_point.resize(n_selectivity);
+        selectivity->slope.resize(n_selectivity);
+        for (size_t y = 0; y < n_selectivity; y++) {
+          double effect = n_selectivity > 1 ? Normal(0.0, 0.3) : 0.0;
+          selectivity->inflection_point[y] =
+              static_cast<Type>(inflection + effect);
+          selectivity->slope[y] = static_cast<Type>(slope);
+        }
+        RegisterParameters(selectivity->inflection_point, "Selectivity",
+                           selectivity->GetId(), "inflection_point");
+        RegisterParameters(selectivity->slope, "Selectivity",
+                           selectivity->GetId(), "slope");
+        info->selectivity_models[selectivity->GetId()] = selectivity;
+        fleet->fleet_selectivity_id_m = selectivity->GetId();
+
+        caa.InitializeFleetDerivedQuantities(fid);
+        std::map<std::string, fims::Vector<Type>> &fdq =
+            caa.GetFleetDerivedQuantities(fid);
+        std::map<std::string, fims_popdy::DimensionInfo> &fdim =
+            caa.GetFleetDimensionInfo(fid);
+        for (const char *name :
+             {"landings_weight", "landings_numbers", "landings_expected",
+              "index_weight", "index_numbers", "index_expected"}) {
+          AddDerivedQuantity(fdq, fdim, name, {n_years}, {"n_years"});
+        }
+        for (const char *name :
+             {"landings_numbers_at_age", "landings_weight_at_age",
+              "index_numbers_at_age", "index_weight_at_age",
+              "agecomp_proportion"}) {
+          AddDerivedQuantity(fdq, fdim, name, {n_years, n_ages},
+                             {"n_years", "n_ages"});
+        }
+        for (const char *name :
+             {"landings_numbers_at_length", "index_numbers_at_length",
+              "lengthcomp_proportion"}) {
+          AddDerivedQuantity(fdq, fdim, name, {n_years, n_lengths},
+                             {"n_years", "n_lengths"});
+        }
+        // The keys of the expected values of the data in the order of the
+        // kinds of data.
+        uint32_t keys[4];
+        keys[0] = AddDerivedQuantity(fdq, fdim, "log_landings_expected",
+                                     {n_years}, {"n_years"});
+        keys[1] = AddDerivedQuantity(fdq, fdim, "log_index_expected",
+                                     {n_years}, {"n_years"});
+        keys[2] = AddDerivedQuantity(fdq, fdim, "agecomp_expected",
+                                     {n_years, n_ages}, {"n_years", "n_ages"});
+        keys[3] =
+            AddDerivedQuantity(fdq, fdim, "lengthcomp_expected",
+                               {n_years, n_lengths}, {"n_years", "n_lengths"});
+
+        size_t n_kinds = dims.n_lengths > 0 ? 4 : 3;
+        for (size_t kind = 0; kind < std::min(dims.n_data, n_kinds); kind++) {
+          size_t n_bins = kind == 2   ? dims.n_ages
+                          : kind == 3 ? dims.n_lengths
+                                      : 0;
+          std::shared_ptr<fims_data_object::DataObject<Type>> data =
+              AddData(kind, fid, n_bins, keys[kind]);
+          int *data_id[] = {&fleet->fleet_observed_landings_data_id_m,
+                            &fleet->fleet_observed_index_data_id_m,
+                            &fleet->fleet_observed_agecomp_data_id_m,
+                            &fleet->fleet_observed_lengthcomp_data_id_m};
+          *data_id[kind] = data->id;
+        }
+
+        info->fleets[fid] = fleet;
+        population->fleet_ids.insert(fid);
+      }
+    }
+  };
+
+  // Evaluates a model with placeholder data and the same parameters and
+  // draws the observations from the expected values, i.e., lognormal
+  // landings and index and multinomial compositions with missing years.
+  std::vector<std::vector<double>> SimulateObservations() const {
+    SyntheticModel<double> truth = this->Build<double>();
+    truth.Evaluate();
+    std::mt19937_64 rng(this->seed ^ 0x9e3779b97f4a7c15ULL);
+    std::normal_distribution<double> normal(0.0, 0.1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const char *expected[] = {"log_landings_expected", "log_index_expected",
+                              "agecomp_proportion", "lengthcomp_proportion"};
+
+    std::vector<std::vector<double>> observations(truth.data.size());
+    for (size_t i = 0; i < truth.data.size(); i++) {
+      const fims::Vector<double> &mean =
+          truth.catch_at_age->GetFleetDerivedQuantities(
+              truth.data_fleet_id[i])[expected[truth.data_kind[i]]];
+      std::vector<double> &obs = observations[i];
+      obs.resize(truth.data[i]->size());
+      if (truth.data_kind[i] < 2) {
+        for (size_t y = 0; y < obs.size(); y++) {
+          obs[y] = std::exp(mean[y] + normal(rng));
+        }
+        continue;
+      }
+      size_t n_bins = truth.data[i]->get_jmax();
+      for (size_t y = 0; y < dims.n_years; y++) {
+        bool missing = uniform(rng) < dims.comp_sparsity;
+        // Draw the multinomial counts as a sequence of binomials.
+        size_t remaining = dims.comp_sample_size;
+        double remaining_p = 1.0;
+        for (size_t b = 0; b < n_bins; b++) {
+          double p = mean[y * n_bins + b];
+          size_t n = 0;
+          if (b + 1 == n_bins) {
+            n = remaining;
+          } else if (remaining > 0 && remaining_p > 0.0) {
+            n = std::binomial_distribution<size_t>(
+                remaining, std::min(1.0, std::max(0.0, p / remaining_p)))(rng);
+          }
+          remaining -= n;
+          remaining_p -= p;
+          obs[y * n_bins + b] = missing ? -999.0 : static_cast<double>(n);
+        }
+      }
+    }
+    return observations;
+  }
+};
+
+}  // namespace
+
+#endif
@@ -0,0 +1,76 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/common/timer.hpp"
+
+namespace
+{
+  // PhaseAccumulator
+  // IO correctness
+  // Test that the calls of a phase are summed locally and added to the
+  // statistics once, when the accumulator goes out of scope
+  TEST(PhaseAccumulator, HandlesCorrectInput)
+  {
+    fims::FIMSTimer::Clear();
+    fims::FIMSTimer::enabled = true;
+    {
+      fims::PhaseAccumulator numbers("CatchAtAge", 1, "double",
+                                     "CalculateNumbers");
+      for (size_t i = 0; i < 5; i++)
+      {
+        fims::PhaseAccumulator::Scope timer(numbers);
+      }
+      EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+    }
+    fims::FIMSTimer::enabled = false;
+
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 1);
+    fims::TimerStatistics &numbers = fims::FIMSTimer::statistics[
+      fims::FIMSTimer::Key("CatchAtAge", 1, "double", "CalculateNumbers")];
+    EXPECT_EQ(numbers.calls, 5);
+    EXPECT_GE(numbers.seconds, 0.0);
+    fims::FIMSTimer::Clear();
+  }
+
+  // Edge handling
+  // Test that an accumulator without calls and an accumulator made while
+  // timers are disabled record nothing, and that nothing is counted without
+  // a tape being recorded
+  TEST(PhaseAccumulator, HandlesEdgeCases)
+  {
+    fims::FIMSTimer::Clear();
+    fims::FIMSTimer::enabled = true;
+    {
+      fims::PhaseAccumulator unused("CatchAtAge", 1, "double",
+                                    "CalculateIndex");
+    }
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    fims::FIMSTimer::enabled = false;
+    {
+      fims::PhaseAccumulator disabled("CatchAtAge", 1, "double",
+                                      "CalculateIndex");
+      fims::FIMSTimer::enabled = true;
+      fims::PhaseAccumulator::Scope timer(disabled);
+    }
+    fims::FIMSTimer::enabled = false;
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    fims::FIMSTimer::count_tape = true;
+    {
+      fims::PhaseAccumulator tape("CatchAtAge", 1, "double",
+                                  "CalculateIndex");
+      fims::PhaseAccumulator::Scope timer(tape);
+    }
+    fims::FIMSTimer::count_tape = false;
+    EXPECT_EQ(fims::FIMSTimer::tape_statistics.size(), 0);
+    fims::FIMSTimer::Clear();
+  }
+}
@@ -0,0 +1,103 @@
+// Instructions ----
+// This file follows the format generated by FIMS:::use_gtest_template().
+// Necessary tests include input and output (IO) correctness [IO
+// correctness], edge-case handling [Edge handling], and built-in errors and
+// warnings [Error handling]. See `?FIMS:::use_gtest_template` for more
+// information. Every test should have a description comment.
+// More assertion macros provided by GoogleTest can be found at
+// https://google.github.io/googletest/reference/assertions.html.
+
+#include "gtest/gtest.h"
+#include "../../inst/include/common/timer.hpp"
+
+namespace
+{
+  // ScopedTimer
+  // IO correctness
+  // Test that enabled timers count calls and sum time by module, id, value
+  // type, and phase
+  TEST(ScopedTimer, HandlesCorrectInput)
+  {
+    fims::FIMSTimer::Clear();
+    fims::FIMSTimer::enabled = true;
+    for (size_t i = 0; i < 3; i++)
+    {
+      fims::ScopedTimer timer("CatchAtAge", 1,
+                              fims::FIMSTimer::TypeName<double>(), "Prepare");
+    }
+    {
+      fims::ScopedTimer timer("CatchAtAge", 1,
+                              fims::FIMSTimer::TypeName<float>(), "Prepare");
+    }
+    {
+      fims::ScopedTimer timer("DensityComponent", 2, "double", "data");
+    }
+    fims::FIMSTimer::enabled = false;
+
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 3);
+    fims::TimerStatistics &prepare = fims::FIMSTimer::statistics[
+      fims::FIMSTimer::Key("CatchAtAge", 1, "double", "Prepare")];
+    EXPECT_EQ(prepare.calls, 3);
+    EXPECT_GE(prepare.seconds, 0.0);
+    EXPECT_EQ(fims::FIMSTimer::statistics[
+      fims::FIMSTimer::Key("CatchAtAge", 1, "ad", "Prepare")].calls, 1);
+    fims::FIMSTimer::Clear();
+  }
+
+  // Edge handling
+  // Test that disabled timers record nothing, that a timer started while
+  // timers are disabled is not recorded after they are enabled, that tape
+  // counts refer to the most recent tape, and that Clear() removes all
+  // statistics
+  TEST(ScopedTimer, HandlesEdgeCases)
+  {
+    fims::FIMSTimer::Clear();
+    fims::FIMSTimer::enabled = false;
+    {
+      fims::ScopedTimer timer("Model", 0, "double", "Evaluate");
+    }
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    {
+      fims::ScopedTimer timer("Model", 0, "double", "Evaluate");
+      fims::FIMSTimer::enabled = true;
+    }
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    {
+      fims::ScopedTimer timer("Model", 0, "double", "Evaluate");
+    }
+    fims::FIMSTimer::enabled = false;
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 1);
+    fims::FIMSTimer::Clear();
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    // Without a tape being recorded nothing is counted
+    fims::FIMSTimer::count_tape = true;
+    {
+      fims::ScopedTimer timer("CatchAtAge", 1, "double", "Report");
+    }
+    fims::FIMSTimer::count_tape = false;
+    EXPECT_EQ(fims::FIMSTimer::tape_statistics.size(), 0);
+    EXPECT_EQ(fims::FIMSTimer::statistics.size(), 0);
+
+    // Tape counts start over for a new tape generation
+    size_t tape_1 = fims::FIMSTimer::StartTape();
+    size_t tape_2 = fims::FIMSTimer::StartTape();
+    EXPECT_EQ(tape_2, tape_1 + 1);
+    EXPECT_EQ(fims::FIMSTimer::tape_generation, tape_2);
+    fims::FIMSTimer::AddTape("CatchAtAge", 1, "ad", "Report", tape_1, 10, 4);
+    fims::FIMSTimer::AddTape("CatchAtAge", 1, "ad", "Report", tape_1, 10, 4);
+    fims::TapeStatistics &report = fims::FIMSTimer::tape_statistics[
+      fims::FIMSTimer::Key("CatchAtAge", 1, "ad", "Report")];
+    EXPECT_EQ(report.calls, 2);
+    EXPECT_EQ(report.operations, 20);
+    EXPECT_EQ(report.variables, 8);
+    fims::FIMSTimer::AddTape("CatchAtAge", 1, "ad", "Report", tape_2, 5, 1);
+    EXPECT_EQ(report.calls, 1);
+    EXPECT_EQ(report.operations, 5);
+    EXPECT_EQ(report.variables, 1);
+    fims::FIMSTimer::Clear();
+    EXPECT_EQ(fims::FIMSTimer::tape_statistics.size(), 0);
+  }
+}